@@ -0,0 +1,126 @@
+/*
+
+Module:  MCCI_Modbus_Serial_Backoff.h
+
+Function:
+    Retry intervals for a device that has gone away.
+
+Copyright notice and License:
+    See LICENSE file accompanying this project.
+
+Author:
+    MCCI Corporation   October 2026
+
+*/
+
+#pragma once
+
+#ifndef _MCCI_Modbus_Serial_Backoff_h_
+# define _MCCI_Modbus_Serial_Backoff_h_
+
+#include <cstdint>
+
+namespace McciCatena {
+
+/// @brief choose the stAwaitDevice retry intervals: exponential backoff,
+///     with jitter.
+///
+/// Each failed attempt to reach the device calls next(), which returns
+/// how long to wait before the next one. The interval starts at the
+/// floor and doubles per attempt, up to the ceiling; each wait is drawn
+/// from the upper half of the interval, so hosts that lost their devices
+/// together (say, to a power cycle) don't keep probing in step. A device
+/// that has just dropped out is tried again soon, and one that stays
+/// away costs less and less bus time. reset() goes back to the floor,
+/// once the device is back. Setting floor == ceiling gives a fixed
+/// interval, still jittered.
+class ModbusSerialBackoff
+    {
+public:
+    /// @brief default floor, in microseconds.
+    static constexpr std::uint32_t kDefaultFloor = 250 * 1000;
+    /// @brief default ceiling, in microseconds.
+    static constexpr std::uint32_t kDefaultCeiling = 16 * 1000 * 1000;
+
+    ModbusSerialBackoff(
+        std::uint32_t floor = kDefaultFloor,
+        std::uint32_t ceiling = kDefaultCeiling
+        )
+        {
+        this->setLimits(floor, ceiling);
+        this->m_interval = this->m_floor;
+        }
+
+    /// @brief set the limits, in microseconds. The interval is clamped
+    ///     to the new range.
+    void setLimits(std::uint32_t floor, std::uint32_t ceiling)
+        {
+        if (floor == 0)
+            floor = 1;
+        if (ceiling < floor)
+            ceiling = floor;
+
+        this->m_floor = floor;
+        this->m_ceiling = ceiling;
+        this->m_interval = clamp(this->m_interval, floor, ceiling);
+        }
+
+    std::uint32_t getFloor() const
+        { return this->m_floor; }
+
+    std::uint32_t getCeiling() const
+        { return this->m_ceiling; }
+
+    /// @brief return the current interval, in microseconds.
+    std::uint32_t getInterval() const
+        { return this->m_interval; }
+
+    /// @brief seed the jitter; hosts on one bus should use different
+    ///     seeds.
+    void seed(std::uint32_t seed)
+        { this->m_random = seed != 0 ? seed : 1; }
+
+    /// @brief start over at the floor.
+    void reset()
+        { this->m_interval = this->m_floor; }
+
+    /// @brief return the wait before the next attempt, in microseconds,
+    ///     and back off for the one after.
+    std::uint32_t next()
+        {
+        std::uint32_t const half = this->m_interval / 2;
+        std::uint32_t const delay = this->m_interval - half + this->getRandom() % (half + 1);
+
+        this->m_interval = this->m_interval > this->m_ceiling / 2
+                         ? this->m_ceiling
+                         : 2 * this->m_interval;
+        return delay;
+        }
+
+private:
+    static constexpr std::uint32_t clamp(std::uint32_t v, std::uint32_t lo, std::uint32_t hi)
+        {
+        return v < lo ? lo : v > hi ? hi : v;
+        }
+
+    /// @brief xorshift32; plenty for spreading retries.
+    std::uint32_t getRandom()
+        {
+        std::uint32_t x = this->m_random;
+
+        x ^= x << 13;
+        x ^= x >> 17;
+        x ^= x << 5;
+        this->m_random = x;
+        return x;
+        }
+
+    std::uint32_t   m_floor = 0;
+    std::uint32_t   m_ceiling = 0;
+    std::uint32_t   m_interval = 0;
+    std::uint32_t   m_random = 1;
+    };
+
+} // namespace McciCatena
+
+#endif // _MCCI_Modbus_Serial_Backoff_h_
@@ -0,0 +1,116 @@
+/*
+
+Module:  MCCI_Modbus_Serial_BufferedClient.h
+
+Function:
+    Ring-buffered ModbusSerialHost::Client.
+
+Copyright notice and License:
+    See LICENSE file accompanying this project.
+
+Author:
+    MCCI Corporation   October 2026
+
+*/
+
+#pragma once
+
+#ifndef _MCCI_Modbus_Serial_BufferedClient_h_
+# define _MCCI_Modbus_Serial_BufferedClient_h_
+
+#include "MCCI_Modbus_Serial_Host.h"
+#include "MCCI_Modbus_Serial_RingBuffer.h"
+
+namespace McciCatena {
+
+/// @brief a host Client with a transmit and a receive ring buffer.
+///
+/// The application writes into the transmit buffer and reads from the
+/// receive buffer; the host engine drains and fills them from poll().
+/// Neither side ever waits for the other.
+///
+/// @tparam a_nTx is the transmit buffer size in bytes.
+/// @tparam a_nRx is the receive buffer size in bytes.
+template <std::size_t a_nTx = 256, std::size_t a_nRx = 256>
+class ModbusSerialBufferedClient : public ModbusSerialHost::Client
+    {
+public:
+    using TxBuffer = ModbusSerialRingBuffer<a_nTx>;
+    using RxBuffer = ModbusSerialRingBuffer<a_nRx>;
+
+    //---- application side ----
+
+    /// @brief return number of received bytes waiting to be read.
+    std::size_t getRxAvailable() const
+        { return this->m_rx.available(); }
+
+    /// @brief return number of bytes that can be queued for transmit.
+    std::size_t getTxSpace() const
+        { return this->m_tx.space(); }
+
+    /// @brief true if nothing is waiting to go to the device.
+    bool isTxEmpty() const
+        { return this->m_tx.isEmpty(); }
+
+    /// @brief queue up to n bytes for transmission; return number queued.
+    ///     If fFlush is set, everything queued so far goes out without
+    ///     waiting for the host's coalescing.
+    std::size_t putTx(const std::uint8_t *pBuf, std::size_t n, bool fFlush = false)
+        {
+        auto const nPut = this->m_tx.put(pBuf, n);
+
+        if (fFlush)
+            this->flushTx();
+        return nPut;
+        }
+
+    /// @brief send everything queued so far without waiting for the
+    ///     host's coalescing. Doesn't wait for it to go.
+    void flushTx()
+        { this->m_nTxFlush = this->m_tx.available(); }
+
+    /// @brief remove up to n received bytes; return number removed.
+    std::size_t getRx(std::uint8_t *pBuf, std::size_t n)
+        { return this->m_rx.get(pBuf, n); }
+
+    /// @brief discard everything in both directions.
+    void clear()
+        {
+        this->m_tx.clear();
+        this->m_rx.clear();
+        this->m_nTxFlush = 0;
+        }
+
+    //---- host engine side ----
+
+    virtual std::size_t getTxPending() override
+        { return this->m_tx.available(); }
+
+    virtual std::size_t peekTx(std::uint8_t *pBuf, std::size_t nBuf) override
+        { return this->m_tx.peek(pBuf, nBuf); }
+
+    virtual void consumeTx(std::size_t n) override
+        {
+        this->m_tx.discard(n);
+        this->m_nTxFlush = n < this->m_nTxFlush ? this->m_nTxFlush - n : 0;
+        }
+
+    virtual std::size_t getRxSpace() override
+        { return this->m_rx.space(); }
+
+    virtual void putRx(const std::uint8_t *pBuf, std::size_t n) override
+        { this->m_rx.put(pBuf, n); }
+
+    virtual bool isTxFlushRequested() override
+        { return this->m_nTxFlush != 0; }
+
+protected:
+    TxBuffer    m_tx;
+    RxBuffer    m_rx;
+    /// @brief number of queued bytes covered by a flush request.
+    std::size_t m_nTxFlush = 0;
+    };
+
+} // namespace McciCatena
+
+#endif // _MCCI_Modbus_Serial_BufferedClient_h_
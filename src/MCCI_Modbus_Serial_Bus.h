@@ -0,0 +1,151 @@
+/*
+
+Module:  MCCI_Modbus_Serial_Bus.h
+
+Function:
+    Runs several ModbusSerialHost FSMs over one shared transport.
+
+Copyright notice and License:
+    See LICENSE file accompanying this project.
+
+Author:
+    MCCI Corporation   October 2026
+
+*/
+
+#pragma once
+
+#ifndef _MCCI_Modbus_Serial_Bus_h_
+# define _MCCI_Modbus_Serial_Bus_h_
+
+#include "MCCI_Modbus_Serial_Host.h"
+
+namespace McciCatena {
+
+/// @brief bus scheduler for many devices on one half-duplex bus.
+///
+/// The bus owns the transport; each device has its own ModbusSerialHost
+/// (constructed on the same transport), which is added with addHost().
+/// Call the bus's poll() from the main loop instead of the hosts'.
+///
+/// Whenever the transport can take a transaction, the bus hands it to a
+/// host whose FSM wants the bus, using deficit round-robin. Every host
+/// gets at least one transaction per visit, for polls and discovery, so
+/// a quiet device is heard within one round however busy the others
+/// are. Once a host has backlog (input known to be waiting in the
+/// device, or output the device has room for), it earns a byte budget
+/// of quantum x weight for the visit, doubled if its backlog is close
+/// to filling the device's queue. It keeps the bus while it has both
+/// backlog and budget, and is charged the request and response frame
+/// bytes of each transaction, so budgets measure bus time. Turns
+/// alternate between the round-robin and the hosts without backlog,
+/// whose transactions are short polls, so a due poll waits behind at
+/// most one long transaction.
+///
+/// A host with transmit deadlines (see ModbusSerialHost::setTxLatencyBound)
+/// goes ahead of all this when its nearest deadline is less than one
+/// long transaction away; among several such hosts, the nearest deadline
+/// goes first. While any host has a bound, every host's transactions are
+/// kept to half the tightest one, so the bus is never tied up for longer
+/// than a deadline can wait.
+///
+/// If no host wants the bus and eager polling is on, the operating host
+/// whose poll timer is closest to expiring polls early, so the bus
+/// doesn't sit idle waiting for timers while any device could have data.
+/// That overrides the hosts' adaptive poll intervals, so it's off by
+/// default.
+class ModbusSerialBus
+    {
+public:
+    using Host = ModbusSerialHost;
+    using Transport = ModbusSerialTransport;
+    using Transaction = ModbusSerialTransaction;
+
+    /// @brief maximum number of hosts on one bus.
+    static constexpr std::size_t knMaxHosts = 32;
+
+    /// @brief default per-visit budget: the frame bytes of one read of
+    ///     Status plus a full RxData window.
+    static constexpr std::uint32_t kDefaultQuantum = 8 + 5 + 2 * (1 + ModbusSerialProtocol::knRxDataReg);
+
+    ModbusSerialBus(Transport &transport)
+        : m_transport(transport)
+        {}
+
+    ModbusSerialBus(const ModbusSerialBus &) = delete;
+    ModbusSerialBus &operator=(const ModbusSerialBus &) = delete;
+
+    /// @brief add a host; it must use this bus's transport.
+    bool addHost(Host &host);
+
+    /// @brief remove a host. Fails if it has a transaction outstanding;
+    ///     end() it and keep polling until it stops.
+    bool removeHost(Host &host);
+
+    std::size_t getHostCount() const
+        { return this->m_nHosts; }
+
+    /// @brief set the per-visit budget, in RTU frame bytes, for a host
+    ///     of weight 1.
+    void setQuantum(std::uint32_t nBytes)
+        { this->m_quantum = nBytes != 0 ? nBytes : 1; }
+
+    /// @brief give a host a larger (or smaller) share of the bus when
+    ///     backlogged. The default weight is 1; zero is treated as 1.
+    bool setWeight(const Host &host, std::uint8_t weight);
+
+    /// @brief enable or disable early polling when the bus would be idle.
+    ///     The default is off.
+    void setEagerPolling(bool fEager)
+        { this->m_fEagerPolling = fEager; }
+
+    /// @brief advance all the FSMs. Never blocks.
+    void poll();
+
+    /// @brief return how many microseconds poll() can wait before a
+    ///     host's own timers need it; see ModbusSerialHost::getWakeDelay().
+    ///     UINT32_MAX while the transport is busy, since the hosts can't
+    ///     use the bus until it's done: wait on the transport instead.
+    std::uint32_t getWakeDelay(std::uint32_t now) const;
+
+    Transport &getTransport() const
+        { return this->m_transport; }
+
+private:
+    /// @brief per-host scheduling state.
+    struct Slot
+        {
+        Host            *pHost = nullptr;
+        /// @brief remaining byte budget for this visit; may go negative.
+        std::int32_t    deficit = 0;
+        std::uint8_t    weight = 1;
+        /// @brief true once the budget for this visit has been granted.
+        bool            fGranted = false;
+        };
+
+    Host *pickHost(std::uint32_t now, Transaction *&pTxn);
+    Host *pickUrgentHost(std::uint32_t now, Transaction *&pTxn);
+    Host *pickQuietHost(std::uint32_t now, Transaction *&pTxn);
+    Host *pickEarlyPoll(std::uint32_t now, Transaction *&pTxn);
+    void grantBudget(Slot &slot, std::uint32_t backlog);
+    void nextVisit();
+    std::size_t findSlot(const Host &host) const;
+
+    Transport       &m_transport;
+    Slot            m_slots[knMaxHosts];
+    std::size_t     m_nHosts = 0;
+    /// @brief the host whose turn it is.
+    std::size_t     m_iCurrent = 0;
+    /// @brief where the search for quiet hosts starts.
+    std::size_t     m_iQuiet = 0;
+    std::uint32_t   m_quantum = kDefaultQuantum;
+    /// @brief true until the current host's visit has been set up.
+    bool            m_fNewVisit = true;
+    /// @brief true if hosts without backlog have the current turn.
+    bool            m_fQuietTurn = false;
+    bool            m_fEagerPolling = false;
+    };
+
+} // namespace McciCatena
+
+#endif // _MCCI_Modbus_Serial_Bus_h_
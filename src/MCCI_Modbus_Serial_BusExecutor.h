@@ -0,0 +1,197 @@
+/*
+
+Module:  MCCI_Modbus_Serial_BusExecutor.h
+
+Function:
+    Work-stealing executor for many Linux serial buses on a few threads.
+
+Copyright notice and License:
+    See LICENSE file accompanying this project.
+
+Author:
+    MCCI Corporation   October 2026
+
+*/
+
+#pragma once
+
+#ifndef _MCCI_Modbus_Serial_BusExecutor_h_
+# define _MCCI_Modbus_Serial_BusExecutor_h_
+
+#include "MCCI_Modbus_Serial_Bus.h"
+#include "MCCI_Modbus_Serial_TermiosTransport.h"
+#include "MCCI_Modbus_Serial_ThreadControl.h"
+#include "MCCI_Modbus_Serial_ThreadedClient.h"
+#include "MCCI_Modbus_Serial_WorkDeque.h"
+
+#if defined(__linux__) && ! defined(ARDUINO)
+
+#include <atomic>
+#include <memory>
+#include <thread>
+
+namespace McciCatena {
+
+/// @brief run many serial buses on a small pool of worker threads.
+///
+/// Each bus is a task, which runs (that is, polls the bus) when its port
+/// has input or room for a stuck request, when its own timer runs out,
+/// or when a client has new output. The timer is set from the port's
+/// frame timing and the hosts' own timers (see
+/// ModbusSerialBus::getWakeDelay()), so an idle bus costs nothing, and
+/// CPU use follows traffic rather than the number of buses.
+///
+/// Ready tasks go on the deque of the worker that saw the event. A
+/// worker runs its own newest task first; one with nothing to do steals
+/// the oldest from another, and a worker that queues more than it can
+/// run at once wakes a sleeping one to steal. A task is never queued
+/// twice, and never runs on two workers at once: an event that arrives
+/// while it's running makes it run again afterwards, on the same worker.
+/// So each bus's transactions stay in order, whichever thread runs it.
+///
+/// Set up the ports and buses, add() each with its hosts and their
+/// ModbusSerialThreadedClient, then begin(). Each bus uses two file
+/// descriptors (its port and a timerfd), so hundreds of buses may need
+/// a higher RLIMIT_NOFILE. Ports must be plain
+/// ModbusSerialTermiosTransport, not ModbusSerialUringTransport.
+///
+/// Clients wake their bus when output arrives in an empty buffer or is
+/// flushed. With transmit coalescing, output that reaches the threshold
+/// in between is seen at the coalescing deadline or the next poll.
+class ModbusSerialBusExecutor
+    {
+public:
+    using Bus = ModbusSerialBus;
+    using Host = ModbusSerialHost;
+    using Port = ModbusSerialTermiosTransport;
+    using Client = ModbusSerialThreadedClientBase;
+
+    static constexpr std::size_t knMaxBuses = 512;
+    static constexpr std::size_t knMaxBindings = 4 * knMaxBuses;
+    static constexpr std::size_t knMaxWorkers = 64;
+
+    ModbusSerialBusExecutor() = default;
+    ModbusSerialBusExecutor(const ModbusSerialBusExecutor &) = delete;
+    ModbusSerialBusExecutor &operator=(const ModbusSerialBusExecutor &) = delete;
+
+    ~ModbusSerialBusExecutor()
+        { this->end(); }
+
+    /// @brief add an open port and the bus that uses it. Only before
+    ///     begin().
+    bool add(Port &port, Bus &bus);
+
+    /// @brief add a host to a bus already added, and start it with
+    ///     client. Only before begin().
+    bool add(Bus &bus, Host &host, Client &client, std::uint32_t baudrate = 0);
+
+    /// @brief start nWorkers threads. If firstCpu isn't negative, worker
+    ///     i is pinned to CPU firstCpu + i.
+    bool begin(std::size_t nWorkers, int firstCpu = -1);
+
+    /// @brief stop the threads and wait for them. The buses and hosts
+    ///     are left as they were.
+    void end();
+
+    bool isRunning() const
+        { return this->m_nWorkers != 0; }
+
+    std::size_t getWorkerCount() const
+        { return this->m_nWorkers; }
+
+    /// @brief return how many times buses have been run, by all workers.
+    std::uint64_t getRunCount() const;
+
+    /// @brief return how many tasks have been stolen from other workers.
+    std::uint64_t getStealCount() const;
+
+private:
+    struct Binding;
+    struct Worker;
+
+    /// @brief a bus and what wakes it.
+    struct Task : public Client::Waker
+        {
+        enum State : std::uint8_t
+            {
+            Idle,           ///< waiting for an event.
+            Queued,         ///< on a deque or the injection stack.
+            Running,        ///< being polled.
+            Rerun,          ///< being polled; run again afterwards.
+            };
+
+        /// @brief a client has new output.
+        virtual void wake() override;
+
+        ModbusSerialBusExecutor *pOwner = nullptr;
+        Port            *pPort = nullptr;
+        Bus             *pBus = nullptr;
+        Binding         *pBindings = nullptr;
+        /// @brief next on the injection stack.
+        Task            *pNextInjected = nullptr;
+        std::atomic<std::uint8_t> state { Idle };
+        /// @brief the epoll events asked for on the port.
+        std::uint32_t   events = 0;
+        /// @brief when the timer is set to go off, if fTimerArmed.
+        std::uint32_t   tTimer = 0;
+        int             timerFd = -1;
+        bool            fTimerArmed = false;
+        };
+
+    /// @brief a host on a task's bus, and its client.
+    struct Binding
+        {
+        Host            *pHost = nullptr;
+        Client          *pClient = nullptr;
+        Binding         *pNext = nullptr;
+        };
+
+    using Deque = ModbusSerialWorkDeque<Task, knMaxBuses>;
+
+    struct Worker
+        {
+        Deque           deque;
+        std::thread     thread;
+        std::atomic<std::uint64_t> nRuns { 0 };
+        std::atomic<std::uint64_t> nSteals { 0 };
+        /// @brief where the next search for a victim starts.
+        std::size_t     iVictim = 0;
+        };
+
+    Task *findTask(const Bus &bus);
+    bool setup();
+    void teardown();
+    void run(std::size_t iWorker);
+    Task *findWork(std::size_t iWorker);
+    Task *steal(std::size_t iWorker);
+    Task *popInjected(Worker &self);
+    void wait(Worker &self);
+    void execute(Task &task, Worker &self);
+    void notify(Task &task, Worker *pSelf);
+    void inject(Task &task);
+    bool updateEvents(Task &task);
+    bool updateTimer(Task &task, std::uint32_t delay, std::uint32_t now);
+    void publish(const Task &task);
+    void wakeSleeper();
+
+    Task            m_tasks[knMaxBuses];
+    Binding         m_bindings[knMaxBindings];
+    std::size_t     m_nTasks = 0;
+    std::size_t     m_nBindings = 0;
+    std::unique_ptr<Worker[]> m_pWorkers;
+    std::size_t     m_nWorkers = 0;
+    /// @brief tasks made ready by application threads.
+    std::atomic<Task *> m_pInjected { nullptr };
+    /// @brief workers in, or about to be in, epoll_wait().
+    std::atomic<std::size_t> m_nSleeping { 0 };
+    ModbusSerialThreadControl m_control;
+    int             m_epollFd = -1;
+    /// @brief wakes one sleeping worker to look for work.
+    int             m_wakeFd = -1;
+    };
+
+} // namespace McciCatena
+
+#endif // defined(__linux__) && ! defined(ARDUINO)
+
+#endif // _MCCI_Modbus_Serial_BusExecutor_h_
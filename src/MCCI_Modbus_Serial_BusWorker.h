@@ -0,0 +1,109 @@
+/*
+
+Module:  MCCI_Modbus_Serial_BusWorker.h
+
+Function:
+    A thread per serial bus, for multi-bus Linux gateways.
+
+Copyright notice and License:
+    See LICENSE file accompanying this project.
+
+Author:
+    MCCI Corporation   October 2026
+
+*/
+
+#pragma once
+
+#ifndef _MCCI_Modbus_Serial_BusWorker_h_
+# define _MCCI_Modbus_Serial_BusWorker_h_
+
+#include "MCCI_Modbus_Serial_EventLoop.h"
+#include "MCCI_Modbus_Serial_ThreadControl.h"
+#include "MCCI_Modbus_Serial_ThreadedClient.h"
+
+#if defined(__linux__) && ! defined(ARDUINO)
+
+#include <thread>
+
+namespace McciCatena {
+
+/// @brief run one serial bus, and the hosts on it, on a thread of its
+///     own, optionally pinned to a CPU.
+///
+/// Set up the port and bus, add() each host with its
+/// ModbusSerialThreadedClient, then begin(). From then on only the
+/// worker touches the port, bus and hosts; application threads use the
+/// clients, which hand data across in lock-free rings. The worker sleeps
+/// in a ModbusSerialEventLoop; a client wakes it through an eventfd when
+/// new output arrives, and the worker signals the client's eventfd when
+/// input arrives.
+class ModbusSerialBusWorker : public ModbusSerialThreadedClientBase::Waker
+    {
+public:
+    using Bus = ModbusSerialBus;
+    using Host = ModbusSerialHost;
+    using Port = ModbusSerialTermiosTransport;
+    using Client = ModbusSerialThreadedClientBase;
+
+    static constexpr std::size_t knMaxHosts = Bus::knMaxHosts;
+
+    /// @brief port must be open, and bus must use it.
+    ModbusSerialBusWorker(Port &port, Bus &bus)
+        : m_port(port)
+        , m_bus(bus)
+        {}
+
+    ModbusSerialBusWorker(const ModbusSerialBusWorker &) = delete;
+    ModbusSerialBusWorker &operator=(const ModbusSerialBusWorker &) = delete;
+
+    ~ModbusSerialBusWorker()
+        { this->end(); }
+
+    /// @brief add a host to the bus, and start it with client. Only
+    ///     before begin().
+    bool add(Host &host, Client &client, std::uint32_t baudrate = 0);
+
+    /// @brief start the thread; if cpu isn't negative, pin it there.
+    bool begin(int cpu = -1);
+
+    /// @brief stop the thread and wait for it. The hosts are left as
+    ///     they were.
+    void end();
+
+    bool isRunning() const
+        { return this->m_thread.joinable(); }
+
+    /// @brief wake the thread to look at the clients. May be called from
+    ///     any thread.
+    virtual void wake() override
+        { this->m_loop.wake(); }
+
+    /// @brief set the longest the thread sleeps between polls.
+    void setTick(std::uint32_t us)
+        { this->m_loop.setTick(us); }
+
+private:
+    struct Binding
+        {
+        Host            *pHost = nullptr;
+        Client          *pClient = nullptr;
+        };
+
+    void run();
+    void publish();
+
+    Port            &m_port;
+    Bus             &m_bus;
+    ModbusSerialEventLoop m_loop;
+    Binding         m_bindings[knMaxHosts];
+    std::size_t     m_nBindings = 0;
+    std::thread     m_thread;
+    ModbusSerialThreadControl m_control;
+    };
+
+} // namespace McciCatena
+
+#endif // defined(__linux__) && ! defined(ARDUINO)
+
+#endif // _MCCI_Modbus_Serial_BusWorker_h_
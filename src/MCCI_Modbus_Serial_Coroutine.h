@@ -0,0 +1,661 @@
+/*
+
+Module:  MCCI_Modbus_Serial_Coroutine.h
+
+Function:
+    C++20 coroutine interface to remote Serial-over-Modbus UARTs.
+
+Copyright notice and License:
+    See LICENSE file accompanying this project.
+
+Author:
+    MCCI Corporation   October 2026
+
+*/
+
+#pragma once
+
+#ifndef _MCCI_Modbus_Serial_Coroutine_h_
+# define _MCCI_Modbus_Serial_Coroutine_h_
+
+#include "MCCI_Modbus_Serial_BufferedClient.h"
+
+#if defined(__cpp_impl_coroutine)
+
+#include <coroutine>
+#include <exception>
+
+#if defined(__has_include)
+# if __has_include(<span>)
+#  include <span>
+# endif
+#endif
+
+namespace McciCatena {
+
+/// @brief fixed-size blocks for coroutine frames.
+///
+/// Coroutine frames are allocated by the compiler; ModbusSerialCoTask
+/// takes them from the default pool instead of the heap, so nothing is
+/// allocated after startup. Each block starts with a header naming its
+/// pool, and a frame always goes back to the pool it came from, whatever
+/// the default is by then. A frame bigger than a block, or one asked
+/// for when the pool is empty, fails; the task is then invalid and
+/// ModbusSerialCoExecutor::spawn() refuses it. Frame sizes depend on the
+/// compiler and optimization level; getMaxRequested() shows what the
+/// application needs.
+///
+/// The pool isn't thread-safe; like the executor, it belongs to one
+/// thread.
+class ModbusSerialCoFramePool
+    {
+public:
+    ModbusSerialCoFramePool(const ModbusSerialCoFramePool &) = delete;
+    ModbusSerialCoFramePool &operator=(const ModbusSerialCoFramePool &) = delete;
+
+    /// @brief room at the start of each block for the owning pool.
+    static constexpr std::size_t knHeaderBytes = alignof(std::max_align_t);
+
+    /// @brief return a frame of n bytes from the default pool, or
+    ///     nullptr.
+    static void *allocateFrame(std::size_t n) noexcept
+        {
+        auto const pPool = getDefault();
+
+        if (pPool == nullptr)
+            return nullptr;
+
+        if (n > pPool->m_maxRequested)
+            pPool->m_maxRequested = n;
+
+        auto const pBlock = static_cast<std::uint8_t *>(pPool->allocate(knHeaderBytes + n));
+
+        if (pBlock == nullptr)
+            return nullptr;
+
+        *reinterpret_cast<ModbusSerialCoFramePool **>(pBlock) = pPool;
+        return pBlock + knHeaderBytes;
+        }
+
+    /// @brief return a frame from allocateFrame() to its own pool.
+    static void freeFrame(void *p) noexcept
+        {
+        auto const pBlock = static_cast<std::uint8_t *>(p) - knHeaderBytes;
+
+        (*reinterpret_cast<ModbusSerialCoFramePool **>(pBlock))->free(pBlock);
+        }
+
+    /// @brief return a block of at least n bytes, or nullptr.
+    void *allocate(std::size_t n) noexcept
+        {
+        if (n > this->m_nBlockBytes || this->m_pFree == nullptr)
+            {
+            ++this->m_nFailed;
+            return nullptr;
+            }
+
+        FreeBlock * const pBlock = this->m_pFree;
+        this->m_pFree = pBlock->pNext;
+        --this->m_nFree;
+        return pBlock;
+        }
+
+    /// @brief return a block to the pool.
+    void free(void *p) noexcept
+        {
+        FreeBlock * const pBlock = static_cast<FreeBlock *>(p);
+
+        pBlock->pNext = this->m_pFree;
+        this->m_pFree = pBlock;
+        ++this->m_nFree;
+        }
+
+    std::size_t getBlockBytes() const
+        { return this->m_nBlockBytes; }
+
+    std::size_t getFreeCount() const
+        { return this->m_nFree; }
+
+    /// @brief return the largest frame ever asked for, not counting
+    ///     the block header.
+    std::size_t getMaxRequested() const
+        { return this->m_maxRequested; }
+
+    /// @brief return the number of frames that couldn't be allocated.
+    std::uint32_t getFailedCount() const
+        { return this->m_nFailed; }
+
+    /// @brief return the pool that coroutine frames come from.
+    static ModbusSerialCoFramePool *getDefault()
+        { return s_pDefault; }
+
+    /// @brief make this pool the source of new coroutine frames. Frames
+    ///     already out still go back to their own pools.
+    void setDefault()
+        { s_pDefault = this; }
+
+protected:
+    ModbusSerialCoFramePool() = default;
+
+    /// @brief carve the storage into nBlocks blocks of nBlockBytes.
+    void init(void *pStorage, std::size_t nBlockBytes, std::size_t nBlocks)
+        {
+        std::uint8_t * const pBase = static_cast<std::uint8_t *>(pStorage);
+
+        this->m_nBlockBytes = nBlockBytes;
+        this->m_pFree = nullptr;
+        this->m_nFree = 0;
+        for (std::size_t i = nBlocks; i != 0; --i)
+            this->free(pBase + (i - 1) * nBlockBytes);
+        }
+
+private:
+    struct FreeBlock
+        {
+        FreeBlock   *pNext;
+        };
+
+    inline static ModbusSerialCoFramePool *s_pDefault = nullptr;
+
+    FreeBlock       *m_pFree = nullptr;
+    std::size_t     m_nBlockBytes = 0;
+    std::size_t     m_nFree = 0;
+    std::size_t     m_maxRequested = 0;
+    std::uint32_t   m_nFailed = 0;
+    };
+
+/// @brief a frame pool with its own storage.
+///
+/// @tparam a_nFrames is the number of frames: one per coroutine that
+///     may be running at once, counting nested ones.
+/// @tparam a_nFrameBytes is the size of each frame, not counting the
+///     block header.
+template <std::size_t a_nFrames, std::size_t a_nFrameBytes = 256>
+class ModbusSerialCoFrames : public ModbusSerialCoFramePool
+    {
+public:
+    static constexpr std::size_t knAlign = alignof(std::max_align_t);
+    static constexpr std::size_t knBlockBytes = knHeaderBytes + (a_nFrameBytes + knAlign - 1) / knAlign * knAlign;
+
+    ModbusSerialCoFrames()
+        { this->init(this->m_storage, knBlockBytes, a_nFrames); }
+
+private:
+    alignas(std::max_align_t) std::uint8_t m_storage[a_nFrames * knBlockBytes];
+    };
+
+/// @brief a coroutine that returns nothing.
+///
+/// A task doesn't start when it's called. Either hand it to a
+/// ModbusSerialCoExecutor with spawn(), or co_await it from another
+/// task, which then resumes when it finishes. Its frame comes from
+/// ModbusSerialCoFramePool::getDefault().
+class ModbusSerialCoTask
+    {
+public:
+    struct promise_type
+        {
+        /// @brief who to resume when we finish; null if spawned.
+        std::coroutine_handle<> continuation;
+
+        static void *operator new(std::size_t n) noexcept
+            { return ModbusSerialCoFramePool::allocateFrame(n); }
+
+        static void operator delete(void *p) noexcept
+            { ModbusSerialCoFramePool::freeFrame(p); }
+
+        static ModbusSerialCoTask get_return_object_on_allocation_failure() noexcept
+            { return ModbusSerialCoTask(); }
+
+        ModbusSerialCoTask get_return_object() noexcept
+            { return ModbusSerialCoTask(Handle::from_promise(*this)); }
+
+        std::suspend_always initial_suspend() noexcept
+            { return {}; }
+
+        struct FinalAwaiter
+            {
+            bool await_ready() noexcept
+                { return false; }
+
+            std::coroutine_handle<> await_suspend(std::coroutine_handle<promise_type> h) noexcept
+                {
+                auto const next = h.promise().continuation;
+
+                return next ? next : std::noop_coroutine();
+                }
+
+            void await_resume() noexcept
+                {}
+            };
+
+        FinalAwaiter final_suspend() noexcept
+            { return {}; }
+
+        void return_void() noexcept
+            {}
+
+        void unhandled_exception() noexcept
+            { std::terminate(); }
+        };
+
+    using Handle = std::coroutine_handle<promise_type>;
+
+    ModbusSerialCoTask() = default;
+
+    ModbusSerialCoTask(ModbusSerialCoTask &&other) noexcept
+        : m_h(other.m_h)
+        { other.m_h = nullptr; }
+
+    ModbusSerialCoTask &operator=(ModbusSerialCoTask &&other) noexcept
+        {
+        if (this != &other)
+            {
+            this->destroy();
+            this->m_h = other.m_h;
+            other.m_h = nullptr;
+            }
+        return *this;
+        }
+
+    ModbusSerialCoTask(const ModbusSerialCoTask &) = delete;
+    ModbusSerialCoTask &operator=(const ModbusSerialCoTask &) = delete;
+
+    ~ModbusSerialCoTask()
+        { this->destroy(); }
+
+    /// @brief false if the frame couldn't be allocated.
+    bool isValid() const
+        { return bool(this->m_h); }
+
+    /// @brief give up ownership of the frame.
+    Handle release()
+        {
+        Handle const h = this->m_h;
+
+        this->m_h = nullptr;
+        return h;
+        }
+
+    // co_await runs the task to completion, then resumes the caller. An
+    // invalid task completes at once.
+    bool await_ready() const noexcept
+        { return ! this->m_h || this->m_h.done(); }
+
+    std::coroutine_handle<> await_suspend(std::coroutine_handle<> caller) noexcept
+        {
+        this->m_h.promise().continuation = caller;
+        return this->m_h;
+        }
+
+    void await_resume() const noexcept
+        {}
+
+private:
+    explicit ModbusSerialCoTask(Handle h)
+        : m_h(h)
+        {}
+
+    void destroy()
+        {
+        if (this->m_h)
+            {
+            this->m_h.destroy();
+            this->m_h = nullptr;
+            }
+        }
+
+    Handle  m_h;
+    };
+
+/// @brief something the executor polls to resume waiting coroutines.
+class ModbusSerialCoWaitable
+    {
+public:
+    virtual ~ModbusSerialCoWaitable() = default;
+
+    /// @brief resume any coroutines whose wait is over.
+    virtual void dispatch() = 0;
+
+private:
+    template <std::size_t a_nTasks>
+    friend class ModbusSerialCoExecutor;
+
+    ModbusSerialCoWaitable  *m_pNextWaitable = nullptr;
+    };
+
+/// @brief a single-threaded executor for ModbusSerialCoTask.
+///
+/// Call poll() from the same loop that polls the host or bus; it starts
+/// spawned tasks, resumes coroutines whose reads and writes have
+/// completed, and frees the frames of tasks that have finished.
+/// Coroutines only ever run inside poll(), never inside the host's
+/// poll(), so they can't re-enter the engine.
+///
+/// @tparam a_nTasks is the number of top-level tasks that can be spawned
+///     at once.
+template <std::size_t a_nTasks = 8>
+class ModbusSerialCoExecutor
+    {
+public:
+    using Task = ModbusSerialCoTask;
+
+    /// @brief construct; coroutine frames will come from pool.
+    ModbusSerialCoExecutor(ModbusSerialCoFramePool &pool)
+        { pool.setDefault(); }
+
+    ModbusSerialCoExecutor(const ModbusSerialCoExecutor &) = delete;
+    ModbusSerialCoExecutor &operator=(const ModbusSerialCoExecutor &) = delete;
+
+    /// @brief destroy any unfinished tasks. Cancel their reads and
+    ///     writes first, or the ports are left pointing into freed frames.
+    ~ModbusSerialCoExecutor()
+        {
+        for (auto &slot : this->m_slots)
+            {
+            if (slot.h)
+                slot.h.destroy();
+            }
+        }
+
+    /// @brief start a task on the next poll(). Fails if the task is
+    ///     invalid or the task table is full; the task is then dropped.
+    bool spawn(Task &&task)
+        {
+        if (! task.isValid())
+            return false;
+
+        for (auto &slot : this->m_slots)
+            {
+            if (! slot.h)
+                {
+                slot.h = task.release();
+                slot.fStarted = false;
+                return true;
+                }
+            }
+
+        return false;
+        }
+
+    /// @brief add a port (or other waitable) whose waiters are resumed
+    ///     by poll().
+    void addWaitable(ModbusSerialCoWaitable &waitable)
+        {
+        waitable.m_pNextWaitable = this->m_pWaitables;
+        this->m_pWaitables = &waitable;
+        }
+
+    void removeWaitable(ModbusSerialCoWaitable &waitable)
+        {
+        for (auto pp = &this->m_pWaitables; *pp != nullptr; pp = &(*pp)->m_pNextWaitable)
+            {
+            if (*pp == &waitable)
+                {
+                *pp = waitable.m_pNextWaitable;
+                waitable.m_pNextWaitable = nullptr;
+                return;
+                }
+            }
+        }
+
+    /// @brief run everything that's ready. Never blocks.
+    void poll()
+        {
+        for (auto &slot : this->m_slots)
+            {
+            if (slot.h && ! slot.fStarted)
+                {
+                slot.fStarted = true;
+                slot.h.resume();
+                }
+            }
+
+        for (auto p = this->m_pWaitables; p != nullptr; p = p->m_pNextWaitable)
+            p->dispatch();
+
+        for (auto &slot : this->m_slots)
+            {
+            if (slot.h && slot.h.done())
+                {
+                slot.h.destroy();
+                slot.h = nullptr;
+                }
+            }
+        }
+
+    /// @brief return the number of spawned tasks that haven't finished.
+    std::size_t getTaskCount() const
+        {
+        std::size_t n = 0;
+
+        for (auto &slot : this->m_slots)
+            {
+            if (slot.h)
+                ++n;
+            }
+        return n;
+        }
+
+private:
+    struct Slot
+        {
+        Task::Handle    h;
+        bool            fStarted = false;
+        };
+
+    Slot                    m_slots[a_nTasks];
+    ModbusSerialCoWaitable  *m_pWaitables = nullptr;
+    };
+
+/// @brief a remote virtual UART with awaitable reads and writes.
+///
+/// Pass the port to ModbusSerialHost::begin() as the client, and add it
+/// to the executor with addWaitable(). Then, in a ModbusSerialCoTask:
+///
+///     std::size_t n = co_await port.read(buf, sizeof(buf));
+///     co_await port.write(buf, n);
+///
+/// read() waits until a transaction brings in at least one byte, then
+/// returns as much as fits. write() waits until the device has accepted
+/// every byte; it bypasses coalescing, since someone is waiting. A port
+/// has room for one read and one write in progress at a time; another
+/// one returns 0 at once. cancel() ends both with whatever they've done.
+template <std::size_t a_nTx = 256, std::size_t a_nRx = 256>
+class ModbusSerialCoPort
+    : public ModbusSerialBufferedClient<a_nTx, a_nRx>
+    , public ModbusSerialCoWaitable
+    {
+    using Super = ModbusSerialBufferedClient<a_nTx, a_nRx>;
+
+public:
+    class ReadAwaiter
+        {
+    public:
+        ReadAwaiter(ModbusSerialCoPort &port, std::uint8_t *pBuf, std::size_t nBuf)
+            : m_port(port)
+            , m_pBuf(pBuf)
+            , m_nBuf(nBuf)
+            {}
+
+        bool await_ready()
+            {
+            if (this->m_nBuf == 0 || this->m_port.m_pReader != nullptr)
+                return true;
+            return this->tryRead();
+            }
+
+        void await_suspend(std::coroutine_handle<> h)
+            {
+            this->m_h = h;
+            this->m_port.m_pReader = this;
+            }
+
+        std::size_t await_resume() const
+            { return this->m_nRead; }
+
+    private:
+        friend class ModbusSerialCoPort;
+
+        bool tryRead()
+            {
+            this->m_nRead = this->m_port.getRx(this->m_pBuf, this->m_nBuf);
+            return this->m_nRead != 0;
+            }
+
+        ModbusSerialCoPort      &m_port;
+        std::uint8_t            *m_pBuf;
+        std::size_t             m_nBuf;
+        std::size_t             m_nRead = 0;
+        std::coroutine_handle<> m_h;
+        };
+
+    class WriteAwaiter
+        {
+    public:
+        WriteAwaiter(ModbusSerialCoPort &port, const std::uint8_t *pBuf, std::size_t nBuf)
+            : m_port(port)
+            , m_pBuf(pBuf)
+            , m_nBuf(nBuf)
+            {}
+
+        bool await_ready()
+            {
+            if (this->m_nBuf == 0 || this->m_port.m_pWriter != nullptr)
+                return true;
+
+            // our first byte goes once everything ahead of it has.
+            this->m_tStart = this->m_port.m_nTxRetired + std::uint32_t(this->m_port.getTxPending());
+            return this->tryWrite();
+            }
+
+        void await_suspend(std::coroutine_handle<> h)
+            {
+            this->m_h = h;
+            this->m_port.m_pWriter = this;
+            }
+
+        /// @brief return the number of bytes the device accepted (or
+        ///     clear() discarded).
+        std::size_t await_resume() const
+            { return this->m_nDone; }
+
+    private:
+        friend class ModbusSerialCoPort;
+
+        // queue what fits, and see whether the device has taken it all.
+        bool tryWrite()
+            {
+            auto &port = this->m_port;
+
+            if (this->m_nQueued < this->m_nBuf)
+                {
+                auto const n = port.putTx(this->m_pBuf + this->m_nQueued, this->m_nBuf - this->m_nQueued, true);
+
+                this->m_nQueued += n;
+                }
+
+            this->m_nDone = this->getAccepted();
+            return this->m_nDone == this->m_nBuf;
+            }
+
+        std::size_t getAccepted() const
+            {
+            std::uint32_t const nAccepted = this->m_port.m_nTxRetired - this->m_tStart;
+
+            if (std::int32_t(nAccepted) <= 0)
+                return 0;
+            return nAccepted < this->m_nQueued ? nAccepted : this->m_nQueued;
+            }
+
+        ModbusSerialCoPort      &m_port;
+        const std::uint8_t      *m_pBuf;
+        std::size_t             m_nBuf;
+        std::size_t             m_nQueued = 0;
+        std::size_t             m_nDone = 0;
+        /// @brief the port's m_nTxRetired when our first byte is gone.
+        std::uint32_t           m_tStart = 0;
+        std::coroutine_handle<> m_h;
+        };
+
+    ModbusSerialCoPort() = default;
+    ModbusSerialCoPort(const ModbusSerialCoPort &) = delete;
+    ModbusSerialCoPort &operator=(const ModbusSerialCoPort &) = delete;
+
+    /// @brief wait for input and copy up to nBuf bytes to pBuf.
+    ReadAwaiter read(std::uint8_t *pBuf, std::size_t nBuf)
+        { return ReadAwaiter(*this, pBuf, nBuf); }
+
+    /// @brief send nBuf bytes and wait for the device to accept them.
+    WriteAwaiter write(const std::uint8_t *pBuf, std::size_t nBuf)
+        { return WriteAwaiter(*this, pBuf, nBuf); }
+
+#if defined(__cpp_lib_span)
+    ReadAwaiter read(std::span<std::uint8_t> buf)
+        { return this->read(buf.data(), buf.size()); }
+
+    WriteAwaiter write(std::span<const std::uint8_t> buf)
+        { return this->write(buf.data(), buf.size()); }
+#endif
+
+    /// @brief end any read or write in progress on the next dispatch();
+    ///     use when the device has gone away.
+    void cancel()
+        { this->m_fCancel = true; }
+
+    /// @brief discard everything in both directions, and cancel().
+    void clear()
+        {
+        this->m_nTxRetired += std::uint32_t(this->getTxPending());
+        Super::clear();
+        this->cancel();
+        }
+
+    //---- executor side ----
+
+    virtual void dispatch() override
+        {
+        bool const fCancel = this->m_fCancel;
+
+        this->m_fCancel = false;
+
+        // clear the waiter before resuming, so the coroutine can start
+        // another read or write right away.
+        if (this->m_pReader != nullptr && (this->m_pReader->tryRead() || fCancel))
+            {
+            auto const h = this->m_pReader->m_h;
+
+            this->m_pReader = nullptr;
+            h.resume();
+            }
+
+        if (this->m_pWriter != nullptr && (this->m_pWriter->tryWrite() || fCancel))
+            {
+            auto const h = this->m_pWriter->m_h;
+
+            this->m_pWriter = nullptr;
+            h.resume();
+            }
+        }
+
+    //---- host engine side ----
+
+    virtual void consumeTx(std::size_t n) override
+        {
+        Super::consumeTx(n);
+        this->m_nTxRetired += std::uint32_t(n);
+        }
+
+private:
+    ReadAwaiter     *m_pReader = nullptr;
+    WriteAwaiter    *m_pWriter = nullptr;
+    /// @brief running count of bytes that have left the transmit buffer.
+    std::uint32_t   m_nTxRetired = 0;
+    bool            m_fCancel = false;
+    };
+
+} // namespace McciCatena
+
+#endif // defined(__cpp_impl_coroutine)
+
+#endif // _MCCI_Modbus_Serial_Coroutine_h_
@@ -0,0 +1,130 @@
+/*
+
+Module:  MCCI_Modbus_Serial_Device.h
+
+Function:
+    Device-side implementation of the Serial-over-Modbus register map.
+
+Copyright notice and License:
+    See LICENSE file accompanying this project.
+
+Author:
+    MCCI Corporation   October 2026
+
+*/
+
+#pragma once
+
+#ifndef _MCCI_Modbus_Serial_Device_h_
+# define _MCCI_Modbus_Serial_Device_h_
+
+#include "MCCI_Modbus_Serial_Protocol.h"
+#include "MCCI_Modbus_Serial_RingBuffer.h"
+
+namespace McciCatena {
+
+/// @brief the device side of the protocol.
+///
+/// This class implements the register semantics described in the README
+/// on top of two byte queues: the receive queue holds characters from the
+/// UART that are waiting for the host, and the transmit queue holds
+/// characters written by the host that are waiting for the UART. The
+/// Modbus slave calls readRegisters() and writeRegisters(); the firmware
+/// moves bytes between the queues and the real UART.
+///
+/// The same class serves as the simulated device for host-side testing.
+class ModbusSerialDevice
+    {
+public:
+    using Register = ModbusSerialProtocol::Register;
+    using StatusBits = ModbusSerialProtocol::StatusBits;
+
+    /// @brief queue depth; limited by the 7-bit RxAvail and TxAvail fields.
+    static constexpr std::size_t kQueueSize = 2 * ModbusSerialProtocol::knRxDataReg;
+    using Queue = ModbusSerialRingBuffer<kQueueSize>;
+
+    /// @brief Modbus exception codes returned by the register handlers.
+    enum class Exception : std::uint8_t
+        {
+        None                = 0,
+        IllegalFunction     = 1,
+        IllegalDataAddress  = 2,
+        IllegalDataValue    = 3,
+        DeviceFailure       = 4,
+        };
+
+    /// @brief maximum register count for a single read (Modbus limit).
+    static constexpr std::uint16_t knMaxReadRegs = 125;
+    /// @brief maximum register count for a single write (Modbus limit).
+    static constexpr std::uint16_t knMaxWriteRegs = 123;
+    /// @brief maximum write register count for Read/Write Multiple (Modbus limit).
+    static constexpr std::uint16_t knMaxReadWriteWriteRegs = 121;
+
+    ModbusSerialDevice(std::uint32_t baudrate = 0)
+        : m_baudrate(baudrate)
+        , m_fConnected(true)
+        , m_fReadWriteEnabled(true)
+        {}
+
+    virtual ~ModbusSerialDevice() = default;
+
+    /// @brief handle a read of input or holding registers (0x03, 0x04).
+    Exception readRegisters(std::uint16_t address, std::uint16_t nRegs, std::uint16_t *pRegs);
+
+    /// @brief handle a write of multiple registers (0x10).
+    Exception writeRegisters(std::uint16_t address, std::uint16_t nRegs, const std::uint16_t *pRegs);
+
+    /// @brief handle a Read/Write Multiple Registers (0x17). The write
+    ///     is done first, so the Status image (if read) reflects the
+    ///     data just written.
+    Exception readWriteRegisters(
+        std::uint16_t readAddress, std::uint16_t nReadRegs, std::uint16_t *pReadRegs,
+        std::uint16_t writeAddress, std::uint16_t nWriteRegs, const std::uint16_t *pWriteRegs
+        );
+
+    /// @brief enable or disable 0x17; when disabled, readWriteRegisters()
+    ///     reports IllegalFunction, like a device that doesn't have it.
+    void setReadWriteEnabled(bool fEnabled)
+        { this->m_fReadWriteEnabled = fEnabled; }
+
+    /// @brief compute the current image of the Status register.
+    StatusBits getStatus() const;
+
+    /// @brief return the last baud rate written by the host.
+    std::uint32_t getBaudrate() const
+        { return this->m_baudrate; }
+
+    bool isConnected() const
+        { return this->m_fConnected; }
+
+    /// @brief set the value reported in Status.Connect.
+    void setConnected(bool fConnected)
+        { this->m_fConnected = fConnected; }
+
+    /// @brief the bytes received by the UART, waiting to be read by the host.
+    Queue &getRxQueue()
+        { return this->m_rxQueue; }
+
+    /// @brief the bytes written by the host, waiting to go out the UART.
+    Queue &getTxQueue()
+        { return this->m_txQueue; }
+
+protected:
+    /// @brief called after the host writes Baudrate_i32.
+    virtual void notifyBaudrate(std::uint32_t baudrate)
+        { (void) baudrate; }
+
+private:
+    std::uint16_t readRegister(std::uint16_t address);
+    bool writeRegister(std::uint16_t address, std::uint16_t value);
+
+    Queue           m_rxQueue;
+    Queue           m_txQueue;
+    std::uint32_t   m_baudrate;
+    bool            m_fConnected;
+    bool            m_fReadWriteEnabled;
+    };
+
+} // namespace McciCatena
+
+#endif // _MCCI_Modbus_Serial_Device_h_
@@ -0,0 +1,113 @@
+/*
+
+Module:  MCCI_Modbus_Serial_EventLoop.h
+
+Function:
+    epoll-driven loop serving several Linux serial buses from one thread.
+
+Copyright notice and License:
+    See LICENSE file accompanying this project.
+
+Author:
+    MCCI Corporation   October 2026
+
+*/
+
+#pragma once
+
+#ifndef _MCCI_Modbus_Serial_EventLoop_h_
+# define _MCCI_Modbus_Serial_EventLoop_h_
+
+#include "MCCI_Modbus_Serial_Bus.h"
+#include "MCCI_Modbus_Serial_TermiosTransport.h"
+
+#if defined(__linux__) && ! defined(ARDUINO)
+
+namespace McciCatena {
+
+/// @brief run the hosts on several serial ports from one thread, sleeping
+///     in epoll between events.
+///
+/// Each port is added with the ModbusSerialBus (or lone ModbusSerialHost)
+/// that uses it. run() sleeps until a port is readable, a port with a
+/// partly written request is writable, a port's frame timer runs out, or
+/// the tick passes, and then polls only the buses that need it. The tick
+/// bounds how late the hosts' own timers (poll interval, transmit
+/// deadlines, discovery) can be seen. Another thread can cut the sleep
+/// short with wake().
+class ModbusSerialEventLoop
+    {
+public:
+    using Bus = ModbusSerialBus;
+    using Host = ModbusSerialHost;
+    using Port = ModbusSerialTermiosTransport;
+
+    static constexpr std::size_t knMaxPorts = 32;
+
+    /// @brief default tick, in microseconds.
+    static constexpr std::uint32_t kDefaultTick = 1000;
+
+    ModbusSerialEventLoop() = default;
+    ModbusSerialEventLoop(const ModbusSerialEventLoop &) = delete;
+    ModbusSerialEventLoop &operator=(const ModbusSerialEventLoop &) = delete;
+
+    ~ModbusSerialEventLoop()
+        { this->end(); }
+
+    /// @brief create the epoll instance and timer.
+    bool begin();
+
+    /// @brief release them; the ports and buses are left alone.
+    void end();
+
+    /// @brief add an open port and the bus that uses it.
+    bool add(Port &port, Bus &bus)
+        { return this->add(port, &bus, nullptr); }
+
+    /// @brief add an open port and the one host that uses it.
+    bool add(Port &port, Host &host)
+        { return this->add(port, nullptr, &host); }
+
+    /// @brief remove a port; do this before closing it.
+    bool remove(const Port &port);
+
+    /// @brief set the longest time between polls of a bus.
+    void setTick(std::uint32_t us)
+        { this->m_tick = us != 0 ? us : 1; }
+
+    /// @brief wait up to maxWait microseconds for events, then poll the
+    ///     buses that have something to do. Returns false on error.
+    bool run(std::uint32_t maxWait = UINT32_MAX);
+
+    /// @brief make run() return, after polling every bus. May be called
+    ///     from any thread.
+    void wake();
+
+private:
+    struct Entry
+        {
+        Port            *pPort = nullptr;
+        Bus             *pBus = nullptr;
+        Host            *pHost = nullptr;
+        std::uint32_t   tLastPoll = 0;
+        std::uint32_t   events = 0;
+        bool            fReady = false;
+        };
+
+    bool add(Port &port, Bus *pBus, Host *pHost);
+    bool updateEvents(Entry &entry);
+    std::uint32_t getWakeDelay(const Entry &entry, std::uint32_t now) const;
+    bool wait(std::uint32_t timeout);
+
+    Entry           m_entries[knMaxPorts];
+    std::uint32_t   m_tick = kDefaultTick;
+    int             m_epollFd = -1;
+    int             m_timerFd = -1;
+    int             m_wakeFd = -1;
+    };
+
+} // namespace McciCatena
+
+#endif // defined(__linux__) && ! defined(ARDUINO)
+
+#endif // _MCCI_Modbus_Serial_EventLoop_h_
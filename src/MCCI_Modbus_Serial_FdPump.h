@@ -0,0 +1,74 @@
+/*
+
+Module:  MCCI_Modbus_Serial_FdPump.h
+
+Function:
+    Moves bytes between a file descriptor and a threaded client.
+
+Copyright notice and License:
+    See LICENSE file accompanying this project.
+
+Author:
+    MCCI Corporation   October 2026
+
+*/
+
+#pragma once
+
+#ifndef _MCCI_Modbus_Serial_FdPump_h_
+# define _MCCI_Modbus_Serial_FdPump_h_
+
+#include "MCCI_Modbus_Serial_ThreadedClient.h"
+
+#if defined(__linux__) && ! defined(ARDUINO)
+
+namespace McciCatena {
+
+/// @brief the flow control shared by the pty and socket bridges.
+///
+/// pump() moves whatever can move between a non-blocking fd and a
+/// ModbusSerialThreadedClient, each way, and notes which way is stuck:
+/// output, because the client's transmit buffer is full (wait for its
+/// tx eventfd, then clearTxBlocked()); input, because the fd won't take
+/// any more (wait for it to be writable). getEvents() returns the epoll
+/// events to wait for on the fd.
+class ModbusSerialFdPump
+    {
+public:
+    using Client = ModbusSerialThreadedClientBase;
+
+    /// @brief forget any stuck state, for a new fd.
+    void reset()
+        {
+        this->m_fTxBlocked = false;
+        this->m_fRxBlocked = false;
+        }
+
+    /// @brief move data both ways. Returns false if the fd reached end of
+    ///     file or failed; it should be closed.
+    bool pump(Client &client, int fd);
+
+    /// @brief the client's transmit buffer has room again.
+    void clearTxBlocked()
+        { this->m_fTxBlocked = false; }
+
+    bool isTxBlocked() const
+        { return this->m_fTxBlocked; }
+
+    bool isRxBlocked() const
+        { return this->m_fRxBlocked; }
+
+    /// @brief return the epoll events to wait for: readable unless the
+    ///     transmit buffer is full, writable if input is waiting.
+    std::uint32_t getEvents() const;
+
+private:
+    bool            m_fTxBlocked = false;
+    bool            m_fRxBlocked = false;
+    };
+
+} // namespace McciCatena
+
+#endif // defined(__linux__) && ! defined(ARDUINO)
+
+#endif // _MCCI_Modbus_Serial_FdPump_h_
@@ -0,0 +1,441 @@
+/*
+
+Module:  MCCI_Modbus_Serial_Host.h
+
+Function:
+    Non-blocking host engine for the Serial-over-Modbus protocol.
+
+Copyright notice and License:
+    See LICENSE file accompanying this project.
+
+Author:
+    MCCI Corporation   October 2026
+
+*/
+
+#pragma once
+
+#ifndef _MCCI_Modbus_Serial_Host_h_
+# define _MCCI_Modbus_Serial_Host_h_
+
+#include "MCCI_Modbus_Serial_Transport.h"
+#include "MCCI_Modbus_Serial_Backoff.h"
+#include "MCCI_Modbus_Serial_PollInterval.h"
+#include "MCCI_Modbus_Serial_ReadSize.h"
+#include "MCCI_Modbus_Serial_TxArrivals.h"
+
+namespace McciCatena {
+
+/// @brief the host FSM described in the README (see assets/HostFSM.png).
+///
+/// The engine runs one remote virtual UART. Call poll() from the main
+/// loop; each call does a bounded amount of work and never waits for the
+/// bus. Application data moves through a Client, which the engine asks
+/// for pending transmit data and hands received data to.
+///
+/// To run several devices on one bus, add their hosts to a
+/// ModbusSerialBus and call the bus's poll() instead.
+class ModbusSerialHost
+    {
+public:
+    using Protocol = ModbusSerialProtocol;
+    using Register = Protocol::Register;
+    using StatusBits = Protocol::StatusBits;
+    using TxCredit = Protocol::TxCredit;
+    using Transaction = ModbusSerialTransaction;
+    using Transport = ModbusSerialTransport;
+
+    /// @brief FSM states; the names match the README.
+    enum class State : std::uint8_t
+        {
+        stStopped,      ///< not running: before begin(), or after end().
+        stConfig,       ///< discovery: set baud rate / probe the device.
+        stAwaitDevice,  ///< discovery: back off, then probe DummyReg_i32.
+        stIdle,         ///< operating: wait for poll timer or write data.
+        stRead,         ///< operating: read Status + RxData.
+        stWrite,        ///< operating: write TxData.
+        };
+
+    /// @brief the application side of the virtual UART.
+    ///
+    /// The engine calls these from poll(); none may block.
+    class Client
+        {
+    public:
+        virtual ~Client() = default;
+
+        /// @brief return number of bytes waiting to be sent to the device.
+        virtual std::size_t getTxPending() = 0;
+
+        /// @brief copy up to nBuf pending bytes to pBuf without consuming
+        ///     them; return number copied.
+        virtual std::size_t peekTx(std::uint8_t *pBuf, std::size_t nBuf) = 0;
+
+        /// @brief discard n bytes, which the device has accepted.
+        virtual void consumeTx(std::size_t n) = 0;
+
+        /// @brief return number of bytes putRx() can accept.
+        virtual std::size_t getRxSpace() = 0;
+
+        /// @brief accept n bytes received from the device.
+        virtual void putRx(const std::uint8_t *pBuf, std::size_t n) = 0;
+
+        /// @brief return true if pending output should go out now,
+        ///     without waiting for coalescing; see setTxCoalescing().
+        virtual bool isTxFlushRequested()
+            { return false; }
+        };
+
+    /// @brief running counters, for diagnostics.
+    struct Stats
+        {
+        std::uint32_t   nReads = 0;         ///< Status+RxData reads issued.
+        std::uint32_t   nWrites = 0;        ///< TxData writes issued.
+        std::uint32_t   nReadWrites = 0;    ///< combined 0x17 transactions issued.
+        std::uint32_t   nRxBytes = 0;       ///< bytes delivered to the client.
+        std::uint32_t   nTxBytes = 0;       ///< bytes accepted by the device.
+        std::uint32_t   nNoReply = 0;       ///< transactions that timed out.
+        std::uint32_t   nErrors = 0;        ///< other failed transactions.
+        std::uint32_t   nTxLateBytes = 0;   ///< bytes written after their deadline.
+        std::uint32_t   nTxLateWrites = 0;  ///< writes carrying any late byte.
+        };
+
+    /// @brief largest useful coalescing threshold: a full TxData window.
+    static constexpr std::uint16_t knMaxTxThreshold = 2 * Protocol::knTxDataReg;
+
+    ModbusSerialHost(Transport &transport, std::uint8_t unitId)
+        : m_transport(transport)
+        , m_timing(transport.getBusBaudrate())
+        , m_unitId(unitId)
+        {}
+
+    // neither copyable nor movable: the transport holds a pointer to m_txn.
+    ModbusSerialHost(const ModbusSerialHost &) = delete;
+    ModbusSerialHost &operator=(const ModbusSerialHost &) = delete;
+
+    /// @brief start the FSM.
+    /// @param client is the application side of the UART.
+    /// @param baudrate is written to Baudrate_i32 in stConfig; zero means
+    ///     leave the device's setting alone and just probe DummyReg_i32.
+    ///     Once the device has taken it, later passes through stConfig
+    ///     read it back, and write it only if the device has lost it.
+    bool begin(Client &client, std::uint32_t baudrate = 0);
+
+    /// @brief request an orderly stop. The FSM enters stStopped once any
+    ///     outstanding transaction completes.
+    void end()
+        { this->m_fExitRequest = true; }
+
+    /// @brief advance the FSM. Never blocks. Don't use this if the host
+    ///     has been added to a ModbusSerialBus.
+    void poll();
+
+    /// @brief return how many microseconds poll() can wait before the
+    ///     FSM's own timers need it: the poll interval, coalescing and
+    ///     transmit deadlines, or the stAwaitDevice retry. UINT32_MAX if
+    ///     it's waiting only on the transport. New output from the
+    ///     client may make it due sooner.
+    std::uint32_t getWakeDelay(std::uint32_t now) const;
+
+    State getState() const
+        { return this->m_state; }
+
+    /// @brief true if in the operating macro-state.
+    bool isOperating() const
+        {
+        return this->m_state == State::stIdle ||
+               this->m_state == State::stRead ||
+               this->m_state == State::stWrite;
+        }
+
+    /// @brief true if a transaction is outstanding.
+    bool isBusy() const
+        { return this->m_fTxnActive; }
+
+    std::uint8_t getUnitId() const
+        { return this->m_unitId; }
+
+    /// @brief return the last Status image; see isStatusValid().
+    StatusBits getLastStatus() const
+        { return this->m_status; }
+
+    /// @brief true if the last Status image is current.
+    bool isStatusValid() const
+        { return this->m_fStatusValid; }
+
+    /// @brief use a fixed stIdle poll interval, in microseconds.
+    void setPollInterval(std::uint32_t us)
+        { this->m_pollInterval.setLimits(us, us); }
+
+    /// @brief let the stIdle poll interval adapt to traffic between
+    ///     floor and ceiling (microseconds). The defaults are
+    ///     ModbusSerialPollInterval::kDefaultFloor and kDefaultCeiling.
+    void setPollIntervalLimits(std::uint32_t floor, std::uint32_t ceiling)
+        { this->m_pollInterval.setLimits(floor, ceiling); }
+
+    /// @brief return the current stIdle poll interval, in microseconds.
+    std::uint32_t getPollInterval() const
+        { return this->m_pollInterval.getInterval(); }
+
+    /// @brief allow or forbid combined write+read transactions (0x17).
+    ///
+    /// When allowed (the default), each TxData write also reads Status
+    /// and RxData in the same frame, unless the transport can't carry
+    /// 0x17 or the device rejects it, in which case the engine falls
+    /// back to separate 0x10 writes and 0x04 reads. The device is probed
+    /// again each time it reconnects.
+    void setReadWriteEnabled(bool fEnabled)
+        { this->m_fReadWriteEnabled = fEnabled; }
+
+    /// @brief true if writes are currently combined with reads.
+    bool isReadWriteActive() const
+        {
+        return this->m_fReadWriteEnabled &&
+               this->m_readWriteSupport != ReadWriteSupport::No &&
+               this->m_transport.isFunctionSupported(Transaction::Function::ReadWriteMultipleRegisters);
+        }
+
+    /// @brief let writes use credit predicted from the device's baud rate
+    ///     between Status reads.
+    ///
+    /// Off by default. If the device's UART can be stopped by flow
+    /// control, output written on predicted credit can overflow the
+    /// device's queue before the next Status read shows the stall. The
+    /// prediction needs the baud rate passed to begin().
+    void setTxCreditPrediction(bool fEnabled)
+        {
+        this->m_fTxPrediction = fEnabled;
+        this->m_txCredit.setBaudrate(fEnabled ? this->m_baudrate : 0);
+        }
+
+    /// @brief hold output until enough has accumulated to fill a write.
+    ///
+    /// Pending output is written once there are nThreshold bytes (at
+    /// most knMaxTxThreshold), once the oldest has waited deadline
+    /// microseconds, or once the client asks for a flush. Output also
+    /// goes as soon as it's enough to fill the device's free space.
+    /// The default, a threshold of 1, sends every byte right away.
+    void setTxCoalescing(std::uint16_t nThreshold, std::uint32_t deadline)
+        {
+        this->m_txThreshold = nThreshold == 0 ? 1
+                            : nThreshold > knMaxTxThreshold ? knMaxTxThreshold
+                            : nThreshold;
+        this->m_txDeadline = deadline;
+        }
+
+    /// @brief give every transmit byte a deadline, in microseconds after
+    ///     it's queued, by which it must be written to the device.
+    ///
+    /// A write starts early enough to meet the oldest pending byte's
+    /// deadline, estimated from the bus baud rate, whatever the
+    /// coalescing settings. On a ModbusSerialBus, the host also goes
+    /// ahead of other devices when its deadline is near. Bytes written
+    /// late are counted in Stats::nTxLateBytes and nTxLateWrites. Zero
+    /// (the default) turns deadlines off.
+    ///
+    /// A write can't start until the transaction ahead of it finishes, so
+    /// while any bound is set, every transaction on the bus is kept to
+    /// half the tightest bound at the bus baud rate. Bounds shorter than
+    /// a minimal transaction can't be met.
+    void setTxLatencyBound(std::uint32_t us)
+        { this->m_txLatencyBound = us; }
+
+    std::uint32_t getTxLatencyBound() const
+        { return this->m_txLatencyBound; }
+
+    /// @brief set how long the device may take to start answering, after
+    ///     the end of a request and the t3.5 gap, before the transaction
+    ///     fails with NoReply. The response timeout given to the
+    ///     transport adds the response's own bus time, at the bus baud
+    ///     rate; on a transport without a baud rate, the transport's own
+    ///     timeout applies.
+    void setTurnaroundLimit(std::uint32_t us)
+        { this->m_turnaroundLimit = us; }
+
+    /// @brief set the stAwaitDevice retry intervals, in microseconds: the
+    ///     first, after the device drops out, and the longest it backs
+    ///     off to. See ModbusSerialBackoff.
+    void setAwaitInterval(std::uint32_t first, std::uint32_t limit)
+        { this->m_awaitBackoff.setLimits(first, limit); }
+
+    /// @brief set a fixed stAwaitDevice retry interval, in microseconds;
+    ///     retries are still jittered.
+    void setAwaitInterval(std::uint32_t us)
+        { this->setAwaitInterval(us, us); }
+
+    /// @brief set how long a device may take to start answering an
+    ///     stAwaitDevice probe; like setTurnaroundLimit(). The default is
+    ///     ModbusSerialTiming::kDefaultProbeTurnaroundLimit.
+    void setProbeTurnaroundLimit(std::uint32_t us)
+        { this->m_probeTurnaroundLimit = us; }
+
+    const Stats &getStats() const
+        { return this->m_stats; }
+
+private:
+    /// @brief what we know about the device's support for 0x17.
+    enum class ReadWriteSupport : std::uint8_t
+        {
+        Unknown,
+        Yes,
+        No,
+        };
+
+    void setState(State newState, std::uint32_t now);
+    bool prepare(std::uint32_t now, bool fEarlyPoll);
+    void complete(std::uint32_t now);
+
+    void prepareConfig();
+    void prepareProbe();
+    bool completeConfig();
+    bool prepareRead();
+    bool prepareWrite();
+    void completeRead(std::uint32_t now);
+    void completeWrite(std::uint32_t now);
+    State getNextOperatingState(std::uint32_t now, bool fHaveStatus) const;
+    void updateTxArrivals(std::uint32_t now);
+    bool isTxDue(std::uint32_t now) const;
+    std::int32_t getTxSlack(std::uint32_t now) const;
+    std::uint32_t getTxWriteMicros() const;
+    std::uint16_t getMaxTransactionBytes() const;
+    std::uint16_t getReadRegs() const;
+    static std::uint32_t getRemaining(std::uint32_t tWake, std::uint32_t now);
+    bool isPollDue(std::uint32_t now) const
+        { return now - this->m_tLastPoll >= this->m_pollInterval.getInterval(); }
+
+    // the interface used by ModbusSerialBus.
+    friend class ModbusSerialBus;
+
+    Transaction *startTransaction(std::uint32_t now, bool fEarlyPoll);
+    bool submitTransaction(Transaction &txn);
+    bool finishTransaction(std::uint32_t now);
+
+    /// @brief return microseconds until the next poll is due (negative if
+    ///     overdue); only meaningful in stIdle.
+    std::int32_t getPollDelay(std::uint32_t now) const
+        {
+        return std::int32_t(this->m_pollInterval.getInterval() - (now - this->m_tLastPoll));
+        }
+
+    Transport &getTransport() const
+        { return this->m_transport; }
+
+    /// @brief return the number of bytes we know could move right now:
+    ///     input known to be waiting in the device, plus pending output
+    ///     that's due and the device has room for.
+    std::uint32_t getBacklog()
+        {
+        if (! this->isOperating() || this->m_pClient == nullptr)
+            return 0;
+
+        auto const now = this->m_transport.getMicros();
+        std::uint32_t nTx = 0;
+
+        if (this->isTxDue(now))
+            {
+            std::uint32_t const nTxAvail = this->getTxAvail(now);
+
+            nTx = std::uint32_t(this->m_pClient->getTxPending());
+            if (nTx > nTxAvail)
+                nTx = nTxAvail;
+            }
+
+        return this->m_nRxAvail + nTx;
+        }
+
+    /// @brief set the tightest transmit latency bound of any host on the
+    ///     bus (zero if none); our transactions are kept short enough for it.
+    void setBusLatencyBound(std::uint32_t us)
+        { this->m_busLatencyBound = us; }
+
+    /// @brief return how far ahead of a deadline output must be ready to
+    ///     go: the bus time of the longest transaction, which may be in
+    ///     progress when the output becomes due.
+    std::uint32_t getTxHorizon() const
+        {
+        return this->m_timing.getFrameMicros(this->getMaxTransactionBytes())
+             + this->m_timing.getOverheadMicros();
+        }
+
+    /// @brief true if the host has output whose deadline is within one
+    ///     long transaction, and could write it now.
+    bool isTxUrgent(std::uint32_t now) const
+        {
+        if (this->m_txLatencyBound == 0 || this->m_fTxnActive || ! this->isOperating())
+            return false;
+        if (this->m_pClient->getTxPending() == 0)
+            return false;
+        if (this->m_fStatusValid && this->getTxAvail(now) == 0)
+            return false;
+
+        return this->getTxSlack(now) <= std::int32_t(this->getTxHorizon());
+        }
+
+    /// @brief return the transmit slots free in the device at time now.
+    std::uint16_t getTxAvail(std::uint32_t now) const
+        { return this->m_txCredit.getTxAvail(now); }
+
+    /// @brief return the RTU frame bytes (request plus response) of the
+    ///     last transaction; this is what it cost the bus.
+    std::uint16_t getLastBusBytes() const
+        { return this->m_txn.getRequestBytes() + this->m_txn.getResponseBytes(); }
+
+    Transport       &m_transport;
+    Client          *m_pClient = nullptr;
+    Transaction     m_txn;
+    Stats           m_stats;
+    StatusBits      m_status;
+    /// @brief free space in the device's output queue.
+    TxCredit        m_txCredit;
+    std::uint32_t   m_baudrate = 0;
+    /// @brief the device's Baudrate_i32 when last read or written; zero
+    ///     if unknown. Kept across stAwaitDevice.
+    std::uint32_t   m_deviceBaudrate = 0;
+    ModbusSerialPollInterval m_pollInterval;
+    ModbusSerialReadSize m_readSize;
+    /// @brief RTU gaps and frame times at the bus baud rate.
+    ModbusSerialTiming m_timing;
+    /// @brief longest device turnaround before NoReply.
+    std::uint32_t   m_turnaroundLimit = ModbusSerialTiming::kDefaultTurnaroundLimit;
+    /// @brief longest device turnaround for an stAwaitDevice probe.
+    std::uint32_t   m_probeTurnaroundLimit = ModbusSerialTiming::kDefaultProbeTurnaroundLimit;
+    /// @brief stAwaitDevice retry intervals.
+    ModbusSerialBackoff m_awaitBackoff;
+    /// @brief when stAwaitDevice was entered.
+    std::uint32_t   m_tAwait = 0;
+    /// @brief how long to wait in stAwaitDevice before probing.
+    std::uint32_t   m_awaitDelay = 0;
+    /// @brief coalescing deadline, in microseconds.
+    std::uint32_t   m_txDeadline = 0;
+    /// @brief per-byte transmit deadline, in microseconds; zero if none.
+    std::uint32_t   m_txLatencyBound = 0;
+    /// @brief tightest latency bound on the bus, set by ModbusSerialBus.
+    std::uint32_t   m_busLatencyBound = 0;
+    /// @brief when each pending transmit byte was queued.
+    ModbusSerialTxArrivals m_txArrivals;
+    /// @brief when the outstanding transaction was submitted.
+    std::uint32_t   m_tSubmit = 0;
+    /// @brief when the last Status read completed; drives the poll timer.
+    std::uint32_t   m_tLastPoll = 0;
+    /// @brief receive bytes known to be waiting in the device.
+    std::uint16_t   m_nRxAvail = 0;
+    /// @brief bytes carried by the write in progress.
+    std::uint16_t   m_nTxSending = 0;
+    /// @brief coalescing threshold, in bytes.
+    std::uint16_t   m_txThreshold = 1;
+    std::uint8_t    m_unitId;
+    State           m_state = State::stStopped;
+    /// @brief m_state before startTransaction(), for submitTransaction()
+    ///     to go back to if the transport refuses the transaction.
+    State           m_startState = State::stStopped;
+    ReadWriteSupport m_readWriteSupport = ReadWriteSupport::Unknown;
+    bool            m_fTxnActive = false;
+    bool            m_fStatusValid = false;
+    bool            m_fExitRequest = false;
+    bool            m_fReadWriteEnabled = true;
+    bool            m_fTxPrediction = false;
+    };
+
+} // namespace McciCatena
+
+#endif // _MCCI_Modbus_Serial_Host_h_
@@ -0,0 +1,242 @@
+/*
+
+Module:  MCCI_Modbus_Serial_LoopbackTransport.h
+
+Function:
+    In-memory transport connecting the host engine to simulated devices.
+
+Copyright notice and License:
+    See LICENSE file accompanying this project.
+
+Author:
+    MCCI Corporation   October 2026
+
+*/
+
+#pragma once
+
+#ifndef _MCCI_Modbus_Serial_LoopbackTransport_h_
+# define _MCCI_Modbus_Serial_LoopbackTransport_h_
+
+#include "MCCI_Modbus_Serial_Transport.h"
+#include "MCCI_Modbus_Serial_Device.h"
+
+namespace McciCatena {
+
+/// @brief a transport that delivers transactions to ModbusSerialDevice
+///     objects in memory.
+///
+/// Time is virtual: getMicros() returns a counter that only moves when
+/// the caller calls advanceMicros(). Each transaction takes as long as
+/// it would on an RTU bus at the configured baud rate: the request
+/// frame, t3.5 for the device to see its end, the device latency, and
+/// the response frame. The next request starts t3.5 after that, even if
+/// it was submitted sooner, so bus-usage figures from the simulation are
+/// meaningful. A unit ID with no attached device never answers, and the
+/// transaction fails with NoReply after its response timeout.
+class ModbusSerialLoopbackTransport : public ModbusSerialTransport
+    {
+public:
+    using Device = ModbusSerialDevice;
+
+    static constexpr std::size_t knMaxDevices = 32;
+
+    ModbusSerialLoopbackTransport(std::uint32_t busBaudrate = 19200)
+        : m_timing(busBaudrate)
+        {}
+
+    /// @brief attach a simulated device at a given unit ID, replacing any
+    ///     device already there.
+    bool attach(std::uint8_t unitId, Device &device)
+        {
+        Entry *pFree = nullptr;
+
+        // the unit may already be attached in a later slot than the
+        // first free one; it must keep only one entry.
+        for (auto &e : this->m_devices)
+            {
+            if (e.pDevice != nullptr && e.unitId == unitId)
+                {
+                e.pDevice = &device;
+                return true;
+                }
+            if (e.pDevice == nullptr && pFree == nullptr)
+                pFree = &e;
+            }
+
+        if (pFree == nullptr)
+            return false;
+
+        pFree->unitId = unitId;
+        pFree->pDevice = &device;
+        return true;
+        }
+
+    /// @brief remove the device at unitId, so it stops answering.
+    void detach(std::uint8_t unitId)
+        {
+        for (auto &e : this->m_devices)
+            {
+            if (e.pDevice != nullptr && e.unitId == unitId)
+                e.pDevice = nullptr;
+            }
+        }
+
+    /// @brief set how long a missing device takes to time out, when the
+    ///     transaction doesn't say.
+    void setResponseTimeout(std::uint32_t us)
+        { this->m_responseTimeout = us; }
+
+    /// @brief set the simulated device processing delay per transaction,
+    ///     after it has seen t3.5 of silence.
+    void setDeviceLatency(std::uint32_t us)
+        { this->m_deviceLatency = us; }
+
+    /// @brief move virtual time forward.
+    void advanceMicros(std::uint32_t us)
+        { this->m_now += us; }
+
+    /// @brief move virtual time to the completion of the outstanding
+    ///     transaction, if any. Returns false if the bus is idle.
+    bool advanceToCompletion()
+        {
+        if (this->m_pActive == nullptr)
+            return false;
+        if (std::int32_t(this->m_tDone - this->m_now) > 0)
+            this->m_now = this->m_tDone;
+        return true;
+        }
+
+    /// @brief number of transactions submitted so far.
+    std::uint32_t getTransactionCount() const
+        { return this->m_nTransactions; }
+
+    /// @brief total virtual time the bus has been busy, counting the
+    ///     t3.5 gap after each transaction.
+    std::uint32_t getBusyMicros() const
+        { return this->m_busyMicros; }
+
+    virtual bool isReady() const override
+        { return this->m_pActive == nullptr; }
+
+    virtual bool submit(Transaction &t) override
+        {
+        if (this->m_pActive != nullptr)
+            return false;
+
+        // the request goes once the line has been quiet for t3.5.
+        std::uint32_t tStart = this->m_now;
+        if (std::int32_t(this->m_tNextRequest - tStart) > 0)
+            tStart = this->m_tNextRequest;
+
+        std::uint32_t tBus;
+        if (this->findDevice(t.unitId) != nullptr)
+            tBus = this->m_timing.getFrameMicros(t.getRequestBytes())
+                 + this->m_timing.getT35()
+                 + this->m_deviceLatency
+                 + this->m_timing.getFrameMicros(t.getResponseBytes());
+        else
+            tBus = this->m_timing.getFrameMicros(t.getRequestBytes())
+                 + (t.responseTimeout != 0 ? t.responseTimeout : this->m_responseTimeout);
+
+        t.status = Transaction::Status::Pending;
+        this->m_pActive = &t;
+        this->m_tDone = tStart + tBus;
+        this->m_tNextRequest = this->m_timing.getNextRequestTime(this->m_tDone);
+        this->m_busyMicros += tBus + this->m_timing.getT35();
+        ++this->m_nTransactions;
+        return true;
+        }
+
+    virtual void poll() override
+        {
+        if (this->m_pActive == nullptr)
+            return;
+        if (std::int32_t(this->m_now - this->m_tDone) < 0)
+            return;
+
+        auto const pT = this->m_pActive;
+        this->m_pActive = nullptr;
+        this->execute(*pT);
+        }
+
+    virtual std::uint32_t getBusBaudrate() const override
+        { return this->m_timing.getBaudrate(); }
+
+    virtual std::uint32_t getMicros() const override
+        { return this->m_now; }
+
+private:
+    struct Entry
+        {
+        std::uint8_t    unitId = 0;
+        Device          *pDevice = nullptr;
+        };
+
+    Device *findDevice(std::uint8_t unitId) const
+        {
+        for (auto const &e : this->m_devices)
+            {
+            if (e.pDevice != nullptr && e.unitId == unitId)
+                return e.pDevice;
+            }
+        return nullptr;
+        }
+
+    void execute(Transaction &t)
+        {
+        Device * const pDevice = this->findDevice(t.unitId);
+
+        if (pDevice == nullptr)
+            {
+            t.status = Transaction::Status::NoReply;
+            return;
+            }
+
+        Device::Exception e;
+
+        switch (t.function)
+            {
+        case Transaction::Function::ReadHoldingRegisters:
+        case Transaction::Function::ReadInputRegisters:
+            e = pDevice->readRegisters(t.readAddress, t.nRead, t.readRegs);
+            break;
+        case Transaction::Function::WriteMultipleRegisters:
+            e = pDevice->writeRegisters(t.writeAddress, t.nWrite, t.writeRegs);
+            break;
+        case Transaction::Function::ReadWriteMultipleRegisters:
+            e = pDevice->readWriteRegisters(
+                    t.readAddress, t.nRead, t.readRegs,
+                    t.writeAddress, t.nWrite, t.writeRegs
+                    );
+            break;
+        default:
+            e = Device::Exception::IllegalFunction;
+            break;
+            }
+
+        if (e == Device::Exception::None)
+            t.status = Transaction::Status::Success;
+        else
+            {
+            t.status = Transaction::Status::Exception;
+            t.exceptionCode = std::uint8_t(e);
+            }
+        }
+
+    Entry           m_devices[knMaxDevices];
+    Transaction     *m_pActive = nullptr;
+    ModbusSerialTiming m_timing;
+    std::uint32_t   m_now = 0;
+    std::uint32_t   m_tDone = 0;
+    /// @brief when the line will have been quiet for t3.5.
+    std::uint32_t   m_tNextRequest = 0;
+    std::uint32_t   m_responseTimeout = 100000;
+    std::uint32_t   m_deviceLatency = 0;
+    std::uint32_t   m_nTransactions = 0;
+    std::uint32_t   m_busyMicros = 0;
+    };
+
+} // namespace McciCatena
+
+#endif // _MCCI_Modbus_Serial_LoopbackTransport_h_
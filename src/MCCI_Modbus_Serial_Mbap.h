@@ -0,0 +1,102 @@
+/*
+
+Module:  MCCI_Modbus_Serial_Mbap.h
+
+Function:
+    Modbus TCP (MBAP) framing for ModbusSerialTransaction.
+
+Copyright notice and License:
+    See LICENSE file accompanying this project.
+
+Author:
+    MCCI Corporation   October 2026
+
+*/
+
+#pragma once
+
+#ifndef _MCCI_Modbus_Serial_Mbap_h_
+# define _MCCI_Modbus_Serial_Mbap_h_
+
+#include "MCCI_Modbus_Serial_Transport.h"
+
+namespace McciCatena {
+
+class ModbusSerialDevice;
+
+/// @brief encode and decode Modbus TCP application data units.
+///
+/// An ADU is the 7-byte MBAP header (transaction ID, protocol ID 0,
+/// length, unit ID) followed by the PDU (function code and data). The
+/// client side turns a ModbusSerialTransaction into a request and a
+/// response back into the transaction; the server side runs a request
+/// against a ModbusSerialDevice. Neither side does any I/O.
+class ModbusSerialMbap
+    {
+public:
+    using Transaction = ModbusSerialTransaction;
+
+    /// @brief bytes in the MBAP header, including the unit ID.
+    static constexpr std::size_t knHeaderBytes = 7;
+
+    /// @brief largest ADU allowed by the Modbus TCP spec.
+    static constexpr std::size_t knMaxAduBytes = 260;
+
+    /// @brief gateway exception: no path to the target device.
+    static constexpr std::uint8_t kExceptionGatewayPath = 0x0A;
+    /// @brief gateway exception: the target device didn't answer.
+    static constexpr std::uint8_t kExceptionGatewayTarget = 0x0B;
+
+    /// @brief size of a complete ADU at the front of pBuf: zero if more
+    ///     bytes are needed, or SIZE_MAX if the header is invalid and the
+    ///     stream can't be resynchronized.
+    static std::size_t getAduSize(const std::uint8_t *pBuf, std::size_t nBuf);
+
+    static std::uint16_t getTransactionId(const std::uint8_t *pAdu)
+        { return std::uint16_t((pAdu[0] << 8) | pAdu[1]); }
+
+    static std::uint8_t getUnitId(const std::uint8_t *pAdu)
+        { return pAdu[6]; }
+
+    //---- client side ----
+
+    /// @brief encode the request for t into pBuf (at least knMaxAduBytes);
+    ///     return its size.
+    static std::size_t encodeRequest(std::uint8_t *pBuf, std::uint16_t transactionId, const Transaction &t);
+
+    /// @brief encode a request to unit unitId into pBuf (at least
+    ///     knMaxAduBytes) that writes data to TxData, straight from the
+    ///     caller's bytes; see ModbusSerialPdu::encodeTxWrite(). Sets
+    ///     nSent, and returns the ADU size; zero if nothing fits.
+    static std::size_t encodeTxWrite(
+        std::uint8_t *pBuf,
+        std::size_t &nSent,
+        std::uint16_t transactionId,
+        std::uint8_t unitId,
+        ModbusSerialProtocol::StatusBits status,
+        const std::uint8_t *pData, std::size_t nData,
+        const std::uint8_t *pWrap = nullptr, std::size_t nWrap = 0
+        );
+
+    /// @brief decode the response ADU into t, and set t.status. Gateway
+    ///     exceptions saying the device didn't answer become NoReply.
+    static void decodeResponse(const std::uint8_t *pAdu, std::size_t nAdu, Transaction &t);
+
+    //---- server side ----
+
+    /// @brief run the request ADU against device (nullptr if no device has
+    ///     the unit ID), and encode the response into pResponse (at least
+    ///     knMaxAduBytes). Returns the response size.
+    static std::size_t serveRequest(
+        const std::uint8_t *pAdu, std::size_t nAdu,
+        ModbusSerialDevice *pDevice,
+        std::uint8_t *pResponse
+        );
+
+private:
+    static std::size_t putHeader(std::uint8_t *pBuf, std::uint16_t transactionId, std::uint8_t unitId, std::size_t nPdu);
+    };
+
+} // namespace McciCatena
+
+#endif // _MCCI_Modbus_Serial_Mbap_h_
@@ -0,0 +1,104 @@
+/*
+
+Module:  MCCI_Modbus_Serial_Pdu.h
+
+Function:
+    Modbus PDU encoding shared by the RTU and TCP framings.
+
+Copyright notice and License:
+    See LICENSE file accompanying this project.
+
+Author:
+    MCCI Corporation   October 2026
+
+*/
+
+#pragma once
+
+#ifndef _MCCI_Modbus_Serial_Pdu_h_
+# define _MCCI_Modbus_Serial_Pdu_h_
+
+#include "MCCI_Modbus_Serial_Transport.h"
+
+namespace McciCatena {
+
+class ModbusSerialDevice;
+
+/// @brief encode and decode Modbus PDUs (function code and data) for the
+///     functions in ModbusSerialTransaction::Function.
+///
+/// The framings (ModbusSerialRtu, ModbusSerialMbap) add the unit ID and
+/// their own header or CRC around these.
+class ModbusSerialPdu
+    {
+public:
+    using Transaction = ModbusSerialTransaction;
+    using StatusBits = ModbusSerialProtocol::StatusBits;
+
+    /// @brief largest PDU allowed by the Modbus spec.
+    static constexpr std::size_t knMaxPduBytes = 253;
+
+    /// @brief largest PDU from encodeTxWrite(): all of TxData and
+    ///     TxDataByte, the most that TxAvail can report.
+    static constexpr std::size_t knMaxTxWritePduBytes = 6 + 2 * (ModbusSerialProtocol::knTxDataReg + 1);
+
+    static std::uint16_t getU16(const std::uint8_t *p)
+        { return std::uint16_t((p[0] << 8) | p[1]); }
+
+    static std::uint8_t *putU16(std::uint8_t *p, std::uint16_t v)
+        {
+        p[0] = std::uint8_t(v >> 8);
+        p[1] = std::uint8_t(v);
+        return p + 2;
+        }
+
+    /// @brief encode the request PDU for t into pBuf; return its size.
+    static std::size_t encodeRequest(std::uint8_t *pBuf, const Transaction &t);
+
+    /// @brief encode a Write Multiple Registers (0x10) request PDU into
+    ///     pBuf (at least knMaxTxWritePduBytes), sending as much data as
+    ///     status's TxAvail allows. The data is copied straight into the
+    ///     PDU, since registers go on the wire in character order; an odd
+    ///     final byte goes to TxDataByte. The data is nData bytes at pData
+    ///     followed by nWrap at pWrap, so a ring buffer's two runs can be
+    ///     sent as they are (see ModbusSerialRingBuffer::peekRun()).
+    ///     Sets nSent to the number of bytes sent, and returns the PDU
+    ///     size; zero if nothing fits.
+    static std::size_t encodeTxWrite(
+        std::uint8_t *pBuf,
+        std::size_t &nSent,
+        StatusBits status,
+        const std::uint8_t *pData, std::size_t nData,
+        const std::uint8_t *pWrap = nullptr, std::size_t nWrap = 0
+        );
+
+    /// @brief decode a response PDU into t and set t.status. The caller
+    ///     has already checked the unit ID.
+    static void decodeResponse(const std::uint8_t *pPdu, std::size_t nPdu, Transaction &t);
+
+    /// @brief return the size of the response PDU to t: the size of an
+    ///     exception response if fException, of a normal one otherwise.
+    static std::size_t getResponseSize(const Transaction &t, bool fException)
+        { return fException ? 2 : std::size_t(t.getResponseBytes()) - 3; }
+
+    /// @brief run a request PDU against device, and encode the response
+    ///     PDU into pResponse (at least knMaxPduBytes). Malformed requests
+    ///     get IllegalDataValue. Returns the response size.
+    static std::size_t serveRequest(
+        const std::uint8_t *pPdu, std::size_t nPdu,
+        ModbusSerialDevice &device,
+        std::uint8_t *pResponse
+        );
+
+    /// @brief encode an exception response for function fn; return its size.
+    static std::size_t putException(std::uint8_t *pBuf, std::uint8_t fn, std::uint8_t code)
+        {
+        pBuf[0] = std::uint8_t(fn | 0x80);
+        pBuf[1] = code;
+        return 2;
+        }
+    };
+
+} // namespace McciCatena
+
+#endif // _MCCI_Modbus_Serial_Pdu_h_
@@ -0,0 +1,121 @@
+/*
+
+Module:  MCCI_Modbus_Serial_PollInterval.h
+
+Function:
+    Adaptive stIdle poll-interval controller.
+
+Copyright notice and License:
+    See LICENSE file accompanying this project.
+
+Author:
+    MCCI Corporation   October 2026
+
+*/
+
+#pragma once
+
+#ifndef _MCCI_Modbus_Serial_PollInterval_h_
+# define _MCCI_Modbus_Serial_PollInterval_h_
+
+#include "MCCI_Modbus_Serial_Protocol.h"
+
+namespace McciCatena {
+
+/// @brief choose the stIdle poll interval from recent Status.RxAvail values.
+///
+/// Each Status read is fed to update(). When the device reports input,
+/// the interval drops toward the floor, by more the fuller the device's
+/// queue was. When the device reports nothing, the interval grows by a
+/// quarter per poll toward the ceiling. Bursts therefore get low latency,
+/// and an idle device costs few bus cycles. Setting floor == ceiling
+/// gives a fixed interval.
+class ModbusSerialPollInterval
+    {
+public:
+    using StatusBits = ModbusSerialProtocol::StatusBits;
+
+    /// @brief default floor, in microseconds (README: "at least 20 ms").
+    static constexpr std::uint32_t kDefaultFloor = 20 * 1000;
+    /// @brief default ceiling, in microseconds (README: "100 ms is probably a better choice").
+    static constexpr std::uint32_t kDefaultCeiling = 100 * 1000;
+
+    ModbusSerialPollInterval(
+        std::uint32_t floor = kDefaultFloor,
+        std::uint32_t ceiling = kDefaultCeiling
+        )
+        {
+        this->setLimits(floor, ceiling);
+        }
+
+    /// @brief set the limits, in microseconds. The interval is clamped
+    ///     to the new range.
+    void setLimits(std::uint32_t floor, std::uint32_t ceiling)
+        {
+        if (ceiling < floor)
+            ceiling = floor;
+
+        this->m_floor = floor;
+        this->m_ceiling = ceiling;
+        this->m_interval = clamp(this->m_interval, floor, ceiling);
+        }
+
+    std::uint32_t getFloor() const
+        { return this->m_floor; }
+
+    std::uint32_t getCeiling() const
+        { return this->m_ceiling; }
+
+    /// @brief return the current interval, in microseconds.
+    std::uint32_t getInterval() const
+        { return this->m_interval; }
+
+    /// @brief start over at the floor; used when a device (re)appears,
+    ///     since it has probably buffered something.
+    void reset()
+        { this->m_interval = this->m_floor; }
+
+    /// @brief account for a Status image read from the device.
+    void update(StatusBits status)
+        {
+        std::uint32_t const nAvail = status.getInputAvail();
+
+        if (nAvail == 0)
+            {
+            // idle: stretch gently.
+            this->m_interval = clamp(
+                this->m_interval + this->m_interval / 4 + 1,
+                this->m_floor,
+                this->m_ceiling
+                );
+            }
+        else
+            {
+            // traffic: shrink by half, or straight to the floor if the
+            // device's queue is already half full.
+            if (nAvail >= kBurstThreshold)
+                this->m_interval = this->m_floor;
+            else
+                this->m_interval = clamp(this->m_interval / 2, this->m_floor, this->m_ceiling);
+            }
+        }
+
+private:
+    /// @brief RxAvail at or above this means we're behind: half the
+    ///     device's queue, or half a full RxData read. Waiting for a full
+    ///     one would leave no room for what arrives before the next poll.
+    static constexpr std::uint32_t kBurstThreshold = ModbusSerialProtocol::knRxDataReg;
+
+    static constexpr std::uint32_t clamp(std::uint32_t v, std::uint32_t lo, std::uint32_t hi)
+        {
+        return v < lo ? lo : v > hi ? hi : v;
+        }
+
+    std::uint32_t   m_floor = 0;
+    std::uint32_t   m_ceiling = 0;
+    std::uint32_t   m_interval = 0;
+    };
+
+} // namespace McciCatena
+
+#endif // _MCCI_Modbus_Serial_PollInterval_h_
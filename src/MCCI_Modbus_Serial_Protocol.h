@@ -19,9 +19,16 @@ Author:
 #ifndef _MCCI_Modbus_Serial_Protocol_h_
 # define _MCCI_Modbus_Serial_Protocol_h_
 
+#include <cstddef>
 #include <cstdint>
-#include <Stream.h>
-#include <ModbusRtuV2.h>
+
+// the protocol definitions are plain C++; only pull in the Arduino
+// framework when building for Arduino, so the host engine and the
+// simulated device can also be built and exercised on Linux.
+#if defined(ARDUINO)
+# include <Stream.h>
+# include <ModbusRtuV2.h>
+#endif
 
 namespace McciCatena {
 
@@ -251,6 +258,212 @@ public:
         std::uint16_t m_bits;
         }; // end class StatusBits
 
+    /// @brief convert between characters and RxData/TxData register values.
+    ///
+    /// Each register carries two characters, the first in the high byte,
+    /// so a run of registers is the big-endian image of the characters.
+    /// An odd final character goes in the high byte of a register of its
+    /// own, with zero below it; on writes, that register is TxDataByte.
+    /// On a little-endian machine this swaps each pair of bytes, 16 bytes
+    /// at a time where the compiler has SSE2 or NEON.
+    class RegisterImage
+        {
+    public:
+        /// @brief pack nBytes characters from pBuf into registers at
+        ///     pRegs; return the number of registers, (nBytes + 1) / 2.
+        static std::size_t pack(std::uint16_t *pRegs, const std::uint8_t *pBuf, std::size_t nBytes);
+
+        /// @brief unpack nBytes characters from registers at pRegs into
+        ///     pBuf. If nBytes is odd, the low byte of the last register
+        ///     is ignored.
+        static void unpack(std::uint8_t *pBuf, const std::uint16_t *pRegs, std::size_t nBytes);
+        }; // end class RegisterImage
+
+    /// @brief local accounting of free space in the device's output queue.
+    ///
+    /// Each Status image gives an exact TxAvail. Between images, writes
+    /// use up credit, and the device's UART returns credit as it sends
+    /// characters at the rate set in Baudrate_i32. Predicted credit is
+    /// conservative, so back-to-back writes can go out without re-reading
+    /// Status first:
+    ///
+    /// - characters are assumed to take kBitsPerChar bit times, the
+    ///   longest common UART framing.
+    /// - the queue's capacity is learned from a Status image with TxEmpty
+    ///   set; until then, we can't tell how much of the queue is in use.
+    /// - nothing drains while the device reports it isn't connected.
+    /// - the prediction is only used once a Status image has confirmed
+    ///   that the device drained at least as fast as predicted. It is
+    ///   dropped again if an image shows the device falling behind, or
+    ///   shows a full queue after a write that relied on predicted
+    ///   credit. Either means the UART isn't keeping up (flow control,
+    ///   perhaps).
+    ///
+    /// Without the prediction, credit is just the last TxAvail less what
+    /// has been written since.
+    class TxCredit
+        {
+    public:
+        /// @brief bits per character assumed when predicting drain: start,
+        ///     8 data, parity, and 2 stop bits.
+        static constexpr std::uint32_t kBitsPerChar = 12;
+
+        /// @brief forget everything known about the device.
+        void reset()
+            {
+            this->m_nAvail = 0;
+            this->m_nQueued = 0;
+            this->m_nFloor = 0;
+            this->m_nCapacity = 0;
+            this->m_fTrusted = false;
+            this->m_fOverdrawn = false;
+            this->m_fValid = false;
+            }
+
+        /// @brief set the device's UART baud rate; zero means unknown,
+        ///     which disables prediction.
+        void setBaudrate(std::uint32_t baudrate)
+            { this->m_baudrate = baudrate; }
+
+        /// @brief true if a Status image has been seen since reset().
+        bool isValid() const
+            { return this->m_fValid; }
+
+        /// @brief true if the drain prediction is being used.
+        bool isTrusted() const
+            { return this->m_fTrusted; }
+
+        /// @brief resynchronize from a Status image.
+        /// @param tSent is when the request was sent; the device can't
+        ///     have sampled Status before then.
+        /// @param now is when the response arrived.
+        void update(StatusBits status, std::uint32_t tSent, std::uint32_t now)
+            {
+            std::uint16_t const nAvail = status.getTxAvail();
+
+            if (this->m_fValid)
+                {
+                std::uint16_t const nPredicted = this->m_nAvail + this->getDrained(tSent);
+
+                if (nAvail < nPredicted || (nAvail == 0 && this->m_fOverdrawn))
+                    this->m_fTrusted = false;
+                else if (nPredicted > this->m_nFloor)
+                    this->m_fTrusted = true;
+                }
+
+            if (status.isTxEmpty() && nAvail > this->m_nCapacity)
+                this->m_nCapacity = nAvail;
+
+            this->m_nAvail = nAvail;
+            this->m_nFloor = nAvail;
+            this->m_nQueued = this->m_nCapacity > nAvail ? this->m_nCapacity - nAvail : 0;
+            this->m_fDraining = status.isConnected();
+            this->m_fOverdrawn = false;
+            this->m_tDrain = now;
+            this->m_fValid = true;
+            }
+
+        /// @brief account for nSent characters written at time now.
+        void consume(std::uint16_t nSent, std::uint32_t now)
+            {
+            this->settle(now);
+
+            if (nSent > this->m_nFloor)
+                this->m_fOverdrawn = true;
+
+            this->m_nFloor = subtract(this->m_nFloor, nSent);
+            this->m_nAvail = subtract(this->m_nAvail, nSent);
+            if (this->m_nCapacity != 0)
+                this->m_nQueued += nSent;
+            }
+
+        /// @brief return the number of characters that can be written at
+        ///     time now without overflowing the device's queue.
+        std::uint16_t getTxAvail(std::uint32_t now) const
+            {
+            if (! this->m_fTrusted)
+                return this->m_nFloor;
+
+            return this->m_nAvail + this->getDrained(now);
+            }
+
+        /// @brief true if credit will come back without a Status read.
+        bool isDraining() const
+            { return this->m_fTrusted && this->canDrain(); }
+
+        /// @brief return the longest wait, in microseconds, for the
+        ///     prediction to free another character: one character time.
+        ///     UINT32_MAX if ! isDraining().
+        std::uint32_t getDrainDelay() const
+            {
+            if (! this->isDraining())
+                return UINT32_MAX;
+
+            return (kBitsPerChar * 1000000u + this->m_baudrate - 1) / this->m_baudrate;
+            }
+
+    private:
+        static constexpr std::uint16_t subtract(std::uint16_t a, std::uint16_t b)
+            { return b < a ? a - b : 0; }
+
+        bool canDrain() const
+            {
+            return this->m_fDraining && this->m_baudrate != 0 && this->m_nQueued != 0;
+            }
+
+        /// @brief return characters predicted to have left the queue since
+        ///     m_tDrain.
+        std::uint16_t getDrained(std::uint32_t now) const
+            {
+            if (! this->canDrain() || std::int32_t(now - this->m_tDrain) <= 0)
+                return 0;
+
+            std::uint64_t const nChars =
+                (std::uint64_t(now - this->m_tDrain) * this->m_baudrate)
+                    / (kBitsPerChar * 1000000u);
+
+            return nChars < this->m_nQueued ? std::uint16_t(nChars) : this->m_nQueued;
+            }
+
+        /// @brief fold the characters drained by now into the prediction.
+        ///     Time is only advanced by whole characters, so none is lost.
+        void settle(std::uint32_t now)
+            {
+            auto const nDrained = this->getDrained(now);
+
+            if (nDrained == this->m_nQueued || ! this->canDrain())
+                this->m_tDrain = now;
+            else
+                this->m_tDrain += std::uint32_t(
+                    (std::uint64_t(nDrained) * kBitsPerChar * 1000000u) / this->m_baudrate
+                    );
+
+            this->m_nAvail += nDrained;
+            this->m_nQueued -= nDrained;
+            }
+
+        std::uint32_t   m_baudrate = 0;
+        /// @brief time from which m_nQueued is draining.
+        std::uint32_t   m_tDrain = 0;
+        /// @brief predicted free slots as of m_tDrain.
+        std::uint16_t   m_nAvail = 0;
+        /// @brief predicted characters queued as of m_tDrain, if the
+        ///     capacity is known.
+        std::uint16_t   m_nQueued = 0;
+        /// @brief last TxAvail less what's been written since.
+        std::uint16_t   m_nFloor = 0;
+        /// @brief queue size, learned from TxEmpty; zero if not yet known.
+        std::uint16_t   m_nCapacity = 0;
+        /// @brief true if the device reported that it's connected.
+        bool            m_fDraining = false;
+        /// @brief true if Status has confirmed the prediction.
+        bool            m_fTrusted = false;
+        /// @brief true if a write since the last Status relied on
+        ///     predicted credit.
+        bool            m_fOverdrawn = false;
+        bool            m_fValid = false;
+        }; // end class TxCredit
+
     };
 
 } // namespace McciCatena
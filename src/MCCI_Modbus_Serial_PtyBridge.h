@@ -0,0 +1,112 @@
+/*
+
+Module:  MCCI_Modbus_Serial_PtyBridge.h
+
+Function:
+    Pseudo-terminals for remote virtual UARTs on Linux.
+
+Copyright notice and License:
+    See LICENSE file accompanying this project.
+
+Author:
+    MCCI Corporation   October 2026
+
+*/
+
+#pragma once
+
+#ifndef _MCCI_Modbus_Serial_PtyBridge_h_
+# define _MCCI_Modbus_Serial_PtyBridge_h_
+
+#include "MCCI_Modbus_Serial_FdPump.h"
+#include "MCCI_Modbus_Serial_ThreadControl.h"
+
+#if defined(__linux__) && ! defined(ARDUINO)
+
+#include <atomic>
+#include <thread>
+
+namespace McciCatena {
+
+/// @brief give each remote device's UART a local pseudo-terminal, so
+///     ordinary tools (minicom, ser2net, pppd) can use it.
+///
+/// add() creates a pty for a ModbusSerialThreadedClient whose host runs
+/// in a ModbusSerialBusWorker or ModbusSerialBusExecutor; getPath()
+/// returns the name of its slave side, and a symlink with a stable name
+/// can be made too. Then begin() starts a thread that moves bytes
+/// between each pty master and its client's buffers, reading and
+/// writing straight into and out of them, with no copy in between.
+///
+/// Flow control comes from the buffers. When a device has no TxAvail,
+/// its host stops taking output, the client's transmit buffer fills,
+/// the bridge stops reading the pty, and the tool's writes block. The
+/// other way, if nothing reads the slave, the bridge stops writing, the
+/// client's receive buffer fills, and the host reads less from the
+/// device. The bridge keeps each slave open itself, so the pty survives
+/// tools opening and closing it; output written while no tool has it
+/// open waits in the pty.
+class ModbusSerialPtyBridge
+    {
+public:
+    using Client = ModbusSerialThreadedClientBase;
+
+    static constexpr std::size_t knMaxPtys = 256;
+
+    ModbusSerialPtyBridge() = default;
+    ModbusSerialPtyBridge(const ModbusSerialPtyBridge &) = delete;
+    ModbusSerialPtyBridge &operator=(const ModbusSerialPtyBridge &) = delete;
+
+    /// @brief stop, close the ptys and remove their symlinks.
+    ~ModbusSerialPtyBridge();
+
+    /// @brief create a raw-mode pty for client. If pLink isn't null, also
+    ///     make it a symlink to the slave (replacing any symlink already
+    ///     there). Only before begin().
+    bool add(Client &client, const char *pLink = nullptr);
+
+    /// @brief return the path of client's pty slave, or nullptr.
+    const char *getPath(const Client &client) const;
+
+    /// @brief start the thread; if cpu isn't negative, pin it there.
+    bool begin(int cpu = -1);
+
+    /// @brief stop the thread and wait for it; the ptys stay open.
+    void end();
+
+    bool isRunning() const
+        { return this->m_thread.joinable(); }
+
+private:
+    static constexpr std::size_t knMaxPath = 64;
+
+    struct Entry
+        {
+        Client          *pClient = nullptr;
+        int             masterFd = -1;
+        int             slaveFd = -1;
+        ModbusSerialFdPump pump;
+        /// @brief the epoll events asked for on the master.
+        std::uint32_t   events = 0;
+        char            path[knMaxPath] {};
+        char            link[knMaxPath] {};
+        };
+
+    bool setup();
+    void teardown();
+    void run();
+    void pump(Entry &entry);
+    bool updateEvents(Entry &entry);
+
+    Entry           m_entries[knMaxPtys];
+    std::size_t     m_nEntries = 0;
+    std::thread     m_thread;
+    ModbusSerialThreadControl m_control;
+    int             m_epollFd = -1;
+    };
+
+} // namespace McciCatena
+
+#endif // defined(__linux__) && ! defined(ARDUINO)
+
+#endif // _MCCI_Modbus_Serial_PtyBridge_h_
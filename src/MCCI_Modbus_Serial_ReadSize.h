@@ -0,0 +1,161 @@
+/*
+
+Module:  MCCI_Modbus_Serial_ReadSize.h
+
+Function:
+    Sizes speculative Status+RxData reads from recent RxAvail values.
+
+Copyright notice and License:
+    See LICENSE file accompanying this project.
+
+Author:
+    MCCI Corporation   October 2026
+
+*/
+
+#pragma once
+
+#ifndef _MCCI_Modbus_Serial_ReadSize_h_
+# define _MCCI_Modbus_Serial_ReadSize_h_
+
+#include "MCCI_Modbus_Serial_Protocol.h"
+#include "MCCI_Modbus_Serial_Timing.h"
+
+namespace McciCatena {
+
+/// @brief choose how many RxData registers to read with Status when the
+///     amount of waiting input isn't known.
+///
+/// Each such read is a guess. If it's too short, the rest of the input
+/// costs another transaction. If it's too long, the extra registers come
+/// back as zeros. update() records the RxAvail reported by each guess,
+/// and the next guess is the register count that would have wasted the
+/// fewest bus bytes over the last knHistory guesses. Each zero register
+/// wastes 2 bytes. A short read costs a whole extra transaction: frame overhead,
+/// the inter-frame gaps, and the device's turnaround. The turnaround is
+/// a time, so its cost in bytes depends on the bus baud rate.
+class ModbusSerialReadSize
+    {
+public:
+    using StatusBits = ModbusSerialProtocol::StatusBits;
+
+    /// @brief number of RxAvail samples remembered.
+    static constexpr std::size_t knHistory = 8;
+
+    /// @brief default device turnaround, in microseconds.
+    static constexpr std::uint32_t kDefaultTurnaround = ModbusSerialTiming::kDefaultTurnaround;
+
+    ModbusSerialReadSize()
+        {
+        this->setBusTiming(0, kDefaultTurnaround);
+        }
+
+    /// @brief set the bus baud rate (zero if unknown) and the device's
+    ///     turnaround time in microseconds; these set the cost of an
+    ///     extra transaction.
+    void setBusTiming(std::uint32_t baudrate, std::uint32_t turnaround)
+        {
+        // request, response header and CRC, and a second copy of Status.
+        std::uint32_t nBytes = 8 + 5 + 2;
+        ModbusSerialTiming const timing(baudrate);
+
+        // then the t3.5 gaps before the response and the next request,
+        // and the turnaround, in character times; without a baud rate,
+        // just the gaps.
+        if (baudrate != 0)
+            nBytes += timing.getBytesInMicros(timing.getOverheadMicros(turnaround));
+        else
+            nBytes += 7;
+
+        this->m_nTxnBytes = nBytes;
+        this->choose();
+        }
+
+    /// @brief return the cost of an extra read transaction, in bytes.
+    std::uint32_t getTransactionBytes() const
+        { return this->m_nTxnBytes; }
+
+    /// @brief forget the history; used when a device (re)appears.
+    void reset()
+        {
+        this->m_nSamples = 0;
+        this->m_iNext = 0;
+        this->choose();
+        }
+
+    /// @brief return the number of RxData registers to read.
+    std::uint16_t getRegs() const
+        { return this->m_nRegs; }
+
+    /// @brief account for the Status image returned by a guessed read.
+    void update(StatusBits status)
+        {
+        this->m_samples[this->m_iNext] = std::uint8_t(status.getInputAvail());
+        if (++this->m_iNext == knHistory)
+            this->m_iNext = 0;
+        if (this->m_nSamples < knHistory)
+            ++this->m_nSamples;
+
+        this->choose();
+        }
+
+private:
+    /// @brief pick the register count with the lowest total cost over the
+    ///     history. Only counts that exactly fit some sample can be best.
+    void choose()
+        {
+        // with no history, read one register, as the README suggests.
+        std::uint16_t bestRegs = 1;
+        std::uint32_t bestCost = this->getCost(bestRegs);
+
+        for (std::size_t i = 0; i < this->m_nSamples; ++i)
+            {
+            std::uint16_t nRegs = StatusBits().setInputAvail(this->m_samples[i]).getRegsToReadForInput();
+
+            if (nRegs > ModbusSerialProtocol::knRxDataReg)
+                nRegs = ModbusSerialProtocol::knRxDataReg;
+            if (nRegs <= 1)
+                continue;
+
+            // on a tie, prefer the longer read; it has lower latency.
+            auto const cost = this->getCost(nRegs);
+            if (cost < bestCost || (cost == bestCost && nRegs > bestRegs))
+                {
+                bestRegs = nRegs;
+                bestCost = cost;
+                }
+            }
+
+        this->m_nRegs = bestRegs;
+        }
+
+    /// @brief bus bytes the history would have wasted reading nRegs each
+    ///     time. Registers that carry data would have been read anyway;
+    ///     only the zero-filled ones are waste.
+    std::uint32_t getCost(std::uint16_t nRegs) const
+        {
+        std::uint32_t cost = 0;
+
+        for (std::size_t i = 0; i < this->m_nSamples; ++i)
+            {
+            auto const nDataRegs = StatusBits().setInputAvail(this->m_samples[i]).getRegsToReadForInput();
+
+            if (nDataRegs > nRegs)
+                cost += this->m_nTxnBytes;
+            else
+                cost += 2u * (nRegs - nDataRegs);
+            }
+
+        return cost;
+        }
+
+    std::uint8_t    m_samples[knHistory];
+    std::size_t     m_nSamples = 0;
+    std::size_t     m_iNext = 0;
+    std::uint32_t   m_nTxnBytes = 0;
+    std::uint16_t   m_nRegs = 1;
+    };
+
+} // namespace McciCatena
+
+#endif // _MCCI_Modbus_Serial_ReadSize_h_
@@ -0,0 +1,274 @@
+/*
+
+Module:  MCCI_Modbus_Serial_Requester.h
+
+Function:
+    Completion-callback interface for Serial-over-Modbus transactions.
+
+Copyright notice and License:
+    See LICENSE file accompanying this project.
+
+Author:
+    MCCI Corporation   October 2026
+
+*/
+
+#pragma once
+
+#ifndef _MCCI_Modbus_Serial_Requester_h_
+# define _MCCI_Modbus_Serial_Requester_h_
+
+#include "MCCI_Modbus_Serial_Transport.h"
+
+namespace McciCatena {
+
+class ModbusSerialRequester;
+
+/// @brief one read of Status and RxData, or one write of TxData.
+///
+/// Requests are set up with setReadInput() or setWriteTx(), and handed
+/// to ModbusSerialRequester::submit(), which calls back when the
+/// transaction is done. Each request carries its own transaction and
+/// data buffer, so nothing is allocated per transaction; requests are
+/// normally kept in a ModbusSerialRequestPool.
+class ModbusSerialRequest
+    {
+public:
+    using Protocol = ModbusSerialProtocol;
+    using Register = Protocol::Register;
+    using StatusBits = Protocol::StatusBits;
+    using Transaction = ModbusSerialTransaction;
+
+    /// @brief completion callback; called from ModbusSerialRequester::poll().
+    ///     The request may be freed or resubmitted from the callback.
+    typedef void CompletionFn(void *pCtx, ModbusSerialRequest &request);
+
+    enum class Kind : std::uint8_t
+        {
+        None,       ///< not set up.
+        ReadInput,  ///< read Status plus RxData.
+        WriteTx,    ///< write TxData, and read Status if possible.
+        };
+
+    /// @brief largest payload: a full RxData or TxData window.
+    static constexpr std::size_t knMaxData = 2 * Protocol::knRxDataReg;
+    static_assert(2 * Protocol::knTxDataReg <= knMaxData, "TX window doesn't fit");
+
+    ModbusSerialRequest() = default;
+    ModbusSerialRequest(const ModbusSerialRequest &) = delete;
+    ModbusSerialRequest &operator=(const ModbusSerialRequest &) = delete;
+
+    /// @brief set up a read of Status plus enough RxData registers for
+    ///     up to nMaxBytes of input (at most knMaxData).
+    void setReadInput(std::uint8_t unitId, std::size_t nMaxBytes);
+
+    /// @brief set up a read of Status plus the input that status says is
+    ///     waiting; with no status, just Status and one register.
+    void setReadInput(std::uint8_t unitId, StatusBits status)
+        {
+        auto const nRegs = status.getRegsToReadForInput();
+
+        this->setReadInput(unitId, nRegs != 0 ? 2u * nRegs : 2u);
+        }
+
+    /// @brief set up a write of as much of pBuf as fits in the space
+    ///     status reports in the device. Returns the number of bytes that
+    ///     will be written; if zero, there's nothing to submit.
+    std::size_t setWriteTx(std::uint8_t unitId, StatusBits status, const std::uint8_t *pBuf, std::size_t nBuf);
+
+    Kind getKind() const
+        { return this->m_kind; }
+
+    /// @brief true from submit() until just before the callback.
+    bool isBusy() const
+        { return this->m_fBusy; }
+
+    //---- results, valid in the callback ----
+
+    /// @brief return the transaction's final status.
+    Transaction::Status getResult() const
+        { return this->m_txn.status; }
+
+    bool isSuccess() const
+        { return this->m_txn.isSuccess(); }
+
+    /// @brief return the Modbus exception code, if getResult() is Exception.
+    std::uint8_t getExceptionCode() const
+        { return this->m_txn.exceptionCode; }
+
+    /// @brief true if getStatus() holds a Status image from the device;
+    ///     a write sent with 0x10 doesn't return one.
+    bool hasStatus() const
+        { return this->isSuccess() && this->m_txn.nRead != 0; }
+
+    /// @brief return the device's Status register, read after any write.
+    StatusBits getStatus() const
+        { return StatusBits(this->hasStatus() ? this->m_txn.readRegs[0] : 0); }
+
+    /// @brief return the payload: the input read, or the output written.
+    const std::uint8_t *getData() const
+        { return this->m_data; }
+
+    /// @brief return the number of payload bytes. For reads, this is
+    ///     only the bytes the device reported as valid.
+    std::size_t getDataSize() const
+        { return this->m_nData; }
+
+private:
+    friend class ModbusSerialRequester;
+    friend class ModbusSerialRequestPool;
+
+    void decode();
+
+    Transaction         m_txn;
+    ModbusSerialRequest *m_pNext = nullptr;
+    CompletionFn        *m_pDoneFn = nullptr;
+    void                *m_pDoneCtx = nullptr;
+    std::uint16_t       m_nData = 0;
+    Kind                m_kind = Kind::None;
+    bool                m_fBusy = false;
+    std::uint8_t        m_data[knMaxData];
+    };
+
+/// @brief a free list of requests, in storage provided by the caller.
+///
+/// The pool never allocates; allocate() returns nullptr when it runs
+/// out. Not thread-safe.
+class ModbusSerialRequestPool
+    {
+public:
+    using Request = ModbusSerialRequest;
+
+    ModbusSerialRequestPool(Request *pRequests, std::size_t nRequests)
+        {
+        for (std::size_t i = nRequests; i != 0; --i)
+            this->free(pRequests[i - 1]);
+        }
+
+    ModbusSerialRequestPool(const ModbusSerialRequestPool &) = delete;
+    ModbusSerialRequestPool &operator=(const ModbusSerialRequestPool &) = delete;
+
+    /// @brief take a request from the pool; nullptr if none are left.
+    Request *allocate()
+        {
+        Request * const pRequest = this->m_pFree;
+
+        if (pRequest != nullptr)
+            {
+            this->m_pFree = pRequest->m_pNext;
+            pRequest->m_pNext = nullptr;
+            pRequest->m_kind = Request::Kind::None;
+            --this->m_nFree;
+            }
+        return pRequest;
+        }
+
+    /// @brief return a request that isn't busy to the pool.
+    void free(Request &request)
+        {
+        request.m_pNext = this->m_pFree;
+        this->m_pFree = &request;
+        ++this->m_nFree;
+        }
+
+    std::size_t getFreeCount() const
+        { return this->m_nFree; }
+
+private:
+    Request         *m_pFree = nullptr;
+    std::size_t     m_nFree = 0;
+    };
+
+/// @brief runs requests on a transport and calls back when they finish.
+///
+/// This is a lower-level alternative to ModbusSerialHost for
+/// applications that drive many virtual UARTs from their own state
+/// machines: there's no FSM, no polling timer and no buffering, just
+/// transactions. The requester owns the transport; don't share it with
+/// hosts. Requests go out in the order submitted, as fast as the
+/// transport will take them.
+///
+/// Writes read Status in the same exchange (0x17) if the transport
+/// carries it. If a device answers that with an Illegal Function
+/// exception, the write is retried with 0x10, and later writes to that
+/// unit use 0x10; other units keep using 0x17.
+class ModbusSerialRequester
+    {
+public:
+    using Request = ModbusSerialRequest;
+    using Transport = ModbusSerialTransport;
+    using Transaction = ModbusSerialTransaction;
+
+    ModbusSerialRequester(Transport &transport)
+        : m_transport(transport)
+        , m_timing(transport.getBusBaudrate())
+        , m_fReadWrite(transport.isFunctionSupported(Transaction::Function::ReadWriteMultipleRegisters))
+        {}
+
+    ModbusSerialRequester(const ModbusSerialRequester &) = delete;
+    ModbusSerialRequester &operator=(const ModbusSerialRequester &) = delete;
+
+    /// @brief queue a request that has been set up; pFn(pCtx, request) is
+    ///     called from poll() when it's done. Fails if the request is
+    ///     busy or not set up.
+    bool submit(Request &request, Request::CompletionFn *pFn, void *pCtx);
+
+    /// @brief withdraw a request that hasn't gone to the transport yet.
+    ///     Its callback isn't called.
+    bool cancel(Request &request);
+
+    /// @brief advance the transport, deliver completions, and start
+    ///     queued requests. Never blocks.
+    void poll();
+
+    /// @brief use 0x17 for writes, or not. Either way, forget which
+    ///     units have refused it, so they're asked again.
+    void setReadWriteEnabled(bool fEnabled)
+        {
+        this->m_fReadWrite = fEnabled &&
+            this->m_transport.isFunctionSupported(Transaction::Function::ReadWriteMultipleRegisters);
+        for (auto &w : this->m_readWriteRefused)
+            w = 0;
+        }
+
+    /// @brief true if writes to unitId go with 0x17.
+    bool isReadWriteEnabled(std::uint8_t unitId) const
+        {
+        return this->m_fReadWrite &&
+               (this->m_readWriteRefused[unitId / 32] & (std::uint32_t(1) << (unitId % 32))) == 0;
+        }
+
+    /// @brief set how long a device may take to start answering; see
+    ///     ModbusSerialHost::setTurnaroundLimit().
+    void setTurnaroundLimit(std::uint32_t us)
+        { this->m_turnaroundLimit = us; }
+
+    /// @brief return the number of requests submitted and not yet
+    ///     called back.
+    std::size_t getBusyCount() const
+        { return this->m_nBusy; }
+
+    Transport &getTransport() const
+        { return this->m_transport; }
+
+private:
+    void startQueued();
+    void prepare(Request &request);
+
+    Transport       &m_transport;
+    ModbusSerialTiming m_timing;
+    std::uint32_t   m_turnaroundLimit = ModbusSerialTiming::kDefaultTurnaroundLimit;
+    /// @brief queued requests, oldest first.
+    Request         *m_pQueueHead = nullptr;
+    Request         *m_pQueueTail = nullptr;
+    /// @brief requests the transport has.
+    Request         *m_pActive = nullptr;
+    std::size_t     m_nBusy = 0;
+    /// @brief units that answered 0x17 with Illegal Function, a bit each.
+    std::uint32_t   m_readWriteRefused[256 / 32] = {};
+    bool            m_fReadWrite;
+    };
+
+} // namespace McciCatena
+
+#endif // _MCCI_Modbus_Serial_Requester_h_
@@ -0,0 +1,189 @@
+/*
+
+Module:  MCCI_Modbus_Serial_RingBuffer.h
+
+Function:
+    Fixed-size byte queue used for the virtual UART buffers.
+
+Copyright notice and License:
+    See LICENSE file accompanying this project.
+
+Author:
+    MCCI Corporation   October 2026
+
+*/
+
+#pragma once
+
+#ifndef _MCCI_Modbus_Serial_RingBuffer_h_
+# define _MCCI_Modbus_Serial_RingBuffer_h_
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace McciCatena {
+
+/// @brief a fixed-size byte FIFO, with no dynamic allocation.
+///
+/// @tparam a_nBytes is the capacity in bytes.
+///
+/// The buffer is not thread-safe; it's intended to be used from a
+/// single polling loop.
+template <std::size_t a_nBytes>
+class ModbusSerialRingBuffer
+    {
+public:
+    static constexpr std::size_t kCapacity = a_nBytes;
+    static_assert(kCapacity > 0, "ring buffer must have non-zero size");
+
+    ModbusSerialRingBuffer()
+        : m_head(0)
+        , m_count(0)
+        {}
+
+    /// @brief discard all contents.
+    void clear()
+        {
+        this->m_head = 0;
+        this->m_count = 0;
+        }
+
+    /// @brief return number of bytes in the buffer.
+    std::size_t available() const
+        { return this->m_count; }
+
+    /// @brief return number of free bytes in the buffer.
+    std::size_t space() const
+        { return kCapacity - this->m_count; }
+
+    bool isEmpty() const
+        { return this->m_count == 0; }
+
+    bool isFull() const
+        { return this->m_count == kCapacity; }
+
+    /// @brief append one byte; return false if full.
+    bool put(std::uint8_t c)
+        {
+        if (this->isFull())
+            return false;
+
+        this->m_buf[this->wrap(this->m_head + this->m_count)] = c;
+        ++this->m_count;
+        return true;
+        }
+
+    /// @brief append up to n bytes; return number appended.
+    std::size_t put(const std::uint8_t *pBuf, std::size_t n)
+        {
+        if (n > this->space())
+            n = this->space();
+
+        // copy in at most two runs, split at the end of the storage.
+        std::size_t const iTail = this->wrap(this->m_head + this->m_count);
+        std::size_t const nFirst = minSize(n, kCapacity - iTail);
+
+        copy(&this->m_buf[iTail], pBuf, nFirst);
+        copy(&this->m_buf[0], pBuf + nFirst, n - nFirst);
+
+        this->m_count += n;
+        return n;
+        }
+
+    /// @brief remove one byte; return -1 if empty.
+    int get()
+        {
+        if (this->isEmpty())
+            return -1;
+
+        std::uint8_t const c = this->m_buf[this->m_head];
+        this->discard(1);
+        return c;
+        }
+
+    /// @brief return the first byte without removing it; -1 if empty.
+    int peek() const
+        {
+        if (this->isEmpty())
+            return -1;
+
+        return this->m_buf[this->m_head];
+        }
+
+    /// @brief copy up to n bytes, starting iOffset bytes from the front,
+    ///     without removing them. Returns number of bytes copied.
+    std::size_t peek(std::uint8_t *pBuf, std::size_t n, std::size_t iOffset = 0) const
+        {
+        if (iOffset >= this->m_count)
+            return 0;
+        if (n > this->m_count - iOffset)
+            n = this->m_count - iOffset;
+
+        std::size_t const iFirst = this->wrap(this->m_head + iOffset);
+        std::size_t const nFirst = minSize(n, kCapacity - iFirst);
+
+        copy(pBuf, &this->m_buf[iFirst], nFirst);
+        copy(pBuf + nFirst, &this->m_buf[0], n - nFirst);
+        return n;
+        }
+
+    /// @brief return a pointer to the bytes starting iOffset bytes from
+    ///     the front, and set n to how many of them are contiguous in
+    ///     storage; nullptr and zero if there are none. Taking the run at
+    ///     offset 0 and then at the first run's size gives all the data
+    ///     in at most two pieces, without copying it.
+    const std::uint8_t *peekRun(std::size_t &n, std::size_t iOffset = 0) const
+        {
+        if (iOffset >= this->m_count)
+            {
+            n = 0;
+            return nullptr;
+            }
+
+        std::size_t const iFirst = this->wrap(this->m_head + iOffset);
+
+        n = minSize(this->m_count - iOffset, kCapacity - iFirst);
+        return &this->m_buf[iFirst];
+        }
+
+    /// @brief remove up to n bytes; return number removed.
+    std::size_t get(std::uint8_t *pBuf, std::size_t n)
+        {
+        n = this->peek(pBuf, n);
+        this->discard(n);
+        return n;
+        }
+
+    /// @brief drop up to n bytes from the front; return number dropped.
+    std::size_t discard(std::size_t n)
+        {
+        if (n > this->m_count)
+            n = this->m_count;
+
+        this->m_head = this->wrap(this->m_head + n);
+        this->m_count -= n;
+        return n;
+        }
+
+private:
+    static constexpr std::size_t minSize(std::size_t a, std::size_t b)
+        { return a < b ? a : b; }
+
+    static constexpr std::size_t wrap(std::size_t i)
+        { return i >= kCapacity ? i - kCapacity : i; }
+
+    static void copy(std::uint8_t *pDest, const std::uint8_t *pSrc, std::size_t n)
+        {
+        if (n != 0)
+            std::memcpy(pDest, pSrc, n);
+        }
+
+    std::uint8_t    m_buf[kCapacity];
+    std::size_t     m_head;
+    std::size_t     m_count;
+    };
+
+} // namespace McciCatena
+
+#endif // _MCCI_Modbus_Serial_RingBuffer_h_
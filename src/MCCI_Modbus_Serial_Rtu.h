@@ -0,0 +1,99 @@
+/*
+
+Module:  MCCI_Modbus_Serial_Rtu.h
+
+Function:
+    Modbus RTU framing for ModbusSerialTransaction.
+
+Copyright notice and License:
+    See LICENSE file accompanying this project.
+
+Author:
+    MCCI Corporation   October 2026
+
+*/
+
+#pragma once
+
+#ifndef _MCCI_Modbus_Serial_Rtu_h_
+# define _MCCI_Modbus_Serial_Rtu_h_
+
+#include "MCCI_Modbus_Serial_Transport.h"
+
+namespace McciCatena {
+
+class ModbusSerialDevice;
+
+/// @brief encode and decode Modbus RTU frames.
+///
+/// A frame is the unit ID, the PDU, and a CRC-16 (low byte first). The
+/// client side turns a ModbusSerialTransaction into a request frame and
+/// a response frame back into the transaction; the server side runs a
+/// request against a ModbusSerialDevice. Neither side does any I/O or
+/// timing; see ModbusSerialTiming for the gaps.
+class ModbusSerialRtu
+    {
+public:
+    using Transaction = ModbusSerialTransaction;
+
+    /// @brief largest frame allowed by the Modbus serial line spec.
+    static constexpr std::size_t knMaxFrameBytes = 256;
+
+    /// @brief smallest valid frame: unit ID, function, exception code and CRC.
+    static constexpr std::size_t knMinFrameBytes = 5;
+
+    /// @brief return the Modbus CRC-16 of nBytes at pBuf.
+    static std::uint16_t getCrc(const std::uint8_t *pBuf, std::size_t nBytes);
+
+    //---- client side ----
+
+    /// @brief encode the request frame for t into pBuf (at least
+    ///     knMaxFrameBytes); return its size.
+    static std::size_t encodeRequest(std::uint8_t *pBuf, const Transaction &t);
+
+    /// @brief encode a request frame to unit unitId into pBuf (at least
+    ///     knMaxFrameBytes) that writes data to TxData, straight from the
+    ///     caller's bytes; see ModbusSerialPdu::encodeTxWrite(). Sets
+    ///     nSent, and returns the frame size; zero if nothing fits.
+    static std::size_t encodeTxWrite(
+        std::uint8_t *pBuf,
+        std::size_t &nSent,
+        std::uint8_t unitId,
+        ModbusSerialProtocol::StatusBits status,
+        const std::uint8_t *pData, std::size_t nData,
+        const std::uint8_t *pWrap = nullptr, std::size_t nWrap = 0
+        );
+
+    /// @brief return the size the response to t will have, given the
+    ///     first nBuf bytes of it; zero until that's known.
+    static std::size_t getResponseSize(const std::uint8_t *pBuf, std::size_t nBuf, const Transaction &t);
+
+    /// @brief check the response frame and decode it into t, setting
+    ///     t.status. Bad CRC, unit ID or length are errors.
+    static void decodeResponse(const std::uint8_t *pFrame, std::size_t nFrame, Transaction &t);
+
+    //---- server side ----
+
+    /// @brief return the size of the request frame at the front of pBuf:
+    ///     zero if more bytes are needed, or SIZE_MAX if the function isn't
+    ///     one we know, so the frame only ends at the next silent interval.
+    static std::size_t getRequestSize(const std::uint8_t *pBuf, std::size_t nBuf);
+
+    /// @brief run the request frame against device, and encode the
+    ///     response frame into pResponse (at least knMaxFrameBytes).
+    ///     Returns the response size, or zero if the frame is corrupt and
+    ///     mustn't be answered.
+    static std::size_t serveRequest(
+        const std::uint8_t *pFrame, std::size_t nFrame,
+        ModbusSerialDevice &device,
+        std::uint8_t *pResponse
+        );
+
+private:
+    static std::size_t putCrc(std::uint8_t *pBuf, std::size_t nBytes);
+    static bool checkCrc(const std::uint8_t *pFrame, std::size_t nFrame);
+    };
+
+} // namespace McciCatena
+
+#endif // _MCCI_Modbus_Serial_Rtu_h_
@@ -0,0 +1,164 @@
+/*
+
+Module:  MCCI_Modbus_Serial_RtuTransport.h
+
+Function:
+    Adapts a ModbusRtuV2 master to the ModbusSerialTransport interface.
+
+Copyright notice and License:
+    See LICENSE file accompanying this project.
+
+Author:
+    MCCI Corporation   October 2026
+
+*/
+
+#pragma once
+
+#ifndef _MCCI_Modbus_Serial_RtuTransport_h_
+# define _MCCI_Modbus_Serial_RtuTransport_h_
+
+#include "MCCI_Modbus_Serial_Transport.h"
+
+#if defined(ARDUINO)
+
+namespace McciCatena {
+
+/// @brief ModbusSerialTransport on top of a ModbusRtuV2 master.
+///
+/// @tparam TModbus is the ModbusRtuV2 master class. It must provide
+///     `query(modbus_t)`, `poll()`, `getState()`, `getErrCnt()` and
+///     `setTimeOut(uint16_t)`.
+///
+/// The master must already have been started (`begin()`, etc.) by the
+/// caller. Only one transaction is outstanding at a time; the master
+/// handles the RTU framing, CRC and inter-frame gaps. If the transaction
+/// carries a response timeout, it replaces the master's timeout for
+/// that query.
+template <class TModbus>
+class ModbusSerialRtuTransport : public ModbusSerialTransport
+    {
+public:
+    ModbusSerialRtuTransport(TModbus &master, std::uint32_t busBaudrate)
+        : m_master(master)
+        , m_busBaudrate(busBaudrate)
+        , m_pActive(nullptr)
+        , m_errCnt(0)
+        {}
+
+    virtual bool isReady() const override
+        {
+        return this->m_pActive == nullptr;
+        }
+
+    virtual bool submit(Transaction &t) override
+        {
+        if (this->m_pActive != nullptr)
+            return false;
+
+        modbus_t datagram;
+
+        datagram.u8id = t.unitId;
+        datagram.u8fct = std::uint8_t(t.function);
+        switch (t.function)
+            {
+        case Transaction::Function::WriteMultipleRegisters:
+            datagram.u16RegAdd = t.writeAddress;
+            datagram.u16CoilsNo = t.nWrite;
+            datagram.au16reg = t.writeRegs;
+            break;
+
+        case Transaction::Function::ReadHoldingRegisters:
+        case Transaction::Function::ReadInputRegisters:
+            datagram.u16RegAdd = t.readAddress;
+            datagram.u16CoilsNo = t.nRead;
+            datagram.au16reg = t.readRegs;
+            break;
+
+        default:
+            // the RTU master doesn't implement anything else; report the
+            // same thing a device would.
+            t.status = Transaction::Status::Exception;
+            t.exceptionCode = Transaction::kExceptionIllegalFunction;
+            return true;
+            }
+
+        // the master times the whole query, in milliseconds.
+        if (t.responseTimeout != 0)
+            {
+            auto const timeout = Transaction::getFrameMicros(t.getRequestBytes(), this->m_busBaudrate)
+                               + t.responseTimeout;
+
+            this->m_master.setTimeOut(std::uint16_t((timeout + 999) / 1000));
+            }
+
+        this->m_errCnt = this->m_master.getErrCnt();
+        if (this->m_master.query(datagram) < 0)
+            {
+            t.status = Transaction::Status::Error;
+            return true;
+            }
+
+        t.status = Transaction::Status::Pending;
+        this->m_pActive = &t;
+        return true;
+        }
+
+    virtual void poll() override
+        {
+        if (this->m_pActive == nullptr)
+            return;
+
+        this->m_master.poll();
+        if (this->m_master.getState() != COM_IDLE)
+            return;
+
+        // the master counts every failure; if the count didn't change,
+        // the query succeeded.
+        auto const pT = this->m_pActive;
+        this->m_pActive = nullptr;
+
+        if (this->m_master.getErrCnt() == this->m_errCnt)
+            {
+            pT->status = Transaction::Status::Success;
+            return;
+            }
+
+        // the last error is NO_REPLY for timeouts, the exception code for
+        // device exceptions, and a negative ERR_ code for everything else.
+        auto const lastError = std::uint8_t(this->m_master.getLastError());
+
+        if (lastError == NO_REPLY)
+            pT->status = Transaction::Status::NoReply;
+        else if (lastError != 0 && lastError < 0x80)
+            {
+            pT->status = Transaction::Status::Exception;
+            pT->exceptionCode = lastError;
+            }
+        else
+            pT->status = Transaction::Status::Error;
+        }
+
+    virtual bool isFunctionSupported(Transaction::Function fn) const override
+        {
+        // ModbusRtuV2 has no Read/Write Multiple Registers.
+        return fn != Transaction::Function::ReadWriteMultipleRegisters;
+        }
+
+    virtual std::uint32_t getBusBaudrate() const override
+        {
+        return this->m_busBaudrate;
+        }
+
+private:
+    TModbus                 &m_master;
+    std::uint32_t           m_busBaudrate;
+    Transaction             *m_pActive;
+    std::uint16_t           m_errCnt;
+    };
+
+} // namespace McciCatena
+
+#endif // defined(ARDUINO)
+
+#endif // _MCCI_Modbus_Serial_RtuTransport_h_
@@ -0,0 +1,162 @@
+/*
+
+Module:  MCCI_Modbus_Serial_Scanner.h
+
+Function:
+    Find the devices on a bus that implement Serial over Modbus.
+
+Copyright notice and License:
+    See LICENSE file accompanying this project.
+
+Author:
+    MCCI Corporation   October 2026
+
+*/
+
+#pragma once
+
+#ifndef _MCCI_Modbus_Serial_Scanner_h_
+# define _MCCI_Modbus_Serial_Scanner_h_
+
+#include "MCCI_Modbus_Serial_Transport.h"
+
+namespace McciCatena {
+
+/// @brief scan a range of unit IDs for devices that speak this protocol.
+///
+/// Each unit is asked for DummyReg_i32 and, if that reads as zero, for
+/// Status_u16. A unit whose Status is plausible (RxAvail and TxAvail
+/// within the window, and TxAvail not zero if TxEmpty is set) is listed
+/// as found. A unit that answers otherwise, or with an exception, is
+/// some other kind of Modbus device.
+///
+/// Probes keep as many transactions in flight as the transport will
+/// take, up to setMaxInFlight(): one at a time on an RTU bus, and many
+/// on Modbus TCP. On a serial bus, each probe waits only the probe
+/// turnaround limit for an answer, plus its frames at the bus baud
+/// rate; elsewhere the transport's own timeout applies. Silent units
+/// are tried again, setTries() times in all, in case of noise.
+///
+/// The scanner needs the transport to itself. Call begin(), then poll()
+/// until isRunning() is false; getFound() then lists the units to give
+/// ModbusSerialHost objects on a ModbusSerialBus.
+class ModbusSerialScanner
+    {
+public:
+    using Protocol = ModbusSerialProtocol;
+    using Register = Protocol::Register;
+    using StatusBits = Protocol::StatusBits;
+    using Transaction = ModbusSerialTransaction;
+    using Transport = ModbusSerialTransport;
+
+    /// @brief what the scan learned about a unit.
+    enum class Result : std::uint8_t
+        {
+        NotScanned,     ///< outside the range, or not reached yet.
+        Absent,         ///< nothing answered.
+        Foreign,        ///< a Modbus device, but not one of ours.
+        Found,          ///< a Serial over Modbus device.
+        };
+
+    /// @brief most probes in flight at once.
+    static constexpr std::size_t knMaxInFlight = 16;
+
+    /// @brief the unit IDs a scan may cover; 0 is broadcast, and 248
+    ///     and up are reserved.
+    static constexpr std::uint8_t kMinUnitId = 1;
+    static constexpr std::uint8_t kMaxUnitId = 247;
+
+    /// @brief default number of tries for a silent unit.
+    static constexpr std::uint8_t kDefaultTries = 2;
+
+    ModbusSerialScanner(Transport &transport)
+        : m_transport(transport)
+        , m_timing(transport.getBusBaudrate())
+        {}
+
+    ModbusSerialScanner(const ModbusSerialScanner &) = delete;
+    ModbusSerialScanner &operator=(const ModbusSerialScanner &) = delete;
+
+    /// @brief start scanning units first through last, forgetting any
+    ///     earlier results. Fails if a scan is running.
+    bool begin(std::uint8_t first = kMinUnitId, std::uint8_t last = kMaxUnitId);
+
+    /// @brief advance the transport, check answers and send more probes.
+    ///     Never blocks.
+    void poll();
+
+    /// @brief true from begin() until every unit has been decided.
+    bool isRunning() const
+        { return this->m_nextUnit <= this->m_lastUnit || this->m_nActive != 0; }
+
+    /// @brief set how many probes may be in flight, at most
+    ///     knMaxInFlight. The transport may take fewer.
+    void setMaxInFlight(std::size_t nMax)
+        { this->m_nMaxInFlight = nMax == 0 ? 1 : nMax > knMaxInFlight ? knMaxInFlight : nMax; }
+
+    /// @brief set how long a device may take to start answering a
+    ///     probe; see ModbusSerialHost::setTurnaroundLimit().
+    void setTurnaroundLimit(std::uint32_t us)
+        { this->m_turnaroundLimit = us; }
+
+    /// @brief set how many times to try a unit that doesn't answer.
+    void setTries(std::uint8_t nTries)
+        { this->m_nTries = nTries != 0 ? nTries : 1; }
+
+    Result getResult(std::uint8_t unitId) const
+        { return this->m_units[unitId].result; }
+
+    /// @brief return the Status read from a unit that was found.
+    StatusBits getStatus(std::uint8_t unitId) const
+        { return StatusBits(this->m_units[unitId].status); }
+
+    /// @brief copy the IDs of the units found, lowest first, to pUnits,
+    ///     up to nUnits of them; return how many were found in all.
+    std::size_t getFound(std::uint8_t *pUnits, std::size_t nUnits) const;
+
+private:
+    /// @brief what each probe slot is doing.
+    enum class SlotState : std::uint8_t
+        {
+        Free,
+        Ready,          ///< set up, waiting for the transport.
+        Busy,           ///< submitted.
+        };
+
+    struct Slot
+        {
+        Transaction     txn;
+        SlotState       state = SlotState::Free;
+        std::uint8_t    nTries = 0;
+        };
+
+    struct Unit
+        {
+        std::uint16_t   status = 0;
+        Result          result = Result::NotScanned;
+        };
+
+    void complete(Slot &slot);
+    void retry(Slot &slot, Result result);
+    void finish(Slot &slot, Result result);
+    void startProbe(Slot &slot, std::uint8_t unitId, Register reg, std::uint16_t nRegs);
+    bool submit(Slot &slot);
+    static bool isValidStatus(StatusBits status);
+
+    Transport       &m_transport;
+    ModbusSerialTiming m_timing;
+    Slot            m_slots[knMaxInFlight];
+    Unit            m_units[256];
+    std::uint32_t   m_turnaroundLimit = ModbusSerialTiming::kDefaultProbeTurnaroundLimit;
+    std::size_t     m_nMaxInFlight = knMaxInFlight;
+    /// @brief slots not Free.
+    std::size_t     m_nActive = 0;
+    /// @brief the next unit to probe; past m_lastUnit when all have started.
+    std::uint16_t   m_nextUnit = 1;
+    std::uint16_t   m_lastUnit = 0;
+    std::uint8_t    m_nTries = kDefaultTries;
+    };
+
+} // namespace McciCatena
+
+#endif // _MCCI_Modbus_Serial_Scanner_h_
@@ -0,0 +1,115 @@
+/*
+
+Module:  MCCI_Modbus_Serial_SocketBridge.h
+
+Function:
+    TCP ports for remote virtual UARTs on Linux.
+
+Copyright notice and License:
+    See LICENSE file accompanying this project.
+
+Author:
+    MCCI Corporation   October 2026
+
+*/
+
+#pragma once
+
+#ifndef _MCCI_Modbus_Serial_SocketBridge_h_
+# define _MCCI_Modbus_Serial_SocketBridge_h_
+
+#include "MCCI_Modbus_Serial_FdPump.h"
+#include "MCCI_Modbus_Serial_ThreadControl.h"
+
+#if defined(__linux__) && ! defined(ARDUINO)
+
+#include <atomic>
+#include <thread>
+
+namespace McciCatena {
+
+/// @brief make each remote device's UART reachable as a raw TCP port,
+///     like ser2net's raw mode.
+///
+/// add() opens a listening socket for a ModbusSerialThreadedClient whose
+/// host runs in a ModbusSerialBusWorker or ModbusSerialBusExecutor. Then
+/// begin() starts a thread that serves every port from one epoll set.
+/// Each port takes one connection at a time; while one is open, others
+/// are accepted and closed at once. Bytes from the connection go into
+/// the client's transmit buffer, and on through the host's coalescing;
+/// received data is written from the client's buffer with writev(). In
+/// both directions the data is copied only by the kernel.
+///
+/// Flow control is the same as ModbusSerialPtyBridge's. When the device
+/// has no TxAvail, the bridge stops reading the socket, and TCP pushes
+/// back on the sender. When the socket's send buffer is full, received
+/// data backs up in the client, and the host's reads of that device
+/// shrink to what the client can take, down to bare Status polls. A
+/// quiet port, connected or not, costs nothing but its registrations.
+/// Received data that arrives with no connection waits for the next.
+class ModbusSerialSocketBridge
+    {
+public:
+    using Client = ModbusSerialThreadedClientBase;
+
+    static constexpr std::size_t knMaxPorts = 1024;
+
+    ModbusSerialSocketBridge() = default;
+    ModbusSerialSocketBridge(const ModbusSerialSocketBridge &) = delete;
+    ModbusSerialSocketBridge &operator=(const ModbusSerialSocketBridge &) = delete;
+
+    /// @brief stop, and close the listeners.
+    ~ModbusSerialSocketBridge();
+
+    /// @brief listen for connections to client on a TCP port. pAddr is a
+    ///     numeric IPv4 or IPv6 address, or nullptr for the loopback
+    ///     interface. Port 0 picks a free one; see getPort(). Only before
+    ///     begin().
+    bool add(Client &client, std::uint16_t port, const char *pAddr = nullptr);
+
+    /// @brief return the port client listens on, or 0.
+    std::uint16_t getPort(const Client &client) const;
+
+    /// @brief start the thread; if cpu isn't negative, pin it there.
+    bool begin(int cpu = -1);
+
+    /// @brief stop the thread and wait for it, and close any
+    ///     connections. The listeners stay open.
+    void end();
+
+    bool isRunning() const
+        { return this->m_thread.joinable(); }
+
+private:
+    struct Entry
+        {
+        Client          *pClient = nullptr;
+        int             listenFd = -1;
+        /// @brief the connection, or -1.
+        int             connFd = -1;
+        ModbusSerialFdPump pump;
+        /// @brief the epoll events asked for on the connection.
+        std::uint32_t   events = 0;
+        std::uint16_t   port = 0;
+        };
+
+    bool setup();
+    void teardown();
+    void run();
+    void accept(Entry &entry);
+    void pump(Entry &entry);
+    void disconnect(Entry &entry);
+    bool updateEvents(Entry &entry);
+
+    Entry           m_entries[knMaxPorts];
+    std::size_t     m_nEntries = 0;
+    std::thread     m_thread;
+    ModbusSerialThreadControl m_control;
+    int             m_epollFd = -1;
+    };
+
+} // namespace McciCatena
+
+#endif // defined(__linux__) && ! defined(ARDUINO)
+
+#endif // _MCCI_Modbus_Serial_SocketBridge_h_
@@ -0,0 +1,213 @@
+/*
+
+Module:  MCCI_Modbus_Serial_SpscRing.h
+
+Function:
+    Lock-free single-producer, single-consumer byte queue.
+
+Copyright notice and License:
+    See LICENSE file accompanying this project.
+
+Author:
+    MCCI Corporation   October 2026
+
+*/
+
+#pragma once
+
+#ifndef _MCCI_Modbus_Serial_SpscRing_h_
+# define _MCCI_Modbus_Serial_SpscRing_h_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace McciCatena {
+
+/// @brief a fixed-size byte FIFO that one thread fills and another
+///     drains, with no lock.
+///
+/// @tparam a_nBytes is the capacity in bytes, a power of two.
+///
+/// Like ModbusSerialRingBuffer, but the producer methods (put(),
+/// getSpace(), getFreeSpans(), commit(), getPutCount()) and the consumer
+/// methods (get(), peek(), getDataSpans(), discard(), getGetCount()) may
+/// run on different threads at once.
+/// available() may be called from either side. Each side owns one
+/// counter and only reads the other's, so there's no lock and no
+/// read-modify-write. The counters run freely and wrap; the index into
+/// the storage is the counter's low bits.
+template <std::size_t a_nBytes>
+class ModbusSerialSpscRing
+    {
+public:
+    static constexpr std::size_t kCapacity = a_nBytes;
+    static_assert(kCapacity > 0 && (kCapacity & (kCapacity - 1)) == 0, "ring size must be a power of two");
+
+    /// @brief keeps the two counters in separate cache lines.
+    static constexpr std::size_t knCacheLine = 64;
+
+    /// @brief a piece of the storage, for copying in or out directly.
+    struct Span
+        {
+        std::uint8_t    *pBuf;
+        std::size_t     nBuf;
+        };
+
+    ModbusSerialSpscRing() = default;
+    ModbusSerialSpscRing(const ModbusSerialSpscRing &) = delete;
+    ModbusSerialSpscRing &operator=(const ModbusSerialSpscRing &) = delete;
+
+    /// @brief return number of bytes in the ring.
+    std::size_t available() const
+        {
+        return this->m_nPut.load(std::memory_order_acquire) -
+               this->m_nGot.load(std::memory_order_acquire);
+        }
+
+    bool isEmpty() const
+        { return this->available() == 0; }
+
+    //---- producer side ----
+
+    /// @brief return number of bytes put() can take.
+    std::size_t getSpace() const
+        {
+        return kCapacity - (this->m_nPut.load(std::memory_order_relaxed) -
+                            this->m_nGot.load(std::memory_order_acquire));
+        }
+
+    /// @brief append up to n bytes; return number appended.
+    std::size_t put(const std::uint8_t *pBuf, std::size_t n)
+        {
+        std::size_t const nPut = this->m_nPut.load(std::memory_order_relaxed);
+        std::size_t const nSpace = kCapacity - (nPut - this->m_nGot.load(std::memory_order_acquire));
+
+        if (n > nSpace)
+            n = nSpace;
+
+        std::size_t const iTail = nPut & (kCapacity - 1);
+        std::size_t const nFirst = minSize(n, kCapacity - iTail);
+
+        copy(&this->m_buf[iTail], pBuf, nFirst);
+        copy(&this->m_buf[0], pBuf + nFirst, n - nFirst);
+
+        // publish the bytes before the count that covers them.
+        this->m_nPut.store(nPut + n, std::memory_order_release);
+        return n;
+        }
+
+    /// @brief describe the free space as up to two spans, so data can be
+    ///     read straight into it; then commit() what was filled. Returns
+    ///     the total size; spans[1] is empty unless the space wraps.
+    std::size_t getFreeSpans(Span (&spans)[2])
+        {
+        std::size_t const nPut = this->m_nPut.load(std::memory_order_relaxed);
+        std::size_t const nSpace = kCapacity - (nPut - this->m_nGot.load(std::memory_order_acquire));
+
+        return this->getSpans(nPut, nSpace, spans);
+        }
+
+    /// @brief append n bytes already copied into the spans from
+    ///     getFreeSpans().
+    void commit(std::size_t n)
+        {
+        this->m_nPut.store(this->m_nPut.load(std::memory_order_relaxed) + n, std::memory_order_release);
+        }
+
+    /// @brief return the number of bytes ever put.
+    std::size_t getPutCount() const
+        { return this->m_nPut.load(std::memory_order_relaxed); }
+
+    //---- consumer side ----
+
+    /// @brief copy up to n bytes, starting iOffset bytes from the front,
+    ///     without removing them. Returns number of bytes copied.
+    std::size_t peek(std::uint8_t *pBuf, std::size_t n, std::size_t iOffset = 0) const
+        {
+        std::size_t const nGot = this->m_nGot.load(std::memory_order_relaxed);
+        std::size_t const nAvail = this->m_nPut.load(std::memory_order_acquire) - nGot;
+
+        if (iOffset >= nAvail)
+            return 0;
+        if (n > nAvail - iOffset)
+            n = nAvail - iOffset;
+
+        std::size_t const iFirst = (nGot + iOffset) & (kCapacity - 1);
+        std::size_t const nFirst = minSize(n, kCapacity - iFirst);
+
+        copy(pBuf, &this->m_buf[iFirst], nFirst);
+        copy(pBuf + nFirst, &this->m_buf[0], n - nFirst);
+        return n;
+        }
+
+    /// @brief describe the bytes in the ring as up to two spans, so they
+    ///     can be copied out directly; then discard() what was used.
+    ///     Returns the total size.
+    std::size_t getDataSpans(Span (&spans)[2])
+        {
+        std::size_t const nGot = this->m_nGot.load(std::memory_order_relaxed);
+        std::size_t const nAvail = this->m_nPut.load(std::memory_order_acquire) - nGot;
+
+        return this->getSpans(nGot, nAvail, spans);
+        }
+
+    /// @brief drop up to n bytes from the front; return number dropped.
+    std::size_t discard(std::size_t n)
+        {
+        std::size_t const nGot = this->m_nGot.load(std::memory_order_relaxed);
+        std::size_t const nAvail = this->m_nPut.load(std::memory_order_acquire) - nGot;
+
+        if (n > nAvail)
+            n = nAvail;
+
+        // release: the producer mustn't reuse the space before we've
+        // finished copying out of it.
+        this->m_nGot.store(nGot + n, std::memory_order_release);
+        return n;
+        }
+
+    /// @brief remove up to n bytes; return number removed.
+    std::size_t get(std::uint8_t *pBuf, std::size_t n)
+        {
+        n = this->peek(pBuf, n);
+        this->discard(n);
+        return n;
+        }
+
+    /// @brief return the number of bytes ever removed.
+    std::size_t getGetCount() const
+        { return this->m_nGot.load(std::memory_order_relaxed); }
+
+private:
+    static constexpr std::size_t minSize(std::size_t a, std::size_t b)
+        { return a < b ? a : b; }
+
+    // split n bytes of storage starting at count into spans.
+    std::size_t getSpans(std::size_t count, std::size_t n, Span (&spans)[2])
+        {
+        std::size_t const i = count & (kCapacity - 1);
+        std::size_t const nFirst = minSize(n, kCapacity - i);
+
+        spans[0].pBuf = &this->m_buf[i];
+        spans[0].nBuf = nFirst;
+        spans[1].pBuf = &this->m_buf[0];
+        spans[1].nBuf = n - nFirst;
+        return n;
+        }
+
+    static void copy(std::uint8_t *pDest, const std::uint8_t *pSrc, std::size_t n)
+        {
+        if (n != 0)
+            std::memcpy(pDest, pSrc, n);
+        }
+
+    alignas(knCacheLine) std::atomic<std::size_t> m_nPut { 0 };
+    alignas(knCacheLine) std::atomic<std::size_t> m_nGot { 0 };
+    alignas(knCacheLine) std::uint8_t m_buf[kCapacity];
+    };
+
+} // namespace McciCatena
+
+#endif // _MCCI_Modbus_Serial_SpscRing_h_
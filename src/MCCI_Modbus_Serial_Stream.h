@@ -0,0 +1,83 @@
+/*
+
+Module:  MCCI_Modbus_Serial_Stream.h
+
+Function:
+    Arduino Stream interface to a remote Serial-over-Modbus UART.
+
+Copyright notice and License:
+    See LICENSE file accompanying this project.
+
+Author:
+    MCCI Corporation   October 2026
+
+*/
+
+#pragma once
+
+#ifndef _MCCI_Modbus_Serial_Stream_h_
+# define _MCCI_Modbus_Serial_Stream_h_
+
+#include "MCCI_Modbus_Serial_BufferedClient.h"
+
+#if defined(ARDUINO)
+
+namespace McciCatena {
+
+/// @brief a Stream whose other end is a remote virtual UART.
+///
+/// Pass the stream to ModbusSerialHost::begin() as the client, and call
+/// the host's poll() from loop(). Reads and writes only touch the local
+/// ring buffers, so they never wait for the bus: read() returns -1 if
+/// nothing has arrived, and write() returns a short count if the
+/// transmit buffer is full.
+template <std::size_t a_nTx = 256, std::size_t a_nRx = 256>
+class ModbusSerialStream : public Stream, public ModbusSerialBufferedClient<a_nTx, a_nRx>
+    {
+public:
+    virtual int available() override
+        { return int(this->m_rx.available()); }
+
+    virtual int read() override
+        { return this->m_rx.get(); }
+
+    virtual int peek() override
+        { return this->m_rx.peek(); }
+
+    virtual int availableForWrite() override
+        { return int(this->m_tx.space()); }
+
+    /// @brief Stream::flush() waits for output to drain, but we can't
+    ///     wait for the bus. Instead, this sends what's queued without
+    ///     waiting for the host's coalescing; use isTxEmpty() to watch
+    ///     for completion.
+    virtual void flush() override
+        { this->flushTx(); }
+
+    virtual std::size_t write(std::uint8_t c) override
+        { return this->m_tx.put(c) ? 1 : 0; }
+
+    /// @brief queue as much of the buffer as fits, in at most two copies.
+    virtual std::size_t write(const std::uint8_t *pBuf, std::size_t n) override
+        { return this->m_tx.put(pBuf, n); }
+
+    using Print::write;
+
+    /// @brief copy out as much received data as is on hand, in at most
+    ///     two copies. Unlike Stream::readBytes(), this doesn't wait for
+    ///     the stream timeout; it returns what's there.
+    ///
+    /// Stream::readBytes() isn't virtual in every core, so these hide
+    /// rather than override it.
+    std::size_t readBytes(char *pBuf, std::size_t n)
+        { return this->m_rx.get(reinterpret_cast<std::uint8_t *>(pBuf), n); }
+
+    std::size_t readBytes(std::uint8_t *pBuf, std::size_t n)
+        { return this->m_rx.get(pBuf, n); }
+    };
+
+} // namespace McciCatena
+
+#endif // defined(ARDUINO)
+
+#endif // _MCCI_Modbus_Serial_Stream_h_
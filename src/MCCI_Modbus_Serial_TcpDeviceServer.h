@@ -0,0 +1,133 @@
+/*
+
+Module:  MCCI_Modbus_Serial_TcpDeviceServer.h
+
+Function:
+    Modbus TCP gateway simulator serving ModbusSerialDevice objects.
+
+Copyright notice and License:
+    See LICENSE file accompanying this project.
+
+Author:
+    MCCI Corporation   October 2026
+
+*/
+
+#pragma once
+
+#ifndef _MCCI_Modbus_Serial_TcpDeviceServer_h_
+# define _MCCI_Modbus_Serial_TcpDeviceServer_h_
+
+#include "MCCI_Modbus_Serial_Mbap.h"
+#include "MCCI_Modbus_Serial_Device.h"
+
+#if defined(__linux__) && ! defined(ARDUINO)
+
+namespace McciCatena {
+
+/// @brief a Modbus TCP server that stands in for a gateway with
+///     simulated devices behind it, for testing ModbusSerialTcpTransport.
+///
+/// Requests are run against the attached ModbusSerialDevice as they
+/// arrive, and each response is sent after the response delay, so
+/// several can be in flight. A unit ID with no device gets the gateway
+/// exception "target device failed to respond". Call poll() often; it
+/// never blocks.
+class ModbusSerialTcpDeviceServer
+    {
+public:
+    using Device = ModbusSerialDevice;
+    using Mbap = ModbusSerialMbap;
+
+    static constexpr std::size_t knMaxDevices = 32;
+    static constexpr std::size_t knMaxClients = 4;
+    /// @brief responses each client may have waiting to be sent.
+    static constexpr std::size_t knMaxQueued = 16;
+
+    ModbusSerialTcpDeviceServer() = default;
+    ModbusSerialTcpDeviceServer(const ModbusSerialTcpDeviceServer &) = delete;
+    ModbusSerialTcpDeviceServer &operator=(const ModbusSerialTcpDeviceServer &) = delete;
+
+    ~ModbusSerialTcpDeviceServer()
+        { this->end(); }
+
+    /// @brief listen on the loopback interface; port zero picks a free
+    ///     port, which getPort() returns.
+    bool begin(std::uint16_t port = 0);
+
+    /// @brief close the listener and all connections.
+    void end();
+
+    std::uint16_t getPort() const
+        { return this->m_port; }
+
+    /// @brief attach a simulated device at a given unit ID, replacing any
+    ///     device already there.
+    bool attach(std::uint8_t unitId, Device &device);
+
+    /// @brief remove the device at unitId.
+    void detach(std::uint8_t unitId);
+
+    /// @brief set how long each response waits before it's sent, in
+    ///     microseconds.
+    void setResponseDelay(std::uint32_t us)
+        { this->m_responseDelay = us; }
+
+    /// @brief number of requests served so far.
+    std::uint32_t getRequestCount() const
+        { return this->m_nRequests; }
+
+    /// @brief most responses ever waiting at once on one connection.
+    std::size_t getMaxQueued() const
+        { return this->m_maxQueued; }
+
+    void poll();
+
+private:
+    struct Entry
+        {
+        std::uint8_t    unitId = 0;
+        Device          *pDevice = nullptr;
+        };
+
+    struct Response
+        {
+        std::uint32_t   tDue;
+        std::uint16_t   nBytes;
+        std::uint8_t    adu[Mbap::knMaxAduBytes];
+        };
+
+    struct Client
+        {
+        int             fd = -1;
+        std::size_t     nRx = 0;
+        std::uint8_t    rxBuf[2 * Mbap::knMaxAduBytes];
+        /// @brief queued responses, oldest first.
+        Response        queue[knMaxQueued];
+        std::size_t     iHead = 0;
+        std::size_t     nQueued = 0;
+        /// @brief bytes of the oldest response already sent.
+        std::size_t     nSent = 0;
+        };
+
+    Device *findDevice(std::uint8_t unitId) const;
+    void accept();
+    bool serviceClient(Client &client, std::uint32_t now);
+    bool receive(Client &client, std::uint32_t now);
+    bool send(Client &client, std::uint32_t now);
+    void close(Client &client);
+
+    Entry           m_devices[knMaxDevices];
+    Client          m_clients[knMaxClients];
+    std::uint32_t   m_responseDelay = 0;
+    std::uint32_t   m_nRequests = 0;
+    std::size_t     m_maxQueued = 0;
+    int             m_listenFd = -1;
+    std::uint16_t   m_port = 0;
+    };
+
+} // namespace McciCatena
+
+#endif // defined(__linux__) && ! defined(ARDUINO)
+
+#endif // _MCCI_Modbus_Serial_TcpDeviceServer_h_
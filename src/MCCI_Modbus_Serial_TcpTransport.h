@@ -0,0 +1,135 @@
+/*
+
+Module:  MCCI_Modbus_Serial_TcpTransport.h
+
+Function:
+    Pipelined Modbus TCP transport for Linux.
+
+Copyright notice and License:
+    See LICENSE file accompanying this project.
+
+Author:
+    MCCI Corporation   October 2026
+
+*/
+
+#pragma once
+
+#ifndef _MCCI_Modbus_Serial_TcpTransport_h_
+# define _MCCI_Modbus_Serial_TcpTransport_h_
+
+#include "MCCI_Modbus_Serial_Mbap.h"
+
+#if defined(__linux__) && ! defined(ARDUINO)
+
+#include <sys/socket.h>
+
+namespace McciCatena {
+
+/// @brief ModbusSerialTransport over a Modbus TCP connection.
+///
+/// Each transaction goes out as soon as it's submitted, with its own
+/// MBAP transaction ID, and up to knMaxPending can be waiting for
+/// responses at once. Responses are matched to transactions by ID, so
+/// they may come back in any order. On a ModbusSerialBus, this keeps
+/// requests for several units behind a gateway in flight together.
+///
+/// The socket is non-blocking, and nothing here waits. If the
+/// connection fails, every outstanding transaction fails with Error, and
+/// poll() reconnects after the reconnect interval. A transaction with no
+/// response timeout of its own uses the transport's.
+class ModbusSerialTcpTransport : public ModbusSerialTransport
+    {
+public:
+    using Mbap = ModbusSerialMbap;
+
+    /// @brief most transactions in flight at once.
+    static constexpr std::size_t knMaxPending = 16;
+
+    /// @brief default response timeout, in microseconds.
+    static constexpr std::uint32_t kDefaultResponseTimeout = 1000 * 1000;
+
+    /// @brief default delay before reconnecting, in microseconds.
+    static constexpr std::uint32_t kDefaultReconnectInterval = 1000 * 1000;
+
+    ModbusSerialTcpTransport() = default;
+    ModbusSerialTcpTransport(const ModbusSerialTcpTransport &) = delete;
+    ModbusSerialTcpTransport &operator=(const ModbusSerialTcpTransport &) = delete;
+
+    virtual ~ModbusSerialTcpTransport()
+        { this->end(); }
+
+    /// @brief start connecting to a gateway, given as a numeric IPv4 or
+    ///     IPv6 address (no name lookup, since that can block).
+    bool begin(const char *pAddress, std::uint16_t port);
+
+    /// @brief close the connection; outstanding transactions fail.
+    void end();
+
+    /// @brief set how many transactions may be in flight, at most
+    ///     knMaxPending. Some gateways only take one at a time.
+    void setMaxPending(std::size_t nMax)
+        { this->m_nMaxPending = nMax == 0 ? 1 : nMax > knMaxPending ? knMaxPending : nMax; }
+
+    void setResponseTimeout(std::uint32_t us)
+        { this->m_responseTimeout = us; }
+
+    void setReconnectInterval(std::uint32_t us)
+        { this->m_reconnectInterval = us; }
+
+    bool isConnected() const
+        { return this->m_state == State::Connected; }
+
+    std::size_t getPendingCount() const
+        { return this->m_nPending; }
+
+    virtual bool isReady() const override;
+    virtual bool submit(Transaction &t) override;
+    virtual void poll() override;
+
+private:
+    enum class State : std::uint8_t
+        {
+        Closed,         ///< no socket; begin() not called, or end().
+        Connecting,     ///< non-blocking connect in progress.
+        Connected,
+        Backoff,        ///< connection failed; waiting to reconnect.
+        };
+
+    struct Pending
+        {
+        Transaction     *pTxn = nullptr;
+        std::uint32_t   tDeadline = 0;
+        std::uint16_t   transactionId = 0;
+        };
+
+    bool connect();
+    void fail(std::uint32_t now);
+    void checkConnect(std::uint32_t now);
+    bool send();
+    bool receive();
+    void complete(const std::uint8_t *pAdu, std::size_t nAdu);
+    void expire(std::uint32_t now);
+
+    Pending         m_pending[knMaxPending];
+    std::uint8_t    m_txBuf[knMaxPending * Mbap::knMaxAduBytes];
+    std::uint8_t    m_rxBuf[2 * Mbap::knMaxAduBytes];
+    sockaddr_storage m_addr;
+    socklen_t       m_addrLen = 0;
+    std::size_t     m_nTx = 0;
+    std::size_t     m_nRx = 0;
+    std::size_t     m_nPending = 0;
+    std::size_t     m_nMaxPending = knMaxPending;
+    std::uint32_t   m_responseTimeout = kDefaultResponseTimeout;
+    std::uint32_t   m_reconnectInterval = kDefaultReconnectInterval;
+    std::uint32_t   m_tBackoff = 0;
+    int             m_fd = -1;
+    std::uint16_t   m_nextTransactionId = 0;
+    State           m_state = State::Closed;
+    };
+
+} // namespace McciCatena
+
+#endif // defined(__linux__) && ! defined(ARDUINO)
+
+#endif // _MCCI_Modbus_Serial_TcpTransport_h_
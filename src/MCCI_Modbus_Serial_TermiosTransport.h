@@ -0,0 +1,159 @@
+/*
+
+Module:  MCCI_Modbus_Serial_TermiosTransport.h
+
+Function:
+    Modbus RTU transport on a Linux serial port.
+
+Copyright notice and License:
+    See LICENSE file accompanying this project.
+
+Author:
+    MCCI Corporation   October 2026
+
+*/
+
+#pragma once
+
+#ifndef _MCCI_Modbus_Serial_TermiosTransport_h_
+# define _MCCI_Modbus_Serial_TermiosTransport_h_
+
+#include "MCCI_Modbus_Serial_Rtu.h"
+
+#if defined(__linux__) && ! defined(ARDUINO)
+
+#include <sys/types.h>
+
+namespace McciCatena {
+
+/// @brief ModbusSerialTransport for an RTU bus on a Linux tty, such as a
+///     USB-RS485 adapter.
+///
+/// The port is opened non-blocking and raw, and nothing here waits: a
+/// transaction moves along each time poll() is called. The inter-frame
+/// gaps and the response timeout come from ModbusSerialTiming at the
+/// port's baud rate. To avoid polling in a loop, put the port in a
+/// ModbusSerialEventLoop, which sleeps until getFd() is readable (or
+/// writable, if isWritePending()) or until getWakeDelay() runs out.
+///
+/// A response normally ends when as many bytes as it should have arrive.
+/// A short response ends after the line has been silent for t3.5 or
+/// kMinSilence, whichever is longer; USB adapters deliver bytes in
+/// bursts, so t3.5 alone can't be measured reliably.
+class ModbusSerialTermiosTransport : public ModbusSerialTransport
+    {
+public:
+    using Rtu = ModbusSerialRtu;
+    using Timing = ModbusSerialTiming;
+
+    /// @brief character format; with no parity, two stop bits keep the
+    ///     character at 11 bits, as the Modbus serial line spec asks.
+    enum class Parity : std::uint8_t
+        {
+        Even,
+        Odd,
+        None,
+        };
+
+    /// @brief shortest silence that ends a short response, in microseconds.
+    static constexpr std::uint32_t kMinSilence = 2000;
+
+    ModbusSerialTermiosTransport() = default;
+    ModbusSerialTermiosTransport(const ModbusSerialTermiosTransport &) = delete;
+    ModbusSerialTermiosTransport &operator=(const ModbusSerialTermiosTransport &) = delete;
+
+    virtual ~ModbusSerialTermiosTransport()
+        { this->end(); }
+
+    /// @brief open and configure a tty. The baud rate must be one of the
+    ///     standard termios rates.
+    bool begin(const char *pPath, std::uint32_t baudrate, Parity parity = Parity::Even);
+
+    /// @brief close the port; an outstanding transaction fails with Error.
+    virtual void end();
+
+    /// @brief set the longest a device may take to start answering; used
+    ///     for transactions that carry no response timeout.
+    void setTurnaroundLimit(std::uint32_t us)
+        { this->m_turnaroundLimit = us; }
+
+    /// @brief return the file descriptor, or -1 if not open.
+    int getFd() const
+        { return this->m_fd; }
+
+    /// @brief true if part of a request is waiting for room in the tty's
+    ///     output buffer.
+    bool isWritePending() const
+        { return this->m_state == State::Sending; }
+
+    /// @brief return how many microseconds poll() can wait before it has
+    ///     something to do other than handle input: the end of the
+    ///     inter-frame gap or the response deadline. UINT32_MAX if none.
+    std::uint32_t getWakeDelay(std::uint32_t now) const;
+
+    /// @brief number of transactions that failed with Error: bad CRC,
+    ///     a short or garbled response, or an I/O error.
+    std::uint32_t getErrorCount() const
+        { return this->m_nErrors; }
+
+    virtual bool isReady() const override
+        { return this->m_fd >= 0 && this->m_pActive == nullptr; }
+
+    virtual bool submit(Transaction &t) override;
+    virtual void poll() override;
+
+    virtual std::uint32_t getBusBaudrate() const override
+        { return this->m_timing.getBaudrate(); }
+
+protected:
+    /// @brief read up to nBuf bytes of input without waiting; like
+    ///     read(2), but returns -1 with errno EAGAIN if there's none.
+    virtual ssize_t readInput(std::uint8_t *pBuf, std::size_t nBuf);
+
+    /// @brief write up to nBuf bytes of output without waiting; like
+    ///     write(2).
+    virtual ssize_t writeOutput(const std::uint8_t *pBuf, std::size_t nBuf);
+
+    /// @brief discard input that hasn't been read yet.
+    virtual void flushInput();
+
+private:
+    enum class State : std::uint8_t
+        {
+        Idle,           ///< no transaction.
+        Gap,            ///< waiting out t3.5 before the request.
+        Sending,        ///< request partly written.
+        Receiving,      ///< waiting for the response.
+        };
+
+    void startSending(std::uint32_t now);
+    void send(std::uint32_t now);
+    void receive(std::uint32_t now);
+    void complete(Transaction::Status status, std::uint32_t now);
+    void finish(std::uint32_t now);
+    std::uint32_t getSilence() const;
+
+    Transaction     *m_pActive = nullptr;
+    ModbusSerialTiming m_timing;
+    std::uint8_t    m_txBuf[Rtu::knMaxFrameBytes];
+    std::uint8_t    m_rxBuf[Rtu::knMaxFrameBytes];
+    std::size_t     m_nTx = 0;
+    std::size_t     m_nSent = 0;
+    std::size_t     m_nRx = 0;
+    std::uint32_t   m_turnaroundLimit = Timing::kDefaultTurnaroundLimit;
+    /// @brief earliest start of the next request.
+    std::uint32_t   m_tNextRequest = 0;
+    /// @brief when the request was (or will be) handed to the tty.
+    std::uint32_t   m_tStart = 0;
+    std::uint32_t   m_tDeadline = 0;
+    std::uint32_t   m_tLastByte = 0;
+    std::uint32_t   m_nErrors = 0;
+    int             m_fd = -1;
+    State           m_state = State::Idle;
+    };
+
+} // namespace McciCatena
+
+#endif // defined(__linux__) && ! defined(ARDUINO)
+
+#endif // _MCCI_Modbus_Serial_TermiosTransport_h_
@@ -0,0 +1,94 @@
+/*
+
+Module:  MCCI_Modbus_Serial_ThreadControl.h
+
+Function:
+    Starting, pinning and stopping the library's worker threads.
+
+Copyright notice and License:
+    See LICENSE file accompanying this project.
+
+Author:
+    MCCI Corporation   October 2026
+
+*/
+
+#pragma once
+
+#ifndef _MCCI_Modbus_Serial_ThreadControl_h_
+# define _MCCI_Modbus_Serial_ThreadControl_h_
+
+#if defined(__linux__) && ! defined(ARDUINO)
+
+#include <atomic>
+#include <thread>
+#include <utility>
+
+namespace McciCatena {
+
+/// @brief the thread scaffolding shared by the bus worker, the bus
+///     executor and the bridges.
+///
+/// begin() clears the stop request, and optionally makes an eventfd for
+/// threads that sleep in epoll_wait() to watch. start() runs a function
+/// on a new thread, pinned to a CPU if asked. requestStop() sets the
+/// flag the threads test, and signals the eventfd; it stays readable, so
+/// every thread watching it wakes. The owner joins its threads, then
+/// calls end().
+class ModbusSerialThreadControl
+    {
+public:
+    ModbusSerialThreadControl() = default;
+    ModbusSerialThreadControl(const ModbusSerialThreadControl &) = delete;
+    ModbusSerialThreadControl &operator=(const ModbusSerialThreadControl &) = delete;
+    ~ModbusSerialThreadControl()
+        { this->end(); }
+
+    /// @brief get ready to start threads; if fStopFd, make the stop
+    ///     eventfd. false if it can't be made.
+    bool begin(bool fStopFd);
+
+    /// @brief close the stop eventfd, once the threads are gone.
+    void end();
+
+    /// @brief the stop eventfd, or -1 if begin() wasn't asked for one.
+    int getStopFd() const
+        { return this->m_stopFd; }
+
+    /// @brief start fn on a new thread, pinned to cpu unless it's
+    ///     negative. false if the thread couldn't be pinned; it is
+    ///     running then, and the caller should stop it.
+    template <typename F>
+    static bool start(std::thread &thread, F &&fn, int cpu)
+        {
+        thread = std::thread(std::forward<F>(fn));
+        return pin(thread, cpu);
+        }
+
+    /// @brief ask the threads to stop.
+    void requestStop();
+
+    /// @brief true once requestStop() has been called; for the threads
+    ///     to test each time they wake.
+    bool isStopRequested() const
+        { return this->m_fStop.load(std::memory_order_relaxed); }
+
+    /// @brief wait for thread, if it was started.
+    static void join(std::thread &thread)
+        {
+        if (thread.joinable())
+            thread.join();
+        }
+
+private:
+    static bool pin(std::thread &thread, int cpu);
+
+    std::atomic<bool> m_fStop { false };
+    int             m_stopFd = -1;
+    };
+
+} // namespace McciCatena
+
+#endif // defined(__linux__) && ! defined(ARDUINO)
+
+#endif // _MCCI_Modbus_Serial_ThreadControl_h_
@@ -0,0 +1,345 @@
+/*
+
+Module:  MCCI_Modbus_Serial_ThreadedClient.h
+
+Function:
+    Host Client for applications on other threads than the bus.
+
+Copyright notice and License:
+    See LICENSE file accompanying this project.
+
+Author:
+    MCCI Corporation   October 2026
+
+*/
+
+#pragma once
+
+#ifndef _MCCI_Modbus_Serial_ThreadedClient_h_
+# define _MCCI_Modbus_Serial_ThreadedClient_h_
+
+#include "MCCI_Modbus_Serial_Host.h"
+#include "MCCI_Modbus_Serial_SpscRing.h"
+
+#if defined(__linux__) && ! defined(ARDUINO)
+
+#include <atomic>
+#include <cerrno>
+#include <cstdint>
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+namespace McciCatena {
+
+class ModbusSerialBusWorker;
+class ModbusSerialBusExecutor;
+
+/// @brief the parts of ModbusSerialThreadedClient that don't depend on
+///     the buffer sizes.
+///
+/// Received data is announced on an eventfd, which the application can
+/// wait on directly or through waitRx(); another eventfd announces room
+/// in a transmit buffer that was full. The worker also publishes the
+/// device's last Status here, so the application can see TxEmpty and
+/// Connect without touching the host.
+///
+/// readTx() and writeRx() move data between a file descriptor and the
+/// buffers with readv() and writev(), with no copy in between, for
+/// bridges to ptys and sockets.
+class ModbusSerialThreadedClientBase : public ModbusSerialHost::Client
+    {
+public:
+    using StatusBits = ModbusSerialHost::StatusBits;
+
+    /// @brief whatever runs the client's host: a ModbusSerialBusWorker,
+    ///     or a bus in a ModbusSerialBusExecutor.
+    class Waker
+        {
+    public:
+        /// @brief look at the client soon. Called from the application
+        ///     thread.
+        virtual void wake() = 0;
+
+    protected:
+        ~Waker() = default;
+        };
+
+    ModbusSerialThreadedClientBase()
+        : m_rxEventFd(::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC))
+        , m_txEventFd(::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC))
+        {}
+
+    ModbusSerialThreadedClientBase(const ModbusSerialThreadedClientBase &) = delete;
+    ModbusSerialThreadedClientBase &operator=(const ModbusSerialThreadedClientBase &) = delete;
+
+    virtual ~ModbusSerialThreadedClientBase()
+        {
+        if (this->m_rxEventFd >= 0)
+            ::close(this->m_rxEventFd);
+        if (this->m_txEventFd >= 0)
+            ::close(this->m_txEventFd);
+        }
+
+    //---- application side ----
+
+    /// @brief return an eventfd that becomes readable when data arrives;
+    ///     for the application's own poll or epoll. waitRx() clears it.
+    int getRxEventFd() const
+        { return this->m_rxEventFd; }
+
+    /// @brief return an eventfd that becomes readable when the worker
+    ///     makes room in a transmit buffer that putTx() or readTx() found
+    ///     full. Read it to clear it.
+    int getTxEventFd() const
+        { return this->m_txEventFd; }
+
+    /// @brief read from fd straight into the transmit buffer. Like
+    ///     read(2): returns the number of bytes read, 0 at end of file,
+    ///     or -1 with errno set; ENOBUFS if the buffer is full. If fFlush
+    ///     is set, the data goes out without waiting for coalescing.
+    virtual ssize_t readTx(int fd, bool fFlush = false) = 0;
+
+    /// @brief write received data straight from the buffer to fd. Like
+    ///     write(2); returns 0 if there's nothing to write.
+    virtual ssize_t writeRx(int fd) = 0;
+
+    /// @brief wait up to msTimeout milliseconds (-1 for ever) for received
+    ///     data to be announced. Read everything available afterwards;
+    ///     data that arrives while some is waiting may not be announced.
+    bool waitRx(int msTimeout)
+        {
+        pollfd pfd;
+        pfd.fd = this->m_rxEventFd;
+        pfd.events = POLLIN;
+        pfd.revents = 0;
+        if (::poll(&pfd, 1, msTimeout) <= 0)
+            return false;
+
+        std::uint64_t count;
+        (void) ::read(this->m_rxEventFd, &count, sizeof(count));
+        return true;
+        }
+
+    /// @brief return the device's last Status, as seen by the worker.
+    StatusBits getStatus() const
+        { return StatusBits(this->m_status.load(std::memory_order_relaxed)); }
+
+    /// @brief true if the host is in the operating macro-state.
+    bool isOperating() const
+        { return this->m_fOperating.load(std::memory_order_relaxed); }
+
+protected:
+    /// @brief announce received data to the application.
+    void signalRx()
+        {
+        std::uint64_t const one = 1;
+        (void) ::write(this->m_rxEventFd, &one, sizeof(one));
+        }
+
+    /// @brief announce room in the transmit buffer to the application.
+    void signalTx()
+        {
+        std::uint64_t const one = 1;
+        (void) ::write(this->m_txEventFd, &one, sizeof(one));
+        }
+
+    /// @brief wake the bus worker, if there is one.
+    void wakeWorker()
+        {
+        if (this->m_pWaker != nullptr)
+            this->m_pWaker->wake();
+        }
+
+private:
+    friend class ModbusSerialBusWorker;
+    friend class ModbusSerialBusExecutor;
+
+    /// @brief set by the worker before its thread starts.
+    Waker           *m_pWaker = nullptr;
+    std::atomic<std::uint16_t> m_status { 0 };
+    std::atomic<bool> m_fOperating { false };
+    int             m_rxEventFd;
+    int             m_txEventFd;
+    };
+
+/// @brief a host Client whose application side may be used from another
+///     thread than the one polling the host.
+///
+/// @tparam a_nTx is the transmit buffer size in bytes, a power of two.
+/// @tparam a_nRx is the receive buffer size in bytes, a power of two.
+///
+/// The interface matches ModbusSerialBufferedClient, but each direction
+/// is a ModbusSerialSpscRing, so the application and the bus worker
+/// never take a lock or wait for each other. One application thread may
+/// write and one may read (they can be the same thread). Queuing output
+/// into an empty buffer, or flushing, wakes the worker.
+template <std::size_t a_nTx = 256, std::size_t a_nRx = 256>
+class ModbusSerialThreadedClient : public ModbusSerialThreadedClientBase
+    {
+public:
+    using TxBuffer = ModbusSerialSpscRing<a_nTx>;
+    using RxBuffer = ModbusSerialSpscRing<a_nRx>;
+
+    //---- application side ----
+
+    /// @brief return number of received bytes waiting to be read.
+    std::size_t getRxAvailable() const
+        { return this->m_rx.available(); }
+
+    /// @brief return number of bytes that can be queued for transmit.
+    std::size_t getTxSpace() const
+        { return this->m_tx.getSpace(); }
+
+    /// @brief true if nothing is waiting to go to the device.
+    bool isTxEmpty() const
+        { return this->m_tx.isEmpty(); }
+
+    /// @brief queue up to n bytes for transmission; return number queued.
+    ///     If fFlush is set, everything queued so far goes out without
+    ///     waiting for the host's coalescing.
+    std::size_t putTx(const std::uint8_t *pBuf, std::size_t n, bool fFlush = false)
+        {
+        bool const fWasEmpty = this->m_tx.isEmpty();
+        auto const nPut = this->m_tx.put(pBuf, n);
+
+        // if the rest won't fit, the caller will wait for the tx eventfd;
+        // make sure it's signalled even if room appeared just now.
+        if (nPut < n && this->setTxWaiting())
+            this->signalTx();
+
+        this->notifyTx(fWasEmpty, nPut, fFlush);
+        return nPut;
+        }
+
+    /// @brief send everything queued so far without waiting for the
+    ///     host's coalescing. Doesn't wait for it to go.
+    void flushTx()
+        {
+        this->m_nTxFlush.store(this->m_tx.getPutCount(), std::memory_order_relaxed);
+        this->wakeWorker();
+        }
+
+    /// @brief remove up to n received bytes; return number removed.
+    std::size_t getRx(std::uint8_t *pBuf, std::size_t n)
+        { return this->m_rx.get(pBuf, n); }
+
+    virtual ssize_t readTx(int fd, bool fFlush = false) override
+        {
+        typename TxBuffer::Span spans[2];
+        iovec iov[2];
+
+        if (this->m_tx.getFreeSpans(spans) == 0 &&
+            (! this->setTxWaiting() || this->m_tx.getFreeSpans(spans) == 0))
+            {
+            errno = ENOBUFS;
+            return -1;
+            }
+
+        bool const fWasEmpty = this->m_tx.isEmpty();
+        auto const n = ::readv(fd, iov, toIovec(spans, iov));
+        if (n <= 0)
+            return n;
+
+        this->m_tx.commit(std::size_t(n));
+        this->notifyTx(fWasEmpty, std::size_t(n), fFlush);
+        return n;
+        }
+
+    virtual ssize_t writeRx(int fd) override
+        {
+        typename RxBuffer::Span spans[2];
+        iovec iov[2];
+
+        if (this->m_rx.getDataSpans(spans) == 0)
+            return 0;
+
+        auto const n = ::writev(fd, iov, toIovec(spans, iov));
+        if (n > 0)
+            this->m_rx.discard(std::size_t(n));
+        return n;
+        }
+
+    //---- host engine side ----
+
+    virtual std::size_t getTxPending() override
+        { return this->m_tx.available(); }
+
+    virtual std::size_t peekTx(std::uint8_t *pBuf, std::size_t nBuf) override
+        { return this->m_tx.peek(pBuf, nBuf); }
+
+    virtual void consumeTx(std::size_t n) override
+        {
+        if (this->m_tx.discard(n) == 0)
+            return;
+
+        // pairs with the fence in setTxWaiting(): either that sees the
+        // room just made, or this sees the flag.
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (this->m_fTxWaiting.load(std::memory_order_relaxed) &&
+            this->m_fTxWaiting.exchange(false, std::memory_order_relaxed))
+            this->signalTx();
+        }
+
+    virtual std::size_t getRxSpace() override
+        { return this->m_rx.getSpace(); }
+
+    virtual void putRx(const std::uint8_t *pBuf, std::size_t n) override
+        {
+        if (this->m_rx.put(pBuf, n) != 0)
+            this->signalRx();
+        }
+
+    virtual bool isTxFlushRequested() override
+        {
+        // the flush covers everything put before it; it's done once
+        // that much has been consumed.
+        auto const nFlush = this->m_nTxFlush.load(std::memory_order_relaxed);
+
+        return std::ptrdiff_t(nFlush - this->m_tx.getGetCount()) > 0;
+        }
+
+private:
+    /// @brief note that the application found the transmit buffer full
+    ///     and will wait for the tx eventfd; return true if there's room
+    ///     after all.
+    bool setTxWaiting()
+        {
+        this->m_fTxWaiting.store(true, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        return this->m_tx.getSpace() != 0;
+        }
+
+    void notifyTx(bool fWasEmpty, std::size_t nPut, bool fFlush)
+        {
+        if (fFlush)
+            this->flushTx();
+        else if (fWasEmpty && nPut != 0)
+            this->wakeWorker();
+        }
+
+    template <typename Span>
+    static int toIovec(const Span (&spans)[2], iovec (&iov)[2])
+        {
+        iov[0].iov_base = spans[0].pBuf;
+        iov[0].iov_len = spans[0].nBuf;
+        iov[1].iov_base = spans[1].pBuf;
+        iov[1].iov_len = spans[1].nBuf;
+        return spans[1].nBuf != 0 ? 2 : 1;
+        }
+
+    TxBuffer        m_tx;
+    RxBuffer        m_rx;
+    /// @brief the transmit put count at the last flush request.
+    std::atomic<std::size_t> m_nTxFlush { 0 };
+    /// @brief set by the application when the transmit buffer was full;
+    ///     cleared by the worker when it signals the tx eventfd.
+    std::atomic<bool> m_fTxWaiting { false };
+    };
+
+} // namespace McciCatena
+
+#endif // defined(__linux__) && ! defined(ARDUINO)
+
+#endif // _MCCI_Modbus_Serial_ThreadedClient_h_
@@ -0,0 +1,137 @@
+/*
+
+Module:  MCCI_Modbus_Serial_Timing.h
+
+Function:
+    Modbus RTU character, gap and timeout arithmetic.
+
+Copyright notice and License:
+    See LICENSE file accompanying this project.
+
+Author:
+    MCCI Corporation   October 2026
+
+*/
+
+#pragma once
+
+#ifndef _MCCI_Modbus_Serial_Timing_h_
+# define _MCCI_Modbus_Serial_Timing_h_
+
+#include <cstdint>
+
+namespace McciCatena {
+
+/// @brief RTU bus timing at a given baud rate.
+///
+/// A frame ends when the line has been silent for 3.5 character times
+/// (t3.5), and a gap of more than 1.5 characters (t1.5) inside a frame
+/// is an error. Above 19200 baud, the Modbus serial line spec fixes
+/// these at 750 and 1750 microseconds instead. All times are in
+/// microseconds; with an unknown (zero) baud rate, all of them are zero.
+class ModbusSerialTiming
+    {
+public:
+    /// @brief bits per character on an RTU bus (start, 8 data, parity or 2nd stop, stop).
+    static constexpr std::uint32_t kBitsPerChar = 11;
+
+    /// @brief above this rate, t1.5 and t3.5 are fixed.
+    static constexpr std::uint32_t kFixedGapBaudrate = 19200;
+    static constexpr std::uint32_t kFixedT15 = 750;
+    static constexpr std::uint32_t kFixedT35 = 1750;
+
+    /// @brief typical device processing time, after it has seen the end
+    ///     of the request and before it starts the response.
+    static constexpr std::uint32_t kDefaultTurnaround = 1000;
+
+    /// @brief default longest processing time before a response is given
+    ///     up for lost.
+    static constexpr std::uint32_t kDefaultTurnaroundLimit = 100 * 1000;
+
+    /// @brief default longest processing time for a probe. A device
+    ///     that's there answers a one-register read quickly; waiting the
+    ///     full turnaround limit for one that isn't would waste the bus.
+    static constexpr std::uint32_t kDefaultProbeTurnaroundLimit = 10 * 1000;
+
+    constexpr ModbusSerialTiming(std::uint32_t baudrate = 0)
+        : m_baudrate(baudrate)
+        {}
+
+    void setBaudrate(std::uint32_t baudrate)
+        { this->m_baudrate = baudrate; }
+
+    constexpr std::uint32_t getBaudrate() const
+        { return this->m_baudrate; }
+
+    /// @brief return the time nBytes take at baudrate; zero if unknown.
+    static constexpr std::uint32_t getFrameMicros(std::uint32_t nBytes, std::uint32_t baudrate)
+        {
+        return baudrate == 0 ? 0 : std::uint32_t((std::uint64_t(nBytes) * kBitsPerChar * 1000000u) / baudrate);
+        }
+
+    constexpr std::uint32_t getFrameMicros(std::uint32_t nBytes) const
+        { return getFrameMicros(nBytes, this->m_baudrate); }
+
+    /// @brief return the number of whole characters sent in us.
+    constexpr std::uint32_t getBytesInMicros(std::uint32_t us) const
+        { return std::uint32_t((std::uint64_t(us) * this->m_baudrate) / (kBitsPerChar * 1000000u)); }
+
+    /// @brief return the longest allowed gap inside a frame.
+    constexpr std::uint32_t getT15() const
+        {
+        return this->m_baudrate > kFixedGapBaudrate ? kFixedT15
+             : this->getCharGap(3);
+        }
+
+    /// @brief return the silent interval that ends a frame.
+    constexpr std::uint32_t getT35() const
+        {
+        return this->m_baudrate > kFixedGapBaudrate ? kFixedT35
+             : this->getCharGap(7);
+        }
+
+    /// @brief return how long to wait, after the end of a request, for
+    ///     the end of a response of nResponseBytes from a device that
+    ///     takes up to turnaroundLimit to answer; zero if the baud rate
+    ///     is unknown.
+    constexpr std::uint32_t getResponseTimeout(std::uint32_t nResponseBytes, std::uint32_t turnaroundLimit) const
+        {
+        return this->m_baudrate == 0 ? 0
+             : this->getT35() + turnaroundLimit + this->getFrameMicros(nResponseBytes) + this->getT35();
+        }
+
+    /// @brief return the earliest time a request may start after a
+    ///     frame that ended at tEnd.
+    constexpr std::uint32_t getNextRequestTime(std::uint32_t tEnd) const
+        { return tEnd + this->getT35(); }
+
+    /// @brief return the bus time of a whole transaction, from the start
+    ///     of the request to the earliest start of the next one.
+    constexpr std::uint32_t getTransactionMicros(
+        std::uint32_t nRequestBytes,
+        std::uint32_t nResponseBytes,
+        std::uint32_t turnaround = kDefaultTurnaround
+        ) const
+        {
+        return this->getFrameMicros(nRequestBytes) + this->getT35() + turnaround
+             + this->getFrameMicros(nResponseBytes) + this->getT35();
+        }
+
+    /// @brief return the bus time of a transaction, less its frames.
+    constexpr std::uint32_t getOverheadMicros(std::uint32_t turnaround = kDefaultTurnaround) const
+        { return this->getTransactionMicros(0, 0, turnaround); }
+
+private:
+    /// @brief return nHalves half-characters, rounded up.
+    constexpr std::uint32_t getCharGap(std::uint32_t nHalves) const
+        {
+        return this->m_baudrate == 0 ? 0
+             : std::uint32_t((std::uint64_t(nHalves) * kBitsPerChar * 1000000u + 2 * this->m_baudrate - 1) / (2 * this->m_baudrate));
+        }
+
+    std::uint32_t   m_baudrate;
+    };
+
+} // namespace McciCatena
+
+#endif // _MCCI_Modbus_Serial_Timing_h_
@@ -0,0 +1,244 @@
+/*
+
+Module:  MCCI_Modbus_Serial_Transport.h
+
+Function:
+    Abstract Modbus transport used by the Serial-over-Modbus host engine.
+
+Copyright notice and License:
+    See LICENSE file accompanying this project.
+
+Author:
+    MCCI Corporation   October 2026
+
+*/
+
+#pragma once
+
+#ifndef _MCCI_Modbus_Serial_Transport_h_
+# define _MCCI_Modbus_Serial_Transport_h_
+
+#include "MCCI_Modbus_Serial_Protocol.h"
+#include "MCCI_Modbus_Serial_Timing.h"
+
+#if defined(ARDUINO)
+# include <Arduino.h>
+#else
+# include <ctime>
+#endif
+
+namespace McciCatena {
+
+    namespace Internal {
+        /// @brief default time base for transports, in microseconds.
+        inline std::uint32_t getMicros()
+            {
+#if defined(ARDUINO)
+            return micros();
+#else
+            struct timespec ts;
+            clock_gettime(CLOCK_MONOTONIC, &ts);
+            return std::uint32_t(ts.tv_sec * 1000000u + ts.tv_nsec / 1000u);
+#endif
+            }
+    } // namespace McciCatena::Internal
+
+/// @brief one Modbus register transaction, as seen by the host engine.
+///
+/// The host fills in the request fields and hands the object to a
+/// ModbusSerialTransport. The transport sets `status` to `Pending` on
+/// acceptance, and to one of the final values when the exchange is
+/// complete. The object must stay put until then.
+class ModbusSerialTransaction
+    {
+public:
+    using Register = ModbusSerialProtocol::Register;
+
+    /// @brief the Modbus function codes used by this protocol.
+    enum class Function : std::uint8_t
+        {
+        ReadHoldingRegisters        = 0x03,
+        ReadInputRegisters          = 0x04,
+        WriteMultipleRegisters      = 0x10,
+        ReadWriteMultipleRegisters  = 0x17,
+        };
+
+    /// @brief transaction status.
+    enum class Status : std::uint8_t
+        {
+        Idle,           ///< not submitted.
+        Pending,        ///< accepted by the transport, not yet complete.
+        Success,        ///< response received and decoded.
+        NoReply,        ///< device didn't respond in time.
+        Exception,      ///< device returned an exception; see exceptionCode.
+        Error,          ///< CRC, framing, or other transport error.
+        };
+
+    /// @brief largest register window we ever move: Status plus all of RxData,
+    ///     or all of TxData plus TxDataByte.
+    static constexpr std::uint16_t knMaxRegs = ModbusSerialProtocol::knRxDataReg + 1;
+    static_assert(ModbusSerialProtocol::knTxDataReg + 1 <= knMaxRegs, "TX window doesn't fit");
+
+    /// @brief bytes in the request and response frames of the longest
+    ///     transaction the host engine issues: 0x17 writing all of TxData
+    ///     and reading Status plus all of RxData.
+    static constexpr std::uint16_t knMaxTransactionBytes =
+        13 + 2 * (ModbusSerialProtocol::knTxDataReg + 1) +
+        5 + 2 * (1 + ModbusSerialProtocol::knRxDataReg);
+
+    /// @brief the Modbus exception code for an unimplemented function.
+    static constexpr std::uint8_t kExceptionIllegalFunction = 1;
+
+    /// @brief bits per character on an RTU bus (start, 8 data, parity or 2nd stop, stop).
+    static constexpr std::uint32_t kBitsPerChar = ModbusSerialTiming::kBitsPerChar;
+
+    /// @brief return the time, in microseconds, that nBytes take on an
+    ///     RTU bus at baudrate; zero if the rate isn't known.
+    static constexpr std::uint32_t getFrameMicros(std::uint32_t nBytes, std::uint32_t baudrate)
+        { return ModbusSerialTiming::getFrameMicros(nBytes, baudrate); }
+
+    /// @brief set up a read of nRegs registers starting at reg.
+    void setRead(Function fn, Register reg, std::uint16_t nRegs)
+        {
+        this->function = fn;
+        this->readAddress = ModbusSerialProtocol::getAddress(reg);
+        this->nRead = nRegs;
+        this->nWrite = 0;
+        }
+
+    /// @brief set up a write of nRegs registers starting at reg; the
+    ///     caller fills in writeRegs[].
+    void setWrite(Register reg, std::uint16_t nRegs)
+        {
+        this->function = Function::WriteMultipleRegisters;
+        this->writeAddress = ModbusSerialProtocol::getAddress(reg);
+        this->nWrite = nRegs;
+        this->nRead = 0;
+        }
+
+    /// @brief set up a Read/Write Multiple Registers (0x17): nWriteRegs
+    ///     registers are written at writeReg, then nReadRegs registers are
+    ///     read at readReg, in one exchange. The caller fills in writeRegs[].
+    void setReadWrite(
+        Register readReg, std::uint16_t nReadRegs,
+        Register writeReg, std::uint16_t nWriteRegs
+        )
+        {
+        this->function = Function::ReadWriteMultipleRegisters;
+        this->readAddress = ModbusSerialProtocol::getAddress(readReg);
+        this->nRead = nReadRegs;
+        this->writeAddress = ModbusSerialProtocol::getAddress(writeReg);
+        this->nWrite = nWriteRegs;
+        }
+
+    bool isPending() const
+        { return this->status == Status::Pending; }
+
+    /// @brief true if the transaction has finished, successfully or not.
+    bool isDone() const
+        { return this->status != Status::Idle && this->status != Status::Pending; }
+
+    bool isSuccess() const
+        { return this->status == Status::Success; }
+
+    /// @brief number of bytes in the RTU request frame (address through CRC).
+    std::uint16_t getRequestBytes() const
+        {
+        switch (this->function)
+            {
+        case Function::WriteMultipleRegisters:
+            return 9 + 2 * this->nWrite;
+        case Function::ReadWriteMultipleRegisters:
+            return 13 + 2 * this->nWrite;
+        default:
+            return 8;
+            }
+        }
+
+    /// @brief number of bytes in a successful RTU response frame.
+    std::uint16_t getResponseBytes() const
+        {
+        switch (this->function)
+            {
+        case Function::WriteMultipleRegisters:
+            return 8;
+        default:
+            return 5 + 2 * this->nRead;
+            }
+        }
+
+    std::uint8_t    unitId = 0;
+    Function        function = Function::ReadInputRegisters;
+    Status          status = Status::Idle;
+    /// @brief the Modbus exception code, if status is Exception.
+    std::uint8_t    exceptionCode = 0;
+    /// @brief bus address of the first register to read.
+    std::uint16_t   readAddress = 0;
+    /// @brief number of registers to read.
+    std::uint16_t   nRead = 0;
+    /// @brief bus address of the first register to write.
+    std::uint16_t   writeAddress = 0;
+    /// @brief number of registers to write.
+    std::uint16_t   nWrite = 0;
+    /// @brief how long, in microseconds after the end of the request, to
+    ///     wait for the end of the response; zero for the transport's
+    ///     default.
+    std::uint32_t   responseTimeout = 0;
+    /// @brief the register values read.
+    std::uint16_t   readRegs[knMaxRegs];
+    /// @brief the register values to be written.
+    std::uint16_t   writeRegs[knMaxRegs];
+    };
+
+/// @brief abstract non-blocking Modbus transport.
+///
+/// Concrete transports wrap a ModbusRtuV2 master, a simulated device,
+/// or a native Linux port. None of the methods may block.
+class ModbusSerialTransport
+    {
+public:
+    using Transaction = ModbusSerialTransaction;
+
+    virtual ~ModbusSerialTransport() = default;
+
+    /// @brief true if submit() will accept a new transaction now.
+    virtual bool isReady() const = 0;
+
+    /// @brief start a transaction. Sets t.status to Pending and returns
+    ///     true if accepted; returns false (and leaves t alone) if busy.
+    ///
+    /// A serial transport should accept a transaction during the t3.5
+    /// silent interval after the previous frame, and start the request
+    /// as soon as the interval is over, so that callers needn't time the
+    /// gap themselves. It should give up on the response
+    /// t.responseTimeout microseconds after the end of the request, if
+    /// that's set.
+    virtual bool submit(Transaction &t) = 0;
+
+    /// @brief advance the transport; completes transactions by updating
+    ///     their status.
+    virtual void poll() = 0;
+
+    /// @brief return false if the transport can't carry a given function
+    ///     code at all. Devices may still reject functions the transport
+    ///     carries; that shows up as an exception.
+    virtual bool isFunctionSupported(Transaction::Function fn) const
+        {
+        (void) fn;
+        return true;
+        }
+
+    /// @brief return the bus bit rate, or zero if not a serial bus.
+    virtual std::uint32_t getBusBaudrate() const
+        { return 0; }
+
+    /// @brief return the current time in microseconds. All timers in the
+    ///     host engine use this clock, so that simulations can run on
+    ///     virtual time.
+    virtual std::uint32_t getMicros() const
+        { return Internal::getMicros(); }
+    };
+
+} // namespace McciCatena
+
+#endif // _MCCI_Modbus_Serial_Transport_h_
@@ -0,0 +1,149 @@
+/*
+
+Module:  MCCI_Modbus_Serial_TxArrivals.h
+
+Function:
+    Tracks when pending transmit bytes were queued.
+
+Copyright notice and License:
+    See LICENSE file accompanying this project.
+
+Author:
+    MCCI Corporation   October 2026
+
+*/
+
+#pragma once
+
+#ifndef _MCCI_Modbus_Serial_TxArrivals_h_
+# define _MCCI_Modbus_Serial_TxArrivals_h_
+
+#include <cstddef>
+#include <cstdint>
+
+namespace McciCatena {
+
+/// @brief arrival times of the bytes in a client's transmit queue.
+///
+/// The host can't see when the application queues each byte; it sees
+/// the pending count grow. Each time it looks (on every poll), update()
+/// records the bytes that are new since last time, as a mark with the
+/// time they were first seen. consume() retires marks in FIFO order as
+/// bytes are written. When the marks run out, new bytes are added to
+/// the newest mark, so they are treated as older than they really are.
+class ModbusSerialTxArrivals
+    {
+public:
+    /// @brief number of separate arrival marks kept.
+    static constexpr std::size_t knMarks = 8;
+
+    /// @brief forget all pending bytes.
+    void clear()
+        {
+        this->m_nMarks = 0;
+        this->m_nTracked = 0;
+        }
+
+    /// @brief true if no pending bytes are tracked.
+    bool isEmpty() const
+        { return this->m_nTracked == 0; }
+
+    /// @brief record the client's pending count as seen at time now.
+    void update(std::size_t nPending, std::uint32_t now)
+        {
+        // the client discarded output without sending it; the survivors
+        // are the newest bytes, but keep the oldest time for them.
+        if (nPending < this->m_nTracked)
+            {
+            if (nPending == 0)
+                this->clear();
+            else
+                {
+                auto const tOldest = this->getOldest();
+
+                this->clear();
+                this->push(nPending, tOldest);
+                }
+            return;
+            }
+
+        if (nPending > this->m_nTracked)
+            this->push(nPending - this->m_nTracked, now);
+        }
+
+    /// @brief return when the oldest pending byte was first seen; only
+    ///     meaningful if ! isEmpty().
+    std::uint32_t getOldest() const
+        { return this->m_marks[this->m_iHead].tSeen; }
+
+    /// @brief retire the n oldest bytes, which were written at time now.
+    ///     Return how many of them had been pending longer than maxAge
+    ///     microseconds; a maxAge of zero counts nothing.
+    std::size_t consume(std::size_t n, std::uint32_t now, std::uint32_t maxAge)
+        {
+        std::size_t nLate = 0;
+
+        while (n != 0 && this->m_nMarks != 0)
+            {
+            Mark &mark = this->m_marks[this->m_iHead];
+            std::size_t const nTaken = n < mark.nBytes ? n : mark.nBytes;
+
+            if (maxAge != 0 && now - mark.tSeen > maxAge)
+                nLate += nTaken;
+
+            mark.nBytes -= nTaken;
+            this->m_nTracked -= nTaken;
+            n -= nTaken;
+
+            if (mark.nBytes == 0)
+                {
+                if (++this->m_iHead == knMarks)
+                    this->m_iHead = 0;
+                --this->m_nMarks;
+                }
+            }
+
+        return nLate;
+        }
+
+private:
+    struct Mark
+        {
+        std::uint32_t   tSeen;
+        std::size_t     nBytes;
+        };
+
+    void push(std::size_t n, std::uint32_t tSeen)
+        {
+        if (this->m_nMarks == knMarks)
+            {
+            std::size_t iLast = this->m_iHead + knMarks - 1;
+
+            if (iLast >= knMarks)
+                iLast -= knMarks;
+            this->m_marks[iLast].nBytes += n;
+            }
+        else
+            {
+            std::size_t iNew = this->m_iHead + this->m_nMarks;
+
+            if (iNew >= knMarks)
+                iNew -= knMarks;
+            this->m_marks[iNew].tSeen = tSeen;
+            this->m_marks[iNew].nBytes = n;
+            ++this->m_nMarks;
+            }
+
+        this->m_nTracked += n;
+        }
+
+    Mark            m_marks[knMarks];
+    std::size_t     m_iHead = 0;
+    std::size_t     m_nMarks = 0;
+    /// @brief total bytes covered by the marks.
+    std::size_t     m_nTracked = 0;
+    };
+
+} // namespace McciCatena
+
+#endif // _MCCI_Modbus_Serial_TxArrivals_h_
@@ -0,0 +1,146 @@
+/*
+
+Module:  MCCI_Modbus_Serial_UringLoop.h
+
+Function:
+    io_uring-driven loop serving many Linux serial buses from one thread.
+
+Copyright notice and License:
+    See LICENSE file accompanying this project.
+
+Author:
+    MCCI Corporation   October 2026
+
+*/
+
+#pragma once
+
+#ifndef _MCCI_Modbus_Serial_UringLoop_h_
+# define _MCCI_Modbus_Serial_UringLoop_h_
+
+#include "MCCI_Modbus_Serial_Bus.h"
+#include "MCCI_Modbus_Serial_UringTransport.h"
+
+#if defined(__linux__) && ! defined(ARDUINO) && defined(MCCI_MODBUS_SERIAL_IO_URING)
+
+namespace McciCatena {
+
+/// @brief the io_uring counterpart of ModbusSerialEventLoop.
+///
+/// The interface is the same, with ModbusSerialUringTransport ports in
+/// place of termios ones. Each run() makes one io_uring_enter() call:
+/// it submits the reads and writes queued for all ports, then sleeps
+/// until something completes, a port's frame timer runs out, or the
+/// tick passes. The ring's buffers are registered once, at begin(), so
+/// the kernel doesn't map them for every frame.
+class ModbusSerialUringLoop
+    {
+public:
+    using Bus = ModbusSerialBus;
+    using Host = ModbusSerialHost;
+    using Port = ModbusSerialUringTransport;
+
+    static constexpr std::size_t knMaxPorts = 64;
+
+    /// @brief default tick, in microseconds.
+    static constexpr std::uint32_t kDefaultTick = 1000;
+
+    ModbusSerialUringLoop() = default;
+    ModbusSerialUringLoop(const ModbusSerialUringLoop &) = delete;
+    ModbusSerialUringLoop &operator=(const ModbusSerialUringLoop &) = delete;
+
+    ~ModbusSerialUringLoop()
+        { this->end(); }
+
+    /// @brief create the ring and register its buffers.
+    bool begin();
+
+    /// @brief take all ports out and release the ring.
+    void end();
+
+    /// @brief add an open port and the bus that uses it.
+    bool add(Port &port, Bus &bus)
+        { return this->add(port, &bus, nullptr); }
+
+    /// @brief add an open port and the one host that uses it.
+    bool add(Port &port, Host &host)
+        { return this->add(port, nullptr, &host); }
+
+    /// @brief remove a port, cancelling its outstanding I/O.
+    bool remove(Port &port);
+
+    /// @brief set the longest time between polls of a bus.
+    void setTick(std::uint32_t us)
+        { this->m_tick = us != 0 ? us : 1; }
+
+    /// @brief wait up to maxWait microseconds for completions, then poll
+    ///     the buses that have something to do. Returns false on error.
+    bool run(std::uint32_t maxWait = UINT32_MAX);
+
+    /// @brief number of io_uring_enter() calls made.
+    std::uint32_t getEnterCount() const
+        { return this->m_nEnter; }
+
+private:
+    struct Entry
+        {
+        Port            *pPort = nullptr;
+        Bus             *pBus = nullptr;
+        Host            *pHost = nullptr;
+        std::uint32_t   tLastPoll = 0;
+        bool            fReady = false;
+        /// @brief a cancelled read or write on this slot's buffers
+        ///     hadn't completed when its port was removed. The kernel may
+        ///     still use the buffers, so the slot stays reserved until
+        ///     reap() sees the completion.
+        bool            fReadOrphan = false;
+        bool            fWriteOrphan = false;
+
+        bool isFree() const
+            { return this->pPort == nullptr && ! this->fReadOrphan && ! this->fWriteOrphan; }
+        };
+
+    /// @brief the kernel's view of the ring, mapped at begin().
+    struct Ring
+        {
+        void            *pSqRing = nullptr;
+        std::size_t     nSqRing = 0;
+        void            *pCqRing = nullptr;
+        std::size_t     nCqRing = 0;
+        void            *pSqes = nullptr;
+        std::size_t     nSqes = 0;
+        std::uint32_t   *pSqHead = nullptr;
+        std::uint32_t   *pSqTail = nullptr;
+        std::uint32_t   *pSqArray = nullptr;
+        std::uint32_t   sqMask = 0;
+        std::uint32_t   *pCqHead = nullptr;
+        std::uint32_t   *pCqTail = nullptr;
+        void            *pCqes = nullptr;
+        std::uint32_t   cqMask = 0;
+        };
+
+    bool add(Port &port, Bus *pBus, Host *pHost);
+    std::size_t queueIo();
+    bool queueSqe(std::uint8_t opcode, int fd, std::uint16_t iBuf, void *pBuf, std::size_t nBuf, std::uint64_t userData);
+    bool enter(std::size_t nSubmit, std::uint32_t timeout);
+    void reap();
+    bool hasOrphans() const;
+    std::uint32_t getWakeDelay(const Entry &entry, std::uint32_t now) const;
+
+    Entry           m_entries[knMaxPorts];
+    Ring            m_ring;
+    /// @brief registered buffers: a receive and a transmit buffer per port.
+    std::uint8_t    (*m_pRxBufs)[Port::knRxBufferBytes] = nullptr;
+    std::uint8_t    (*m_pTxBufs)[Port::knTxBufferBytes] = nullptr;
+    /// @brief SQEs queued since the last enter().
+    std::size_t     m_nQueued = 0;
+    std::uint32_t   m_tick = kDefaultTick;
+    std::uint32_t   m_nEnter = 0;
+    int             m_ringFd = -1;
+    };
+
+} // namespace McciCatena
+
+#endif // defined(__linux__) && ! defined(ARDUINO) && defined(MCCI_MODBUS_SERIAL_IO_URING)
+
+#endif // _MCCI_Modbus_Serial_UringLoop_h_
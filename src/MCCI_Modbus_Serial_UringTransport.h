@@ -0,0 +1,98 @@
+/*
+
+Module:  MCCI_Modbus_Serial_UringTransport.h
+
+Function:
+    Modbus RTU transport on a Linux serial port, with I/O by io_uring.
+
+Copyright notice and License:
+    See LICENSE file accompanying this project.
+
+Author:
+    MCCI Corporation   October 2026
+
+*/
+
+#pragma once
+
+#ifndef _MCCI_Modbus_Serial_UringTransport_h_
+# define _MCCI_Modbus_Serial_UringTransport_h_
+
+#include "MCCI_Modbus_Serial_TermiosTransport.h"
+
+#if defined(__linux__) && ! defined(ARDUINO) && defined(MCCI_MODBUS_SERIAL_IO_URING)
+
+namespace McciCatena {
+
+class ModbusSerialUringLoop;
+
+/// @brief ModbusSerialTermiosTransport whose reads and writes go through
+///     the io_uring of a ModbusSerialUringLoop.
+///
+/// Framing and timing are the same as the termios transport's. The
+/// difference is that a read is always outstanding in the ring, and a
+/// request is written by queueing it there; the loop submits the queued
+/// work and collects the completions for all its ports in one system
+/// call. The port does no I/O until it's added to a loop.
+///
+/// Only built if MCCI_MODBUS_SERIAL_IO_URING is defined; it needs a
+/// kernel with IORING_FEAT_EXT_ARG (5.11 or later).
+class ModbusSerialUringTransport : public ModbusSerialTermiosTransport
+    {
+public:
+    using Protocol = ModbusSerialProtocol;
+
+    /// @brief size of the ring's receive buffer for each port: a
+    ///     response carrying Status plus all of RxData.
+    static constexpr std::size_t knRxBufferBytes = 5 + 2 * (Protocol::knRxDataReg + 1);
+
+    /// @brief size of the ring's transmit buffer for each port.
+    static constexpr std::size_t knTxBufferBytes = Rtu::knMaxFrameBytes;
+
+    ModbusSerialUringTransport() = default;
+
+    virtual ~ModbusSerialUringTransport()
+        { this->end(); }
+
+    /// @brief open and configure a tty, for blocking reads through the ring.
+    bool begin(const char *pPath, std::uint32_t baudrate, Parity parity = Parity::Even);
+
+    /// @brief take the port out of its loop, and close it.
+    virtual void end() override;
+
+    /// @brief true if the last read failed; the port reads no more until
+    ///     it's opened again.
+    bool isReadFailed() const
+        { return this->m_fReadFailed; }
+
+protected:
+    virtual ssize_t readInput(std::uint8_t *pBuf, std::size_t nBuf) override;
+    virtual ssize_t writeOutput(const std::uint8_t *pBuf, std::size_t nBuf) override;
+    virtual void flushInput() override;
+
+private:
+    friend class ModbusSerialUringLoop;
+
+    /// @brief the loop's state for this port, set while it's in a loop.
+    ModbusSerialUringLoop *m_pLoop = nullptr;
+    std::uint8_t    *m_pRxBuf = nullptr;
+    std::uint8_t    *m_pTxBuf = nullptr;
+    /// @brief bytes of completed input, and how many have been consumed.
+    std::size_t     m_nInput = 0;
+    std::size_t     m_iInput = 0;
+    /// @brief bytes to write, once the loop submits them.
+    std::size_t     m_nWrite = 0;
+    /// @brief result of the last write: bytes written, or -errno.
+    ssize_t         m_writeResult = 0;
+    bool            m_fReadBusy = false;
+    bool            m_fWriteQueued = false;
+    bool            m_fWriteBusy = false;
+    bool            m_fWriteDone = false;
+    bool            m_fReadFailed = false;
+    };
+
+} // namespace McciCatena
+
+#endif // defined(__linux__) && ! defined(ARDUINO) && defined(MCCI_MODBUS_SERIAL_IO_URING)
+
+#endif // _MCCI_Modbus_Serial_UringTransport_h_
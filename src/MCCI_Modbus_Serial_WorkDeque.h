@@ -0,0 +1,144 @@
+/*
+
+Module:  MCCI_Modbus_Serial_WorkDeque.h
+
+Function:
+    Lock-free work-stealing deque of task pointers.
+
+Copyright notice and License:
+    See LICENSE file accompanying this project.
+
+Author:
+    MCCI Corporation   October 2026
+
+*/
+
+#pragma once
+
+#ifndef _MCCI_Modbus_Serial_WorkDeque_h_
+# define _MCCI_Modbus_Serial_WorkDeque_h_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace McciCatena {
+
+/// @brief a fixed-size Chase-Lev deque: one owner thread pushes and takes
+///     tasks at the bottom, and any thread may steal from the top.
+///
+/// @tparam T is the task type; the deque holds pointers to tasks.
+/// @tparam a_nSlots is the capacity, a power of two.
+///
+/// The owner works LIFO, so the task it just queued (whose state is
+/// still in its cache) runs next; thieves take the oldest. Only the last
+/// task is contended, and that's settled with a single compare-exchange
+/// on the top counter. There's no growth: size it for the most tasks
+/// that can be queued at once.
+template <typename T, std::size_t a_nSlots>
+class ModbusSerialWorkDeque
+    {
+public:
+    static constexpr std::size_t kCapacity = a_nSlots;
+    static_assert(kCapacity > 0 && (kCapacity & (kCapacity - 1)) == 0, "deque size must be a power of two");
+
+    /// @brief keeps the owner's and the thieves' counters in separate
+    ///     cache lines.
+    static constexpr std::size_t knCacheLine = 64;
+
+    ModbusSerialWorkDeque() = default;
+    ModbusSerialWorkDeque(const ModbusSerialWorkDeque &) = delete;
+    ModbusSerialWorkDeque &operator=(const ModbusSerialWorkDeque &) = delete;
+
+    /// @brief true if there was nothing to take when last looked at; may
+    ///     be stale by the time it returns.
+    bool isEmpty() const
+        {
+        return this->m_nBottom.load(std::memory_order_relaxed) <=
+               this->m_nTop.load(std::memory_order_relaxed);
+        }
+
+    //---- owner side ----
+
+    /// @brief add a task at the bottom; false if the deque is full.
+    bool push(T *pTask)
+        {
+        std::int64_t const b = this->m_nBottom.load(std::memory_order_relaxed);
+        std::int64_t const t = this->m_nTop.load(std::memory_order_acquire);
+
+        if (b - t >= std::int64_t(kCapacity))
+            return false;
+
+        this->m_slots[b & (kCapacity - 1)].store(pTask, std::memory_order_relaxed);
+
+        // publish the slot (and the task) before the count that covers it.
+        this->m_nBottom.store(b + 1, std::memory_order_release);
+        return true;
+        }
+
+    /// @brief remove the newest task; nullptr if none.
+    T *take()
+        {
+        std::int64_t const b = this->m_nBottom.load(std::memory_order_relaxed) - 1;
+
+        // claim the bottom slot before looking at the top, so a thief
+        // can't take it at the same time without one of us seeing the
+        // other.
+        this->m_nBottom.store(b, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        std::int64_t t = this->m_nTop.load(std::memory_order_relaxed);
+
+        if (t > b)
+            {
+            this->m_nBottom.store(b + 1, std::memory_order_relaxed);
+            return nullptr;
+            }
+
+        T *pTask = this->m_slots[b & (kCapacity - 1)].load(std::memory_order_relaxed);
+        if (t == b)
+            {
+            // the last one: race the thieves for it.
+            if (! this->m_nTop.compare_exchange_strong(
+                        t, t + 1,
+                        std::memory_order_seq_cst,
+                        std::memory_order_relaxed))
+                pTask = nullptr;
+
+            this->m_nBottom.store(b + 1, std::memory_order_relaxed);
+            }
+
+        return pTask;
+        }
+
+    //---- any thread ----
+
+    /// @brief remove the oldest task; nullptr if none, or if another
+    ///     thread got it first.
+    T *steal()
+        {
+        std::int64_t t = this->m_nTop.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        std::int64_t const b = this->m_nBottom.load(std::memory_order_acquire);
+
+        if (t >= b)
+            return nullptr;
+
+        T * const pTask = this->m_slots[t & (kCapacity - 1)].load(std::memory_order_relaxed);
+        if (! this->m_nTop.compare_exchange_strong(
+                    t, t + 1,
+                    std::memory_order_seq_cst,
+                    std::memory_order_relaxed))
+            return nullptr;
+
+        return pTask;
+        }
+
+private:
+    alignas(knCacheLine) std::atomic<std::int64_t> m_nTop { 0 };
+    alignas(knCacheLine) std::atomic<std::int64_t> m_nBottom { 0 };
+    alignas(knCacheLine) std::atomic<T *> m_slots[kCapacity] {};
+    };
+
+} // namespace McciCatena
+
+#endif // _MCCI_Modbus_Serial_WorkDeque_h_
@@ -0,0 +1,322 @@
+/*
+
+Module:  MCCI_Modbus_Serial_Bus.cpp
+
+Function:
+    ModbusSerialBus scheduler.
+
+Copyright notice and License:
+    See LICENSE file accompanying this project.
+
+Author:
+    MCCI Corporation   October 2026
+
+*/
+
+#include "MCCI_Modbus_Serial_Bus.h"
+
+using namespace McciCatena;
+
+namespace {
+
+// a backlog this big means the device's queue is close to overflowing.
+constexpr std::uint32_t kUrgentBacklog = 3 * 2 * ModbusSerialProtocol::knRxDataReg / 4;
+
+} // namespace
+
+bool
+ModbusSerialBus::addHost(Host &host)
+    {
+    if (&host.getTransport() != &this->m_transport)
+        return false;
+    if (this->m_nHosts == knMaxHosts)
+        return false;
+    if (this->findSlot(host) != knMaxHosts)
+        return false;
+
+    Slot slot;
+
+    slot.pHost = &host;
+    this->m_slots[this->m_nHosts++] = slot;
+    return true;
+    }
+
+bool
+ModbusSerialBus::removeHost(Host &host)
+    {
+    if (host.isBusy())
+        return false;
+
+    std::size_t i = this->findSlot(host);
+    if (i == knMaxHosts)
+        return false;
+
+    for (--this->m_nHosts; i < this->m_nHosts; ++i)
+        this->m_slots[i] = this->m_slots[i + 1];
+
+    this->m_slots[this->m_nHosts] = Slot();
+    if (this->m_iCurrent >= this->m_nHosts)
+        this->m_iCurrent = 0;
+    if (this->m_iQuiet >= this->m_nHosts)
+        this->m_iQuiet = 0;
+    this->m_fNewVisit = true;
+    return true;
+    }
+
+bool
+ModbusSerialBus::setWeight(const Host &host, std::uint8_t weight)
+    {
+    auto const i = this->findSlot(host);
+
+    if (i == knMaxHosts)
+        return false;
+
+    this->m_slots[i].weight = weight != 0 ? weight : 1;
+    return true;
+    }
+
+std::size_t
+ModbusSerialBus::findSlot(const Host &host) const
+    {
+    for (std::size_t i = 0; i < this->m_nHosts; ++i)
+        {
+        if (this->m_slots[i].pHost == &host)
+            return i;
+        }
+
+    return knMaxHosts;
+    }
+
+void
+ModbusSerialBus::poll()
+    {
+    this->m_transport.poll();
+
+    auto const now = this->m_transport.getMicros();
+
+    // keep every host's transactions short enough for the tightest
+    // transmit deadline on the bus.
+    std::uint32_t bound = 0;
+    for (std::size_t i = 0; i < this->m_nHosts; ++i)
+        {
+        auto const hostBound = this->m_slots[i].pHost->getTxLatencyBound();
+
+        if (hostBound != 0 && (bound == 0 || hostBound < bound))
+            bound = hostBound;
+        }
+
+    // process whatever finished, charging each host for the bus time it
+    // used; a pipelined transport may complete several at once.
+    for (std::size_t i = 0; i < this->m_nHosts; ++i)
+        {
+        Slot &slot = this->m_slots[i];
+
+        slot.pHost->setBusLatencyBound(bound);
+        slot.pHost->updateTxArrivals(now);
+
+        if (slot.pHost->finishTransaction(now))
+            slot.deficit -= slot.pHost->getLastBusBytes();
+        }
+
+    // then keep the transport full.
+    while (this->m_transport.isReady())
+        {
+        Transaction *pTxn;
+        Host * const pHost = this->pickHost(now, pTxn);
+
+        if (pHost == nullptr || ! pHost->submitTransaction(*pTxn))
+            break;
+        }
+    }
+
+std::uint32_t
+ModbusSerialBus::getWakeDelay(std::uint32_t now) const
+    {
+    std::uint32_t delay = UINT32_MAX;
+
+    if (! this->m_transport.isReady())
+        return delay;
+
+    for (std::size_t i = 0; i < this->m_nHosts; ++i)
+        {
+        auto const hostDelay = this->m_slots[i].pHost->getWakeDelay(now);
+
+        if (hostDelay < delay)
+            delay = hostDelay;
+        }
+
+    return delay;
+    }
+
+// a host earns its budget the first time it's seen with backlog during a
+// visit -- possibly only after its first poll of the visit reveals the
+// backlog.
+void
+ModbusSerialBus::grantBudget(Slot &slot, std::uint32_t backlog)
+    {
+    slot.fGranted = true;
+
+    std::int32_t grant = std::int32_t(this->m_quantum * slot.weight);
+    if (backlog >= kUrgentBacklog)
+        grant *= 2;
+
+    // repay any overdraft, but don't let credit pile up.
+    slot.deficit += grant;
+    if (slot.deficit > grant)
+        slot.deficit = grant;
+    }
+
+void
+ModbusSerialBus::nextVisit()
+    {
+    if (++this->m_iCurrent >= this->m_nHosts)
+        this->m_iCurrent = 0;
+    this->m_fNewVisit = true;
+    }
+
+// pick the next host that needs the bus, and have it set up its
+// transaction.
+ModbusSerialBus::Host *
+ModbusSerialBus::pickHost(std::uint32_t now, Transaction *&pTxn)
+    {
+    if (this->m_nHosts == 0)
+        return nullptr;
+
+    // output with a deadline goes first.
+    Host * const pUrgent = this->pickUrgentHost(now, pTxn);
+    if (pUrgent != nullptr)
+        return pUrgent;
+
+    // alternate between hosts without backlog (whose transactions are
+    // short polls) and the deficit round-robin, so a quiet device never
+    // waits behind a whole round of full-window reads.
+    this->m_fQuietTurn = ! this->m_fQuietTurn;
+    if (this->m_fQuietTurn)
+        {
+        Host * const pHost = this->pickQuietHost(now, pTxn);
+
+        if (pHost != nullptr)
+            return pHost;
+        }
+
+    // visit each host at most once, plus a return to where we started.
+    for (std::size_t n = 0; n <= this->m_nHosts; ++n)
+        {
+        Slot &slot = this->m_slots[this->m_iCurrent];
+        bool fFirst = false;
+
+        if (this->m_fNewVisit)
+            {
+            // a host that is idle at the start of its visit forfeits any
+            // credit left over.
+            this->m_fNewVisit = false;
+            fFirst = true;
+            slot.fGranted = false;
+            if (slot.pHost->getBacklog() == 0)
+                slot.deficit = 0;
+            }
+
+        auto const backlog = slot.pHost->getBacklog();
+        if (backlog != 0 && ! slot.fGranted)
+            this->grantBudget(slot, backlog);
+
+        // every host gets one transaction per visit, for polls and
+        // discovery; a backlogged host keeps the bus while it has budget.
+        if (fFirst || (backlog != 0 && slot.deficit > 0))
+            {
+            pTxn = slot.pHost->startTransaction(now, false);
+            if (pTxn != nullptr)
+                return slot.pHost;
+            }
+
+        this->nextVisit();
+        }
+
+    if (this->m_fEagerPolling)
+        return this->pickEarlyPoll(now, pTxn);
+
+    return nullptr;
+    }
+
+// pick the host whose output deadline is nearest, if that deadline
+// can't wait for a long transaction by someone else.
+ModbusSerialBus::Host *
+ModbusSerialBus::pickUrgentHost(std::uint32_t now, Transaction *&pTxn)
+    {
+    Host *pBest = nullptr;
+    std::int32_t bestSlack = 0;
+
+    for (std::size_t i = 0; i < this->m_nHosts; ++i)
+        {
+        Host * const pHost = this->m_slots[i].pHost;
+
+        if (! pHost->isTxUrgent(now))
+            continue;
+
+        auto const slack = pHost->getTxSlack(now);
+        if (pBest == nullptr || slack < bestSlack)
+            {
+            pBest = pHost;
+            bestSlack = slack;
+            }
+        }
+
+    if (pBest == nullptr)
+        return nullptr;
+
+    pTxn = pBest->startTransaction(now, false);
+    return pTxn != nullptr ? pBest : nullptr;
+    }
+
+// round-robin among the hosts with no backlog that want the bus.
+ModbusSerialBus::Host *
+ModbusSerialBus::pickQuietHost(std::uint32_t now, Transaction *&pTxn)
+    {
+    for (std::size_t n = 0; n < this->m_nHosts; ++n)
+        {
+        std::size_t const i = this->m_iQuiet;
+        Host * const pHost = this->m_slots[i].pHost;
+
+        if (++this->m_iQuiet >= this->m_nHosts)
+            this->m_iQuiet = 0;
+
+        if (pHost->getBacklog() != 0)
+            continue;
+
+        pTxn = pHost->startTransaction(now, false);
+        if (pTxn != nullptr)
+            return pHost;
+        }
+
+    return nullptr;
+    }
+
+// nobody needs the bus: poll the idle host whose timer is nearest to
+// running out.
+ModbusSerialBus::Host *
+ModbusSerialBus::pickEarlyPoll(std::uint32_t now, Transaction *&pTxn)
+    {
+    Host *pBest = nullptr;
+    std::int32_t bestDelay = 0;
+
+    for (std::size_t i = 0; i < this->m_nHosts; ++i)
+        {
+        Host * const pHost = this->m_slots[i].pHost;
+
+        if (pHost->isBusy() || pHost->getState() != Host::State::stIdle)
+            continue;
+
+        auto const delay = pHost->getPollDelay(now);
+        if (pBest == nullptr || delay < bestDelay)
+            {
+            pBest = pHost;
+            bestDelay = delay;
+            }
+        }
+
+    if (pBest == nullptr)
+        return nullptr;
+
+    pTxn = pBest->startTransaction(now, true);
+    return pTxn != nullptr ? pBest : nullptr;
+    }
@@ -0,0 +1,548 @@
+/*
+
+Module:  MCCI_Modbus_Serial_BusExecutor.cpp
+
+Function:
+    ModbusSerialBusExecutor.
+
+Copyright notice and License:
+    See LICENSE file accompanying this project.
+
+Author:
+    MCCI Corporation   October 2026
+
+*/
+
+#include "MCCI_Modbus_Serial_BusExecutor.h"
+
+#if defined(__linux__) && ! defined(ARDUINO)
+
+#include <cerrno>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/timerfd.h>
+#include <unistd.h>
+
+using namespace McciCatena;
+
+namespace {
+
+// epoll data for a task's fds is its index, shifted, plus one of these.
+constexpr std::uint64_t kEventPort = 0;
+constexpr std::uint64_t kEventTimer = 1;
+
+// and for the executor's own.
+constexpr std::uint64_t kEventWake = UINT64_MAX - 1;
+constexpr std::uint64_t kEventStop = UINT64_MAX;
+
+// events taken from epoll at once. Few, so that one worker doesn't pick
+// up everything that's ready while the others sleep.
+constexpr int knMaxEvents = 8;
+
+void writeEvent(int fd)
+    {
+    std::uint64_t const one = 1;
+    (void) ::write(fd, &one, sizeof(one));
+    }
+
+void closeFd(int &fd)
+    {
+    if (fd >= 0)
+        {
+        ::close(fd);
+        fd = -1;
+        }
+    }
+
+} // namespace
+
+void
+ModbusSerialBusExecutor::Task::wake()
+    {
+    this->pOwner->notify(*this, nullptr);
+    }
+
+bool
+ModbusSerialBusExecutor::add(Port &port, Bus &bus)
+    {
+    if (this->isRunning() || this->m_nTasks == knMaxBuses || port.getFd() < 0)
+        return false;
+    if (&bus.getTransport() != &port || this->findTask(bus) != nullptr)
+        return false;
+
+    Task &task = this->m_tasks[this->m_nTasks++];
+
+    task.pOwner = this;
+    task.pPort = &port;
+    task.pBus = &bus;
+    task.pBindings = nullptr;
+    return true;
+    }
+
+bool
+ModbusSerialBusExecutor::add(Bus &bus, Host &host, Client &client, std::uint32_t baudrate)
+    {
+    if (this->isRunning() || this->m_nBindings == knMaxBindings || client.m_pWaker != nullptr)
+        return false;
+
+    Task * const pTask = this->findTask(bus);
+    if (pTask == nullptr || ! bus.addHost(host))
+        return false;
+
+    if (! host.begin(client, baudrate))
+        {
+        bus.removeHost(host);
+        return false;
+        }
+
+    client.m_pWaker = pTask;
+
+    Binding &binding = this->m_bindings[this->m_nBindings++];
+    binding.pHost = &host;
+    binding.pClient = &client;
+    binding.pNext = pTask->pBindings;
+    pTask->pBindings = &binding;
+    return true;
+    }
+
+ModbusSerialBusExecutor::Task *
+ModbusSerialBusExecutor::findTask(const Bus &bus)
+    {
+    for (std::size_t i = 0; i < this->m_nTasks; ++i)
+        {
+        if (this->m_tasks[i].pBus == &bus)
+            return &this->m_tasks[i];
+        }
+    return nullptr;
+    }
+
+bool
+ModbusSerialBusExecutor::begin(std::size_t nWorkers, int firstCpu)
+    {
+    if (this->isRunning() || nWorkers == 0 || nWorkers > knMaxWorkers)
+        return false;
+
+    this->m_pWorkers.reset(new Worker[nWorkers]);
+    if (! this->setup())
+        {
+        this->teardown();
+        return false;
+        }
+
+    // every bus runs once to start, spread across the workers; that
+    // covers any wakeups from before now.
+    this->m_pInjected.store(nullptr, std::memory_order_relaxed);
+    for (std::size_t i = 0; i < this->m_nTasks; ++i)
+        {
+        this->m_tasks[i].state.store(Task::Queued, std::memory_order_relaxed);
+        this->m_pWorkers[i % nWorkers].deque.push(&this->m_tasks[i]);
+        }
+
+    this->m_nWorkers = nWorkers;
+
+    for (std::size_t i = 0; i < nWorkers; ++i)
+        {
+        auto &worker = this->m_pWorkers[i];
+
+        worker.iVictim = i + 1;
+        int const cpu = firstCpu >= 0 ? firstCpu + int(i) : -1;
+
+        if (! ModbusSerialThreadControl::start(worker.thread, [this, i] { this->run(i); }, cpu))
+            {
+            this->end();
+            return false;
+            }
+        }
+
+    return true;
+    }
+
+// create the epoll instance and the timers, and register every fd.
+bool
+ModbusSerialBusExecutor::setup()
+    {
+    if (! this->m_control.begin(true))
+        return false;
+
+    this->m_epollFd = ::epoll_create1(EPOLL_CLOEXEC);
+    this->m_wakeFd = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (this->m_epollFd < 0 || this->m_wakeFd < 0)
+        return false;
+
+    // a wakeup is for one worker, and is edge-triggered so it's taken
+    // only once; the stop is level-triggered, so every worker sees it.
+    epoll_event ev {};
+    ev.events = EPOLLIN | EPOLLET;
+    ev.data.u64 = kEventWake;
+    if (::epoll_ctl(this->m_epollFd, EPOLL_CTL_ADD, this->m_wakeFd, &ev) != 0)
+        return false;
+
+    ev.events = EPOLLIN;
+    ev.data.u64 = kEventStop;
+    if (::epoll_ctl(this->m_epollFd, EPOLL_CTL_ADD, this->m_control.getStopFd(), &ev) != 0)
+        return false;
+
+    for (std::size_t i = 0; i < this->m_nTasks; ++i)
+        {
+        Task &task = this->m_tasks[i];
+
+        task.timerFd = ::timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+        task.fTimerArmed = false;
+        if (task.timerFd < 0)
+            return false;
+
+        // edge-triggered: the task drains the port each time it runs,
+        // and a timer that has gone off is simply set again.
+        ev.events = EPOLLIN | EPOLLET;
+        ev.data.u64 = (std::uint64_t(i) << 1) | kEventTimer;
+        if (::epoll_ctl(this->m_epollFd, EPOLL_CTL_ADD, task.timerFd, &ev) != 0)
+            return false;
+
+        task.events = EPOLLIN | EPOLLET;
+        ev.events = task.events;
+        ev.data.u64 = (std::uint64_t(i) << 1) | kEventPort;
+        if (::epoll_ctl(this->m_epollFd, EPOLL_CTL_ADD, task.pPort->getFd(), &ev) != 0)
+            return false;
+        }
+
+    return true;
+    }
+
+void
+ModbusSerialBusExecutor::teardown()
+    {
+    for (std::size_t i = 0; i < this->m_nTasks; ++i)
+        {
+        Task &task = this->m_tasks[i];
+
+        if (task.pPort->getFd() >= 0 && this->m_epollFd >= 0)
+            (void) ::epoll_ctl(this->m_epollFd, EPOLL_CTL_DEL, task.pPort->getFd(), nullptr);
+        closeFd(task.timerFd);
+        task.pNextInjected = nullptr;
+        task.state.store(Task::Idle, std::memory_order_relaxed);
+        }
+
+    closeFd(this->m_epollFd);
+    closeFd(this->m_wakeFd);
+    this->m_control.end();
+
+    this->m_pInjected.store(nullptr, std::memory_order_relaxed);
+    this->m_nSleeping.store(0, std::memory_order_relaxed);
+    this->m_pWorkers.reset();
+    }
+
+void
+ModbusSerialBusExecutor::end()
+    {
+    if (this->m_pWorkers == nullptr)
+        return;
+
+    this->m_control.requestStop();
+    for (std::size_t i = 0; i < this->m_nWorkers; ++i)
+        ModbusSerialThreadControl::join(this->m_pWorkers[i].thread);
+
+    this->m_nWorkers = 0;
+    this->teardown();
+    }
+
+std::uint64_t
+ModbusSerialBusExecutor::getRunCount() const
+    {
+    std::uint64_t n = 0;
+
+    for (std::size_t i = 0; i < this->m_nWorkers; ++i)
+        n += this->m_pWorkers[i].nRuns.load(std::memory_order_relaxed);
+    return n;
+    }
+
+std::uint64_t
+ModbusSerialBusExecutor::getStealCount() const
+    {
+    std::uint64_t n = 0;
+
+    for (std::size_t i = 0; i < this->m_nWorkers; ++i)
+        n += this->m_pWorkers[i].nSteals.load(std::memory_order_relaxed);
+    return n;
+    }
+
+void
+ModbusSerialBusExecutor::run(std::size_t iWorker)
+    {
+    Worker &self = this->m_pWorkers[iWorker];
+
+    while (! this->m_control.isStopRequested())
+        {
+        Task * const pTask = this->findWork(iWorker);
+
+        if (pTask != nullptr)
+            this->execute(*pTask, self);
+        else
+            this->wait(self);
+        }
+    }
+
+// our own newest task, else whatever application threads made ready,
+// else someone else's oldest.
+ModbusSerialBusExecutor::Task *
+ModbusSerialBusExecutor::findWork(std::size_t iWorker)
+    {
+    Worker &self = this->m_pWorkers[iWorker];
+    Task *pTask = self.deque.take();
+
+    if (pTask == nullptr)
+        pTask = this->popInjected(self);
+    if (pTask == nullptr)
+        pTask = this->steal(iWorker);
+
+    return pTask;
+    }
+
+ModbusSerialBusExecutor::Task *
+ModbusSerialBusExecutor::steal(std::size_t iWorker)
+    {
+    Worker &self = this->m_pWorkers[iWorker];
+
+    for (std::size_t n = 0; n < this->m_nWorkers; ++n)
+        {
+        std::size_t const iVictim = (self.iVictim + n) % this->m_nWorkers;
+        if (iVictim == iWorker)
+            continue;
+
+        Worker &victim = this->m_pWorkers[iVictim];
+        Task * const pTask = victim.deque.steal();
+        if (pTask == nullptr)
+            continue;
+
+        // start with the same victim next time; and if it has still
+        // more, get another sleeper to help.
+        self.iVictim = iVictim;
+        self.nSteals.fetch_add(1, std::memory_order_relaxed);
+        if (! victim.deque.isEmpty())
+            this->wakeSleeper();
+        return pTask;
+        }
+
+    return nullptr;
+    }
+
+// move everything application threads made ready onto our own deque,
+// and take one.
+ModbusSerialBusExecutor::Task *
+ModbusSerialBusExecutor::popInjected(Worker &self)
+    {
+    if (this->m_pInjected.load(std::memory_order_relaxed) == nullptr)
+        return nullptr;
+
+    Task *pTask = this->m_pInjected.exchange(nullptr, std::memory_order_acquire);
+    if (pTask == nullptr)
+        return nullptr;
+
+    for (Task *pNext = pTask->pNextInjected; pNext != nullptr; )
+        {
+        Task * const pThis = pNext;
+
+        pNext = pThis->pNextInjected;
+        self.deque.push(pThis);
+        }
+
+    if (! self.deque.isEmpty())
+        this->wakeSleeper();
+    return pTask;
+    }
+
+// sleep until something happens, and queue the tasks it makes ready.
+void
+ModbusSerialBusExecutor::wait(Worker &self)
+    {
+    // count ourselves as sleeping before the last look for work, so a
+    // thread that queues work after that look knows to wake someone.
+    this->m_nSleeping.fetch_add(1, std::memory_order_seq_cst);
+
+    std::size_t const iWorker = std::size_t(&self - this->m_pWorkers.get());
+    if (Task * const pTask = this->findWork(iWorker))
+        {
+        this->m_nSleeping.fetch_sub(1, std::memory_order_relaxed);
+        this->execute(*pTask, self);
+        return;
+        }
+
+    epoll_event events[knMaxEvents];
+    int n;
+
+    do  {
+        n = ::epoll_wait(this->m_epollFd, events, knMaxEvents, -1);
+        } while (n < 0 && errno == EINTR);
+
+    this->m_nSleeping.fetch_sub(1, std::memory_order_relaxed);
+
+    for (int i = 0; i < n; ++i)
+        {
+        auto const data = events[i].data.u64;
+
+        if (data == kEventWake)
+            {
+            std::uint64_t count;
+            (void) ::read(this->m_wakeFd, &count, sizeof(count));
+            }
+        else if (data != kEventStop)
+            this->notify(this->m_tasks[data >> 1], &self);
+        }
+
+    if (n > 1 && ! self.deque.isEmpty())
+        this->wakeSleeper();
+    }
+
+// make a task ready. pSelf is the worker calling, if it's a worker.
+void
+ModbusSerialBusExecutor::notify(Task &task, Worker *pSelf)
+    {
+    // pairs with the fence in execute(): either we see Running and ask
+    // for a rerun, or the bus's poll() sees what the caller just did.
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    std::uint8_t state = task.state.load(std::memory_order_seq_cst);
+
+    for (;;)
+        {
+        std::uint8_t next;
+
+        if (state == Task::Idle)
+            next = Task::Queued;
+        else if (state == Task::Running)
+            next = Task::Rerun;
+        else
+            return;
+
+        if (task.state.compare_exchange_weak(state, next, std::memory_order_acq_rel, std::memory_order_acquire))
+            break;
+        }
+
+    // if it was running, whoever is running it will queue it again.
+    if (state != Task::Idle)
+        return;
+
+    if (pSelf != nullptr)
+        pSelf->deque.push(&task);
+    else
+        this->inject(task);
+    }
+
+// queue a task from an application thread; the workers' deques are
+// only pushed by their owners.
+void
+ModbusSerialBusExecutor::inject(Task &task)
+    {
+    Task *pHead = this->m_pInjected.load(std::memory_order_relaxed);
+
+    do  {
+        task.pNextInjected = pHead;
+        } while (! this->m_pInjected.compare_exchange_weak(
+                        pHead, &task,
+                        std::memory_order_seq_cst,
+                        std::memory_order_relaxed));
+
+    this->wakeSleeper();
+    }
+
+// if any worker is asleep, wake one.
+void
+ModbusSerialBusExecutor::wakeSleeper()
+    {
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (this->m_nSleeping.load(std::memory_order_seq_cst) != 0)
+        writeEvent(this->m_wakeFd);
+    }
+
+void
+ModbusSerialBusExecutor::execute(Task &task, Worker &self)
+    {
+    // Running has to be visible before poll() looks at the clients, or
+    // a notify() that lands in between could see the task still Queued,
+    // do nothing, and leave its work for no one.
+    task.state.store(Task::Running, std::memory_order_seq_cst);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+
+    task.pBus->poll();
+    this->publish(task);
+    self.nRuns.fetch_add(1, std::memory_order_relaxed);
+
+    auto const now = task.pPort->getMicros();
+    auto delay = task.pPort->getWakeDelay(now);
+    auto const busDelay = task.pBus->getWakeDelay(now);
+
+    if (busDelay < delay)
+        delay = busDelay;
+
+    (void) this->updateEvents(task);
+
+    // something due now, or an event while we were running: go again,
+    // here, so the bus's work stays on one thread while it's busy.
+    std::uint8_t state = Task::Running;
+    if (delay != 0 &&
+        this->updateTimer(task, delay, now) &&
+        task.state.compare_exchange_strong(state, Task::Idle, std::memory_order_acq_rel, std::memory_order_relaxed))
+        return;
+
+    task.state.store(Task::Queued, std::memory_order_relaxed);
+    self.deque.push(&task);
+    }
+
+// ask for EPOLLOUT only while a request is stuck behind a full buffer.
+bool
+ModbusSerialBusExecutor::updateEvents(Task &task)
+    {
+    std::uint32_t const events = task.pPort->isWritePending()
+                                    ? EPOLLIN | EPOLLOUT | EPOLLET
+                                    : EPOLLIN | EPOLLET;
+
+    if (events == task.events)
+        return true;
+
+    epoll_event ev {};
+    ev.events = events;
+    ev.data.u64 = (std::uint64_t(&task - this->m_tasks) << 1) | kEventPort;
+    if (::epoll_ctl(this->m_epollFd, EPOLL_CTL_MOD, task.pPort->getFd(), &ev) != 0)
+        return false;
+
+    task.events = events;
+    return true;
+    }
+
+// make sure the timer goes off within delay microseconds. A timer that
+// would go off sooner is left alone: running early is harmless, and it
+// saves a system call per run. Returns false if the timer can't be set.
+bool
+ModbusSerialBusExecutor::updateTimer(Task &task, std::uint32_t delay, std::uint32_t now)
+    {
+    if (delay == UINT32_MAX)
+        return true;
+
+    std::uint32_t const tWake = now + delay;
+
+    if (task.fTimerArmed &&
+        std::int32_t(task.tTimer - now) > 0 &&
+        std::int32_t(task.tTimer - tWake) <= 0)
+        return true;
+
+    itimerspec its {};
+    its.it_value.tv_sec = delay / 1000000u;
+    its.it_value.tv_nsec = long(delay % 1000000u) * 1000;
+    if (::timerfd_settime(task.timerFd, 0, &its, nullptr) != 0)
+        return false;
+
+    task.tTimer = tWake;
+    task.fTimerArmed = true;
+    return true;
+    }
+
+// tell the clients what their hosts last learned from the devices.
+void
+ModbusSerialBusExecutor::publish(const Task &task)
+    {
+    for (auto pBinding = task.pBindings; pBinding != nullptr; pBinding = pBinding->pNext)
+        {
+        pBinding->pClient->m_status.store(pBinding->pHost->getLastStatus().getBits(), std::memory_order_relaxed);
+        pBinding->pClient->m_fOperating.store(pBinding->pHost->isOperating(), std::memory_order_relaxed);
+        }
+    }
+
+#endif // defined(__linux__) && ! defined(ARDUINO)
@@ -0,0 +1,105 @@
+/*
+
+Module:  MCCI_Modbus_Serial_BusWorker.cpp
+
+Function:
+    ModbusSerialBusWorker.
+
+Copyright notice and License:
+    See LICENSE file accompanying this project.
+
+Author:
+    MCCI Corporation   October 2026
+
+*/
+
+#include "MCCI_Modbus_Serial_BusWorker.h"
+
+#if defined(__linux__) && ! defined(ARDUINO)
+
+using namespace McciCatena;
+
+bool
+ModbusSerialBusWorker::add(Host &host, Client &client, std::uint32_t baudrate)
+    {
+    if (this->isRunning() || this->m_nBindings == knMaxHosts || client.m_pWaker != nullptr)
+        return false;
+
+    if (! this->m_bus.addHost(host))
+        return false;
+
+    if (! host.begin(client, baudrate))
+        {
+        this->m_bus.removeHost(host);
+        return false;
+        }
+
+    client.m_pWaker = this;
+    this->m_bindings[this->m_nBindings].pHost = &host;
+    this->m_bindings[this->m_nBindings].pClient = &client;
+    ++this->m_nBindings;
+    return true;
+    }
+
+bool
+ModbusSerialBusWorker::begin(int cpu)
+    {
+    if (this->isRunning())
+        return false;
+
+    if (! this->m_control.begin(false) ||
+        ! this->m_loop.begin() || ! this->m_loop.add(this->m_port, this->m_bus))
+        {
+        this->m_loop.end();
+        return false;
+        }
+
+    if (! ModbusSerialThreadControl::start(this->m_thread, [this] { this->run(); }, cpu))
+        {
+        this->end();
+        return false;
+        }
+
+    return true;
+    }
+
+void
+ModbusSerialBusWorker::end()
+    {
+    if (this->isRunning())
+        {
+        this->m_control.requestStop();
+        this->m_loop.wake();
+        ModbusSerialThreadControl::join(this->m_thread);
+        }
+
+    this->m_loop.end();
+    this->m_control.end();
+    }
+
+void
+ModbusSerialBusWorker::run()
+    {
+    while (! this->m_control.isStopRequested())
+        {
+        if (! this->m_loop.run())
+            break;
+
+        this->publish();
+        }
+    }
+
+// tell the clients what their hosts last learned from the devices.
+void
+ModbusSerialBusWorker::publish()
+    {
+    for (std::size_t i = 0; i < this->m_nBindings; ++i)
+        {
+        auto const &binding = this->m_bindings[i];
+
+        binding.pClient->m_status.store(binding.pHost->getLastStatus().getBits(), std::memory_order_relaxed);
+        binding.pClient->m_fOperating.store(binding.pHost->isOperating(), std::memory_order_relaxed);
+        }
+    }
+
+#endif // defined(__linux__) && ! defined(ARDUINO)
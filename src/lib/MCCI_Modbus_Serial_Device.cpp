@@ -0,0 +1,184 @@
+/*
+
+Module:  MCCI_Modbus_Serial_Device.cpp
+
+Function:
+    ModbusSerialDevice register handlers.
+
+Copyright notice and License:
+    See LICENSE file accompanying this project.
+
+Author:
+    MCCI Corporation   October 2026
+
+*/
+
+#include "MCCI_Modbus_Serial_Device.h"
+
+using namespace McciCatena;
+
+namespace {
+
+using Protocol = ModbusSerialProtocol;
+using Register = ModbusSerialProtocol::Register;
+
+constexpr std::uint16_t kDummyHi    = Protocol::getAddress(Register::DummyReg_i32);
+constexpr std::uint16_t kDummyLo    = kDummyHi + 1;
+constexpr std::uint16_t kBaudHi     = Protocol::getAddress(Register::Baudrate_i32);
+constexpr std::uint16_t kBaudLo     = kBaudHi + 1;
+constexpr std::uint16_t kStatus     = Protocol::getAddress(Register::Status_u16);
+constexpr std::uint16_t kRxFirst    = Protocol::getAddress(Register::RxData0_u16);
+constexpr std::uint16_t kRxLast     = Protocol::getAddress(Register::RxDataLast_u16);
+constexpr std::uint16_t kTxFirst    = Protocol::getAddress(Register::TxData0_u16);
+constexpr std::uint16_t kTxLast     = Protocol::getAddress(Register::TxDataLast_u16);
+constexpr std::uint16_t kTxByte     = Protocol::getAddress(Register::TxDataByte_u16);
+
+} // namespace
+
+ModbusSerialDevice::StatusBits
+ModbusSerialDevice::getStatus() const
+    {
+    StatusBits status;
+
+    status.setInputAvail(std::uint8_t(this->m_rxQueue.available()));
+    status.setTxAvail(std::uint8_t(this->m_txQueue.space()));
+    status.setTxEmpty(this->m_txQueue.isEmpty());
+    status.setConnected(this->m_fConnected);
+
+    return status;
+    }
+
+ModbusSerialDevice::Exception
+ModbusSerialDevice::readRegisters(
+    std::uint16_t address,
+    std::uint16_t nRegs,
+    std::uint16_t *pRegs
+    )
+    {
+    if (nRegs == 0 || nRegs > knMaxReadRegs)
+        return Exception::IllegalDataValue;
+    if (std::uint32_t(address) + nRegs > 0x10000u)
+        return Exception::IllegalDataAddress;
+
+    // registers are processed in order, so a Status image taken ahead of
+    // RxData reflects the queue before this read consumed anything.
+    for (; nRegs > 0; --nRegs)
+        *pRegs++ = this->readRegister(address++);
+
+    return Exception::None;
+    }
+
+std::uint16_t
+ModbusSerialDevice::readRegister(std::uint16_t address)
+    {
+    switch (address)
+        {
+    case kBaudHi:
+        return std::uint16_t(this->m_baudrate >> 16);
+    case kBaudLo:
+        return std::uint16_t(this->m_baudrate);
+    case kStatus:
+        return this->getStatus().getBits();
+    case kDummyHi:
+    case kDummyLo:
+    default:
+        break;
+        }
+
+    if (kRxFirst <= address && address <= kRxLast)
+        {
+        // high-order byte is the first character; missing characters
+        // read as zero.
+        std::uint8_t buf[2] = { 0, 0 };
+
+        this->m_rxQueue.get(buf, sizeof(buf));
+        return std::uint16_t((buf[0] << 8) | buf[1]);
+        }
+
+    // DummyReg, TxData and undefined registers all read as zero.
+    return 0;
+    }
+
+ModbusSerialDevice::Exception
+ModbusSerialDevice::writeRegisters(
+    std::uint16_t address,
+    std::uint16_t nRegs,
+    const std::uint16_t *pRegs
+    )
+    {
+    if (nRegs == 0 || nRegs > knMaxWriteRegs)
+        return Exception::IllegalDataValue;
+    if (std::uint32_t(address) + nRegs > 0x10000u)
+        return Exception::IllegalDataAddress;
+
+    bool fBaudrate = false;
+
+    for (; nRegs > 0; --nRegs)
+        fBaudrate |= this->writeRegister(address++, *pRegs++);
+
+    if (fBaudrate)
+        this->notifyBaudrate(this->m_baudrate);
+
+    return Exception::None;
+    }
+
+ModbusSerialDevice::Exception
+ModbusSerialDevice::readWriteRegisters(
+    std::uint16_t readAddress,
+    std::uint16_t nReadRegs,
+    std::uint16_t *pReadRegs,
+    std::uint16_t writeAddress,
+    std::uint16_t nWriteRegs,
+    const std::uint16_t *pWriteRegs
+    )
+    {
+    if (! this->m_fReadWriteEnabled)
+        return Exception::IllegalFunction;
+
+    // check everything before touching anything, so that an exception
+    // means nothing happened.
+    if (nReadRegs == 0 || nReadRegs > knMaxReadRegs ||
+        nWriteRegs == 0 || nWriteRegs > knMaxReadWriteWriteRegs)
+        return Exception::IllegalDataValue;
+    if (std::uint32_t(readAddress) + nReadRegs > 0x10000u ||
+        std::uint32_t(writeAddress) + nWriteRegs > 0x10000u)
+        return Exception::IllegalDataAddress;
+
+    // the Modbus spec says the write happens first.
+    auto const e = this->writeRegisters(writeAddress, nWriteRegs, pWriteRegs);
+    if (e != Exception::None)
+        return e;
+
+    return this->readRegisters(readAddress, nReadRegs, pReadRegs);
+    }
+
+// returns true if the baud rate register was touched.
+bool
+ModbusSerialDevice::writeRegister(std::uint16_t address, std::uint16_t value)
+    {
+    switch (address)
+        {
+    case kBaudHi:
+        this->m_baudrate = (this->m_baudrate & 0xFFFFu) | (std::uint32_t(value) << 16);
+        return true;
+    case kBaudLo:
+        this->m_baudrate = (this->m_baudrate & 0xFFFF0000u) | value;
+        return true;
+    case kTxByte:
+        // only the high-order byte is used.
+        this->m_txQueue.put(std::uint8_t(value >> 8));
+        return false;
+    default:
+        break;
+        }
+
+    if (kTxFirst <= address && address <= kTxLast)
+        {
+        // characters that don't fit are discarded.
+        this->m_txQueue.put(std::uint8_t(value >> 8));
+        this->m_txQueue.put(std::uint8_t(value));
+        }
+
+    // writes to read-only and undefined registers are ignored.
+    return false;
+    }
@@ -0,0 +1,263 @@
+/*
+
+Module:  MCCI_Modbus_Serial_EventLoop.cpp
+
+Function:
+    ModbusSerialEventLoop.
+
+Copyright notice and License:
+    See LICENSE file accompanying this project.
+
+Author:
+    MCCI Corporation   October 2026
+
+*/
+
+#include "MCCI_Modbus_Serial_EventLoop.h"
+
+#if defined(__linux__) && ! defined(ARDUINO)
+
+#include <cerrno>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/timerfd.h>
+#include <unistd.h>
+
+using namespace McciCatena;
+
+bool
+ModbusSerialEventLoop::begin()
+    {
+    this->end();
+
+    this->m_epollFd = ::epoll_create1(EPOLL_CLOEXEC);
+    this->m_timerFd = ::timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+    this->m_wakeFd = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+
+    // the timer and wakeup events are told apart from the ports' by
+    // their data pointers.
+    epoll_event evTimer {};
+    evTimer.events = EPOLLIN;
+    evTimer.data.ptr = &this->m_timerFd;
+
+    epoll_event evWake {};
+    evWake.events = EPOLLIN;
+    evWake.data.ptr = &this->m_wakeFd;
+
+    if (this->m_epollFd < 0 || this->m_timerFd < 0 || this->m_wakeFd < 0 ||
+        ::epoll_ctl(this->m_epollFd, EPOLL_CTL_ADD, this->m_timerFd, &evTimer) != 0 ||
+        ::epoll_ctl(this->m_epollFd, EPOLL_CTL_ADD, this->m_wakeFd, &evWake) != 0)
+        {
+        this->end();
+        return false;
+        }
+
+    return true;
+    }
+
+void
+ModbusSerialEventLoop::end()
+    {
+    for (auto &entry : this->m_entries)
+        entry = Entry();
+
+    if (this->m_timerFd >= 0)
+        {
+        ::close(this->m_timerFd);
+        this->m_timerFd = -1;
+        }
+    if (this->m_wakeFd >= 0)
+        {
+        ::close(this->m_wakeFd);
+        this->m_wakeFd = -1;
+        }
+    if (this->m_epollFd >= 0)
+        {
+        ::close(this->m_epollFd);
+        this->m_epollFd = -1;
+        }
+    }
+
+bool
+ModbusSerialEventLoop::add(Port &port, Bus *pBus, Host *pHost)
+    {
+    if (this->m_epollFd < 0 || port.getFd() < 0)
+        return false;
+
+    for (auto &entry : this->m_entries)
+        {
+        if (entry.pPort == &port)
+            return false;
+        }
+
+    for (auto &entry : this->m_entries)
+        {
+        if (entry.pPort != nullptr)
+            continue;
+
+        epoll_event ev {};
+        ev.events = EPOLLIN;
+        ev.data.ptr = &entry;
+        if (::epoll_ctl(this->m_epollFd, EPOLL_CTL_ADD, port.getFd(), &ev) != 0)
+            return false;
+
+        entry.pPort = &port;
+        entry.pBus = pBus;
+        entry.pHost = pHost;
+        entry.events = EPOLLIN;
+        entry.fReady = true;
+        entry.tLastPoll = port.getMicros();
+        return true;
+        }
+
+    return false;
+    }
+
+bool
+ModbusSerialEventLoop::remove(const Port &port)
+    {
+    for (auto &entry : this->m_entries)
+        {
+        if (entry.pPort == &port)
+            {
+            (void) ::epoll_ctl(this->m_epollFd, EPOLL_CTL_DEL, port.getFd(), nullptr);
+            entry = Entry();
+            return true;
+            }
+        }
+    return false;
+    }
+
+// ask for EPOLLOUT only while a request is stuck behind a full buffer.
+bool
+ModbusSerialEventLoop::updateEvents(Entry &entry)
+    {
+    std::uint32_t const events = entry.pPort->isWritePending() ? EPOLLIN | EPOLLOUT : EPOLLIN;
+
+    if (events == entry.events)
+        return true;
+
+    epoll_event ev {};
+    ev.events = events;
+    ev.data.ptr = &entry;
+    if (::epoll_ctl(this->m_epollFd, EPOLL_CTL_MOD, entry.pPort->getFd(), &ev) != 0)
+        return false;
+
+    entry.events = events;
+    return true;
+    }
+
+std::uint32_t
+ModbusSerialEventLoop::getWakeDelay(const Entry &entry, std::uint32_t now) const
+    {
+    auto delay = entry.pPort->getWakeDelay(now);
+    auto const sinceLastPoll = now - entry.tLastPoll;
+    auto const tickDelay = sinceLastPoll >= this->m_tick ? 0 : this->m_tick - sinceLastPoll;
+
+    return tickDelay < delay ? tickDelay : delay;
+    }
+
+bool
+ModbusSerialEventLoop::run(std::uint32_t maxWait)
+    {
+    if (this->m_epollFd < 0)
+        return false;
+
+    auto timeout = maxWait;
+
+    for (auto &entry : this->m_entries)
+        {
+        if (entry.pPort == nullptr)
+            continue;
+        if (! this->updateEvents(entry))
+            return false;
+
+        auto const delay = entry.fReady ? 0 : this->getWakeDelay(entry, entry.pPort->getMicros());
+        if (delay < timeout)
+            timeout = delay;
+        }
+
+    if (! this->wait(timeout))
+        return false;
+
+    for (auto &entry : this->m_entries)
+        {
+        if (entry.pPort == nullptr)
+            continue;
+
+        auto const now = entry.pPort->getMicros();
+        if (! entry.fReady && this->getWakeDelay(entry, now) != 0)
+            continue;
+
+        entry.fReady = false;
+        entry.tLastPoll = now;
+        if (entry.pBus != nullptr)
+            entry.pBus->poll();
+        else
+            entry.pHost->poll();
+        }
+
+    return true;
+    }
+
+// sleep in epoll for up to timeout microseconds, and mark the entries
+// whose ports have events.
+bool
+ModbusSerialEventLoop::wait(std::uint32_t timeout)
+    {
+    int msTimeout = 0;
+
+    if (timeout == UINT32_MAX)
+        msTimeout = -1;
+    else if (timeout != 0)
+        {
+        // epoll_wait() only has millisecond resolution; the timer has
+        // the precision the frame gaps need.
+        itimerspec its {};
+        its.it_value.tv_sec = timeout / 1000000u;
+        its.it_value.tv_nsec = long(timeout % 1000000u) * 1000;
+        if (::timerfd_settime(this->m_timerFd, 0, &its, nullptr) != 0)
+            return false;
+        msTimeout = -1;
+        }
+
+    epoll_event events[knMaxPorts + 2];
+    int n;
+
+    do  {
+        n = ::epoll_wait(this->m_epollFd, events, int(knMaxPorts + 2), msTimeout);
+        } while (n < 0 && errno == EINTR);
+
+    if (n < 0)
+        return false;
+
+    for (int i = 0; i < n; ++i)
+        {
+        void * const p = events[i].data.ptr;
+        std::uint64_t count;
+
+        if (p == &this->m_timerFd)
+            (void) ::read(this->m_timerFd, &count, sizeof(count));
+        else if (p == &this->m_wakeFd)
+            {
+            (void) ::read(this->m_wakeFd, &count, sizeof(count));
+            for (auto &entry : this->m_entries)
+                entry.fReady = entry.pPort != nullptr;
+            }
+        else
+            static_cast<Entry *>(p)->fReady = true;
+        }
+
+    return true;
+    }
+
+void
+ModbusSerialEventLoop::wake()
+    {
+    std::uint64_t const one = 1;
+
+    if (this->m_wakeFd >= 0)
+        (void) ::write(this->m_wakeFd, &one, sizeof(one));
+    }
+
+#endif // defined(__linux__) && ! defined(ARDUINO)
@@ -0,0 +1,80 @@
+/*
+
+Module:  MCCI_Modbus_Serial_FdPump.cpp
+
+Function:
+    ModbusSerialFdPump.
+
+Copyright notice and License:
+    See LICENSE file accompanying this project.
+
+Author:
+    MCCI Corporation   October 2026
+
+*/
+
+#include "MCCI_Modbus_Serial_FdPump.h"
+
+#if defined(__linux__) && ! defined(ARDUINO)
+
+#include <cerrno>
+#include <sys/epoll.h>
+
+using namespace McciCatena;
+
+bool
+ModbusSerialFdPump::pump(Client &client, int fd)
+    {
+    // from the fd to the device, until the fd is empty or the transmit
+    // buffer is full.
+    while (! this->m_fTxBlocked)
+        {
+        auto const n = client.readTx(fd);
+
+        if (n > 0 || (n < 0 && errno == EINTR))
+            continue;
+        if (n == 0)
+            return false;
+        if (errno == ENOBUFS)
+            this->m_fTxBlocked = true;
+        else if (errno != EAGAIN && errno != EWOULDBLOCK)
+            return false;
+        break;
+        }
+
+    // from the device to the fd, until the buffer is empty or the fd is
+    // full.
+    for (;;)
+        {
+        auto const n = client.writeRx(fd);
+
+        if (n > 0 || (n < 0 && errno == EINTR))
+            continue;
+
+        this->m_fRxBlocked = false;
+        if (n == 0)
+            break;
+        if (errno != EAGAIN && errno != EWOULDBLOCK)
+            return false;
+
+        this->m_fRxBlocked = true;
+        break;
+        }
+
+    return true;
+    }
+
+std::uint32_t
+ModbusSerialFdPump::getEvents() const
+    {
+    std::uint32_t events = 0;
+
+    if (! this->m_fTxBlocked)
+        events |= EPOLLIN;
+    if (this->m_fRxBlocked)
+        events |= EPOLLOUT;
+
+    return events;
+    }
+
+#endif // defined(__linux__) && ! defined(ARDUINO)
@@ -0,0 +1,701 @@
+/*
+
+Module:  MCCI_Modbus_Serial_Host.cpp
+
+Function:
+    ModbusSerialHost FSM.
+
+Copyright notice and License:
+    See LICENSE file accompanying this project.
+
+Author:
+    MCCI Corporation   October 2026
+
+*/
+
+#include "MCCI_Modbus_Serial_Host.h"
+
+using namespace McciCatena;
+
+bool
+ModbusSerialHost::begin(Client &client, std::uint32_t baudrate)
+    {
+    if (this->m_fTxnActive)
+        return false;
+
+    this->m_pClient = &client;
+    this->m_txArrivals.clear();
+    this->m_baudrate = baudrate;
+    this->m_fExitRequest = false;
+    this->m_fStatusValid = false;
+    this->m_awaitBackoff.reset();
+    this->m_awaitBackoff.seed(this->m_unitId ^ this->m_transport.getMicros());
+    this->m_timing.setBaudrate(this->m_transport.getBusBaudrate());
+    this->m_readSize.setBusTiming(
+        this->m_timing.getBaudrate(),
+        ModbusSerialTiming::kDefaultTurnaround
+        );
+    this->setState(State::stConfig, this->m_transport.getMicros());
+    return true;
+    }
+
+void
+ModbusSerialHost::setState(State newState, std::uint32_t now)
+    {
+    switch (newState)
+        {
+    case State::stAwaitDevice:
+        this->m_tAwait = now;
+        this->m_awaitDelay = this->m_awaitBackoff.next();
+        // it might be a different device when it comes back.
+        this->m_readWriteSupport = ReadWriteSupport::Unknown;
+        this->m_readSize.reset();
+        // fall through
+    case State::stConfig:
+    case State::stStopped:
+        // whatever we knew about the device is stale.
+        this->m_fStatusValid = false;
+        this->m_nRxAvail = 0;
+        this->m_txCredit.reset();
+        break;
+
+    default:
+        break;
+        }
+
+    this->m_state = newState;
+    }
+
+void
+ModbusSerialHost::poll()
+    {
+    this->m_transport.poll();
+
+    auto const now = this->m_transport.getMicros();
+
+    this->updateTxArrivals(now);
+
+    if (this->m_fTxnActive && ! this->finishTransaction(now))
+        return;
+
+    if (! this->m_transport.isReady())
+        return;
+
+    auto const pTxn = this->startTransaction(now, false);
+    if (pTxn != nullptr)
+        this->submitTransaction(*pTxn);
+    }
+
+std::uint32_t
+ModbusSerialHost::getWakeDelay(std::uint32_t now) const
+    {
+    if (this->m_state == State::stStopped || this->m_fTxnActive)
+        return UINT32_MAX;
+    if (this->m_fExitRequest)
+        return 0;
+
+    switch (this->m_state)
+        {
+    case State::stAwaitDevice:
+        return getRemaining(this->m_tAwait + this->m_awaitDelay, now);
+
+    case State::stIdle:
+        break;
+
+    default:
+        // stConfig, stRead and stWrite want the bus now.
+        return 0;
+        }
+
+    auto delay = getRemaining(this->m_tLastPoll + this->m_pollInterval.getInterval(), now);
+    if (this->m_pClient->getTxPending() == 0)
+        return delay;
+
+    std::uint32_t txDelay;
+
+    if (this->isTxDue(now))
+        {
+        // due output waits only for room in the device.
+        if (! this->m_fStatusValid || this->getTxAvail(now) != 0)
+            return 0;
+
+        txDelay = this->m_txCredit.getDrainDelay();
+        }
+    else
+        {
+        // isTxDue() is true if no arrival has been recorded, so the
+        // oldest is known here.
+        txDelay = getRemaining(this->m_txArrivals.getOldest() + this->m_txDeadline, now);
+
+        auto const slack = this->getTxSlack(now) - std::int32_t(this->getTxHorizon());
+        if (std::uint32_t(slack) < txDelay)
+            txDelay = std::uint32_t(slack);
+        }
+
+    return txDelay < delay ? txDelay : delay;
+    }
+
+// return microseconds from now until tWake; zero if it's passed.
+std::uint32_t
+ModbusSerialHost::getRemaining(std::uint32_t tWake, std::uint32_t now)
+    {
+    auto const delay = std::int32_t(tWake - now);
+
+    return delay > 0 ? std::uint32_t(delay) : 0;
+    }
+
+// if a transaction has completed, process it and return true.
+bool
+ModbusSerialHost::finishTransaction(std::uint32_t now)
+    {
+    if (! this->m_fTxnActive || this->m_txn.isPending())
+        return false;
+
+    this->m_fTxnActive = false;
+    this->complete(now);
+    return true;
+    }
+
+// if the FSM needs the bus, set up m_txn and return a pointer to it.
+// fEarlyPoll lets an idle host poll before its timer runs out.
+ModbusSerialHost::Transaction *
+ModbusSerialHost::startTransaction(std::uint32_t now, bool fEarlyPoll)
+    {
+    if (this->m_fTxnActive)
+        return nullptr;
+
+    this->m_startState = this->m_state;
+    if (! this->prepare(now, fEarlyPoll))
+        return nullptr;
+
+    this->m_txn.unitId = this->m_unitId;
+    this->m_txn.status = Transaction::Status::Idle;
+    return &this->m_txn;
+    }
+
+bool
+ModbusSerialHost::submitTransaction(Transaction &txn)
+    {
+    // probes give up sooner; a dead device shouldn't hold the bus.
+    auto const turnaroundLimit = this->m_state == State::stAwaitDevice
+                               ? this->m_probeTurnaroundLimit
+                               : this->m_turnaroundLimit;
+
+    txn.responseTimeout = this->m_timing.getResponseTimeout(txn.getResponseBytes(), turnaroundLimit);
+    if (! this->m_transport.submit(txn))
+        {
+        // nothing went out: undo what prepare() did, so the host asks
+        // again next time instead of waiting on a transaction that
+        // doesn't exist. prepare() only moves among stIdle, stRead and
+        // stWrite, none of which have side effects to undo.
+        this->m_state = this->m_startState;
+        this->m_nTxSending = 0;
+        return false;
+        }
+
+    // count the transaction only once it's really on its way.
+    if (this->m_state == State::stRead)
+        ++this->m_stats.nReads;
+    else if (this->m_state == State::stWrite)
+        {
+        if (txn.function == Transaction::Function::ReadWriteMultipleRegisters)
+            ++this->m_stats.nReadWrites;
+        else
+            ++this->m_stats.nWrites;
+        }
+
+    this->m_tSubmit = this->m_transport.getMicros();
+    this->m_fTxnActive = true;
+    return true;
+    }
+
+// decide whether we need the bus, and if so, set up m_txn.
+bool
+ModbusSerialHost::prepare(std::uint32_t now, bool fEarlyPoll)
+    {
+    if (this->m_state == State::stStopped)
+        return false;
+
+    if (this->m_fExitRequest)
+        {
+        this->setState(State::stStopped, now);
+        return false;
+        }
+
+    this->updateTxArrivals(now);
+
+    switch (this->m_state)
+        {
+    case State::stConfig:
+        this->prepareConfig();
+        return true;
+
+    case State::stAwaitDevice:
+        if (now - this->m_tAwait < this->m_awaitDelay)
+            return false;
+
+        this->prepareProbe();
+        return true;
+
+    case State::stIdle:
+        // write data goes out as soon as it's due and there's room for
+        // it; if the device is full, wait for credit to drain back or
+        // for the poll to refresh TxAvail.
+        if (this->isTxDue(now) &&
+            (! this->m_fStatusValid || this->getTxAvail(now) != 0))
+            {
+            this->setState(State::stWrite, now);
+            return this->prepareWrite();
+            }
+
+        if (! fEarlyPoll && ! this->isPollDue(now))
+            return false;
+
+        this->setState(State::stRead, now);
+        return this->prepareRead();
+
+    case State::stRead:
+        return this->prepareRead();
+
+    case State::stWrite:
+        return this->prepareWrite();
+
+    default:
+        return false;
+        }
+    }
+
+void
+ModbusSerialHost::prepareConfig()
+    {
+    if (this->m_baudrate == 0)
+        {
+        this->m_txn.setRead(Transaction::Function::ReadInputRegisters, Register::DummyReg_i32, 2);
+        }
+    else if (this->m_deviceBaudrate == this->m_baudrate)
+        {
+        // the device had our rate when we last saw it. Writing it again
+        // may restart its UART, so read DummyReg and Baudrate, which are
+        // adjacent, and write only if the device has lost the setting.
+        // Every register reads as a holding register.
+        this->m_txn.setRead(Transaction::Function::ReadHoldingRegisters, Register::DummyReg_i32, 4);
+        }
+    else
+        {
+        this->m_txn.setWrite(Register::Baudrate_i32, 2);
+        this->m_txn.writeRegs[0] = std::uint16_t(this->m_baudrate >> 16);
+        this->m_txn.writeRegs[1] = std::uint16_t(this->m_baudrate);
+        }
+    }
+
+// the cheapest question a device will answer: one register of DummyReg.
+void
+ModbusSerialHost::prepareProbe()
+    {
+    this->m_txn.setRead(Transaction::Function::ReadInputRegisters, Register::DummyReg_i32, 1);
+    }
+
+// the stConfig transaction worked; return true if the device is
+// configured, false if the rate must be written first.
+bool
+ModbusSerialHost::completeConfig()
+    {
+    if (this->m_baudrate == 0)
+        return true;
+
+    if (this->m_txn.function == Transaction::Function::WriteMultipleRegisters)
+        {
+        this->m_deviceBaudrate = this->m_baudrate;
+        return true;
+        }
+
+    // the device's rate follows DummyReg_i32, high half first.
+    this->m_deviceBaudrate = (std::uint32_t(this->m_txn.readRegs[2]) << 16) | this->m_txn.readRegs[3];
+    return this->m_deviceBaudrate == this->m_baudrate;
+    }
+
+// return the number of RxData registers to read along with Status.
+std::uint16_t
+ModbusSerialHost::getReadRegs() const
+    {
+    std::uint16_t nRegs;
+
+    // if we know how much is waiting, read exactly that; otherwise guess
+    // from recent history.
+    if (this->m_nRxAvail != 0)
+        nRegs = StatusBits().setInputAvail(std::uint8_t(this->m_nRxAvail)).getRegsToReadForInput();
+    else
+        nRegs = this->m_readSize.getRegs();
+
+    if (nRegs > Protocol::knRxDataReg)
+        nRegs = Protocol::knRxDataReg;
+
+    // keep within the transaction limit: 8 request bytes, and 5 + 2 per
+    // register (Status too) in the response.
+    std::uint16_t const nMaxRegs = std::uint16_t((this->getMaxTransactionBytes() - 15) / 2);
+    if (nRegs > nMaxRegs)
+        nRegs = nMaxRegs;
+
+    // reads consume data, so never ask for more than the client can take.
+    auto const nSpace = this->m_pClient->getRxSpace();
+    if (nSpace < 2u * nRegs)
+        {
+        // a final odd byte fits in one register's worth of space.
+        if (nSpace == 1 && this->m_nRxAvail == 1)
+            nRegs = 1;
+        else
+            nRegs = std::uint16_t(nSpace / 2);
+        }
+
+    return nRegs;
+    }
+
+bool
+ModbusSerialHost::prepareRead()
+    {
+    this->m_txn.setRead(
+        Transaction::Function::ReadInputRegisters,
+        Register::Status_u16,
+        1 + this->getReadRegs()
+        );
+    return true;
+    }
+
+bool
+ModbusSerialHost::prepareWrite()
+    {
+    auto const now = this->m_transport.getMicros();
+    auto const nTxAvail = this->getTxAvail(now);
+
+    if (! this->m_fStatusValid || nTxAvail == 0)
+        {
+        this->setState(State::stRead, now);
+        return this->prepareRead();
+        }
+
+    std::uint8_t buf[2 * Protocol::knTxDataReg + 1];
+    StatusBits txStatus;
+    Register baseReg;
+    std::uint16_t nRegs;
+
+    txStatus.setTxAvail(std::uint8_t(nTxAvail));
+
+    // keep within the transaction limit. 0x10 frames are 9 + 2 per
+    // register and 8; 0x17 frames are 13 + 2 per register and 5 + 2 per
+    // register read, Status included.
+    bool const fReadWrite = this->isReadWriteActive();
+    auto const nMaxBytes = this->getMaxTransactionBytes();
+    std::size_t const nMaxWriteRegs = fReadWrite ? (nMaxBytes - 20) / 2 : (nMaxBytes - 17) / 2;
+    std::size_t nPeek = sizeof(buf);
+
+    if (nPeek > 2 * nMaxWriteRegs)
+        nPeek = 2 * nMaxWriteRegs;
+
+    auto const nToSend = txStatus.getTxRegisterAndCount(
+                            baseReg, nRegs,
+                            this->m_pClient->peekTx(buf, nPeek)
+                            );
+    if (nToSend == 0)
+        {
+        this->setState(State::stIdle, now);
+        return false;
+        }
+
+    // an odd final byte lands in the high byte of TxDataByte.
+    Protocol::RegisterImage::pack(this->m_txn.writeRegs, buf, nToSend);
+
+    // if we can, pick up Status and any input in the same exchange, with
+    // whatever room the write leaves.
+    if (fReadWrite)
+        {
+        std::uint16_t nReadRegs = this->getReadRegs();
+
+        if (nRegs + nReadRegs > nMaxWriteRegs)
+            nReadRegs = std::uint16_t(nMaxWriteRegs - nRegs);
+
+        this->m_txn.setReadWrite(Register::Status_u16, 1 + nReadRegs, baseReg, nRegs);
+        }
+    else
+        this->m_txn.setWrite(baseReg, nRegs);
+
+    this->m_nTxSending = nToSend;
+    return true;
+    }
+
+void
+ModbusSerialHost::complete(std::uint32_t now)
+    {
+    this->updateTxArrivals(now);
+
+    if (this->m_txn.function == Transaction::Function::ReadWriteMultipleRegisters &&
+        this->m_txn.status == Transaction::Status::Exception &&
+        this->m_txn.exceptionCode == Transaction::kExceptionIllegalFunction)
+        {
+        // the device doesn't do 0x17, and so did nothing; go back and
+        // send the same data with 0x10.
+        this->m_readWriteSupport = ReadWriteSupport::No;
+        this->m_nTxSending = 0;
+        return;
+        }
+
+    if (this->m_state == State::stConfig &&
+        this->m_txn.function == Transaction::Function::ReadHoldingRegisters &&
+        this->m_txn.status == Transaction::Status::Exception)
+        {
+        // the device won't let us read Baudrate back; forget what we
+        // knew, so the next try just writes it.
+        ++this->m_stats.nErrors;
+        this->m_deviceBaudrate = 0;
+        return;
+        }
+
+    if (! this->m_txn.isSuccess())
+        {
+        if (this->m_txn.status == Transaction::Status::NoReply)
+            ++this->m_stats.nNoReply;
+        else
+            ++this->m_stats.nErrors;
+
+        // a timeout always means the device went away; in the discovery
+        // states, so does anything else.
+        if (this->m_txn.status == Transaction::Status::NoReply ||
+            ! this->isOperating())
+            {
+            this->setState(State::stAwaitDevice, now);
+            }
+        else
+            {
+            // we don't know what the device did with this, so re-read
+            // Status before writing again.
+            this->m_fStatusValid = false;
+            this->setState(State::stIdle, now);
+            }
+        return;
+        }
+
+    switch (this->m_state)
+        {
+    case State::stAwaitDevice:
+        // the device is back; configure it.
+        this->setState(State::stConfig, now);
+        break;
+
+    case State::stConfig:
+        // if the device lost its rate, stay here and write it.
+        if (! this->completeConfig())
+            break;
+
+        this->m_awaitBackoff.reset();
+
+        // credit drains at the rate we just set; if we only probed, the
+        // rate is unknown and credit only comes back with Status reads.
+        this->m_txCredit.setBaudrate(this->m_fTxPrediction ? this->m_baudrate : 0);
+        this->m_pollInterval.reset();
+        this->setState(State::stRead, now);
+        break;
+
+    case State::stRead:
+        this->completeRead(now);
+        break;
+
+    case State::stWrite:
+        this->completeWrite(now);
+        break;
+
+    default:
+        break;
+        }
+    }
+
+void
+ModbusSerialHost::completeRead(std::uint32_t now)
+    {
+    std::uint8_t buf[2 * Protocol::knRxDataReg];
+    StatusBits const status(this->m_txn.readRegs[0]);
+    std::uint16_t const nRxAvail = status.getInputAvail();
+    std::uint16_t const nRegs = this->m_txn.nRead - 1;
+    std::uint16_t nData = 2 * nRegs;
+
+    if (nData > nRxAvail)
+        nData = nRxAvail;
+
+    Protocol::RegisterImage::unpack(buf, &this->m_txn.readRegs[1], nData);
+    if (nData != 0)
+        this->m_pClient->putRx(buf, nData);
+
+    // if this read was sized by a guess, learn from it.
+    if (this->m_nRxAvail == 0)
+        this->m_readSize.update(status);
+
+    this->m_status = status;
+    this->m_fStatusValid = true;
+    this->m_nRxAvail = nRxAvail - nData;
+    this->m_txCredit.update(status, this->m_tSubmit, now);
+    this->m_tLastPoll = now;
+    this->m_pollInterval.update(status);
+    this->m_stats.nRxBytes += nData;
+
+    this->setState(this->getNextOperatingState(now, true), now);
+    }
+
+void
+ModbusSerialHost::completeWrite(std::uint32_t now)
+    {
+    this->m_pClient->consumeTx(this->m_nTxSending);
+    this->m_stats.nTxBytes += this->m_nTxSending;
+
+    auto const nLate = this->m_txArrivals.consume(this->m_nTxSending, now, this->m_txLatencyBound);
+    if (nLate != 0)
+        {
+        this->m_stats.nTxLateBytes += std::uint32_t(nLate);
+        ++this->m_stats.nTxLateWrites;
+        }
+
+    if (this->m_txn.function == Transaction::Function::ReadWriteMultipleRegisters)
+        {
+        // the write went first, so the Status image already accounts
+        // for it; charge it to the prediction too, so they compare.
+        this->m_txCredit.consume(this->m_nTxSending, this->m_tSubmit);
+        this->m_readWriteSupport = ReadWriteSupport::Yes;
+        this->m_nTxSending = 0;
+        this->completeRead(now);
+        return;
+        }
+
+    this->m_txCredit.consume(this->m_nTxSending, now);
+    this->m_nTxSending = 0;
+
+    this->setState(this->getNextOperatingState(now, false), now);
+    }
+
+// the transitions out of stRead and stWrite. fHaveStatus is true if the
+// transaction just completed returned a Status image.
+ModbusSerialHost::State
+ModbusSerialHost::getNextOperatingState(std::uint32_t now, bool fHaveStatus) const
+    {
+    bool const fTxPending = this->isTxDue(now);
+    bool const fRxPending = this->m_nRxAvail != 0 && this->getReadRegs() != 0;
+
+    bool const fTxAvail = this->getTxAvail(now) != 0;
+
+    if (! fHaveStatus)
+        {
+        if (this->isPollDue(now) || fRxPending)
+            return State::stRead;
+        if (fTxPending && fTxAvail)
+            return State::stWrite;
+        // if the device is full, a Status read won't tell us anything
+        // the credit prediction won't, so wait in stIdle for it.
+        if (fTxPending && ! this->m_txCredit.isDraining())
+            return State::stRead;
+        return State::stIdle;
+        }
+    else
+        {
+        if (fTxPending && fTxAvail)
+            return State::stWrite;
+        if (fRxPending)
+            return State::stRead;
+        return State::stIdle;
+        }
+    }
+
+// note the arrival of new output.
+void
+ModbusSerialHost::updateTxArrivals(std::uint32_t now)
+    {
+    if (this->m_pClient != nullptr)
+        this->m_txArrivals.update(this->m_pClient->getTxPending(), now);
+    }
+
+// true if pending output should be written now rather than held for
+// more to accumulate.
+bool
+ModbusSerialHost::isTxDue(std::uint32_t now) const
+    {
+    auto const nPending = this->m_pClient->getTxPending();
+
+    if (nPending == 0)
+        return false;
+    if (nPending >= this->m_txThreshold || this->m_pClient->isTxFlushRequested())
+        return true;
+    if (this->m_txArrivals.isEmpty() ||
+        now - this->m_txArrivals.getOldest() >= this->m_txDeadline)
+        return true;
+    // output with a deadline can't wait for whatever transaction might
+    // be on the bus when its deadline gets close.
+    if (this->getTxSlack(now) <= std::int32_t(this->getTxHorizon()))
+        return true;
+
+    // waiting won't help if the device can't take a full write anyway.
+    return this->m_fStatusValid && nPending >= this->getTxAvail(now);
+    }
+
+// return how long, in microseconds, the write for the oldest pending
+// byte can wait and still meet its deadline; negative if it's already
+// too late.
+std::int32_t
+ModbusSerialHost::getTxSlack(std::uint32_t now) const
+    {
+    if (this->m_txLatencyBound == 0 || this->m_txArrivals.isEmpty())
+        return INT32_MAX;
+
+    std::uint32_t const tDeadline = this->m_txArrivals.getOldest() + this->m_txLatencyBound;
+
+    return std::int32_t(tDeadline - now) - std::int32_t(this->getTxWriteMicros());
+    }
+
+// estimate how long the write for the pending output will take.
+std::uint32_t
+ModbusSerialHost::getTxWriteMicros() const
+    {
+    std::uint32_t nData = std::uint32_t(this->m_pClient->getTxPending());
+    if (nData > knMaxTxThreshold)
+        nData = knMaxTxThreshold;
+
+    std::uint32_t const nWriteRegs = (nData + 1) / 2;
+    std::uint32_t nBytes;
+
+    if (this->isReadWriteActive())
+        nBytes = 13 + 2 * nWriteRegs + 5 + 2 * (1 + this->getReadRegs());
+    else
+        nBytes = 9 + 2 * nWriteRegs + 8;
+
+    // a longer write is split, but the oldest byte goes in the first part.
+    if (nBytes > this->getMaxTransactionBytes())
+        nBytes = this->getMaxTransactionBytes();
+
+    return this->m_timing.getFrameMicros(nBytes) + this->m_timing.getOverheadMicros();
+    }
+
+// return the most frame bytes (request plus response) a transaction may
+// use. With latency bounds on the bus, a transaction may take half the
+// tightest bound, so a write that becomes urgent while it's on the bus
+// still has the other half.
+std::uint16_t
+ModbusSerialHost::getMaxTransactionBytes() const
+    {
+    // room for 0x17 with two registers each way; never less.
+    constexpr std::uint16_t knMinBytes = 13 + 2 * 2 + 5 + 2 * 2;
+
+    std::uint32_t bound = this->m_txLatencyBound;
+    if (bound == 0 || (this->m_busLatencyBound != 0 && this->m_busLatencyBound < bound))
+        bound = this->m_busLatencyBound;
+
+    if (bound == 0 || this->m_timing.getBaudrate() == 0)
+        return Transaction::knMaxTransactionBytes;
+
+    // the gaps and turnaround don't depend on size; the rest is frames.
+    std::uint32_t const tBudget = bound / 2;
+    std::uint32_t const tOverhead = this->m_timing.getOverheadMicros();
+    if (tBudget <= tOverhead)
+        return knMinBytes;
+
+    std::uint32_t const nBytes = this->m_timing.getBytesInMicros(tBudget - tOverhead);
+
+    if (nBytes < knMinBytes)
+        return knMinBytes;
+    if (nBytes > Transaction::knMaxTransactionBytes)
+        return Transaction::knMaxTransactionBytes;
+    return std::uint16_t(nBytes);
+    }
@@ -0,0 +1,110 @@
+/*
+
+Module:  MCCI_Modbus_Serial_Mbap.cpp
+
+Function:
+    ModbusSerialMbap framing.
+
+Copyright notice and License:
+    See LICENSE file accompanying this project.
+
+Author:
+    MCCI Corporation   October 2026
+
+*/
+
+#include "MCCI_Modbus_Serial_Mbap.h"
+#include "MCCI_Modbus_Serial_Pdu.h"
+
+using namespace McciCatena;
+
+using Pdu = ModbusSerialPdu;
+
+std::size_t
+ModbusSerialMbap::getAduSize(const std::uint8_t *pBuf, std::size_t nBuf)
+    {
+    if (nBuf < knHeaderBytes)
+        return 0;
+
+    // the length counts the unit ID and the PDU, which has at least a
+    // function code.
+    std::size_t const nLength = Pdu::getU16(pBuf + 4);
+    if (Pdu::getU16(pBuf + 2) != 0 || nLength < 2 || nLength > knMaxAduBytes - 6)
+        return SIZE_MAX;
+
+    std::size_t const nAdu = 6 + nLength;
+    return nBuf < nAdu ? 0 : nAdu;
+    }
+
+std::size_t
+ModbusSerialMbap::putHeader(std::uint8_t *pBuf, std::uint16_t transactionId, std::uint8_t unitId, std::size_t nPdu)
+    {
+    Pdu::putU16(pBuf, transactionId);
+    Pdu::putU16(pBuf + 2, 0);
+    Pdu::putU16(pBuf + 4, std::uint16_t(1 + nPdu));
+    pBuf[6] = unitId;
+    return knHeaderBytes + nPdu;
+    }
+
+std::size_t
+ModbusSerialMbap::encodeRequest(std::uint8_t *pBuf, std::uint16_t transactionId, const Transaction &t)
+    {
+    auto const nPdu = Pdu::encodeRequest(pBuf + knHeaderBytes, t);
+
+    return putHeader(pBuf, transactionId, t.unitId, nPdu);
+    }
+
+std::size_t
+ModbusSerialMbap::encodeTxWrite(
+    std::uint8_t *pBuf,
+    std::size_t &nSent,
+    std::uint16_t transactionId,
+    std::uint8_t unitId,
+    ModbusSerialProtocol::StatusBits status,
+    const std::uint8_t *pData, std::size_t nData,
+    const std::uint8_t *pWrap, std::size_t nWrap
+    )
+    {
+    auto const nPdu = Pdu::encodeTxWrite(pBuf + knHeaderBytes, nSent, status, pData, nData, pWrap, nWrap);
+
+    if (nPdu == 0)
+        return 0;
+
+    return putHeader(pBuf, transactionId, unitId, nPdu);
+    }
+
+void
+ModbusSerialMbap::decodeResponse(const std::uint8_t *pAdu, std::size_t nAdu, Transaction &t)
+    {
+    if (getUnitId(pAdu) != t.unitId)
+        {
+        t.status = Transaction::Status::Error;
+        return;
+        }
+
+    Pdu::decodeResponse(pAdu + knHeaderBytes, nAdu - knHeaderBytes, t);
+
+    // a gateway that couldn't reach the device is a missing device.
+    if (t.status == Transaction::Status::Exception &&
+        (t.exceptionCode == kExceptionGatewayPath || t.exceptionCode == kExceptionGatewayTarget))
+        t.status = Transaction::Status::NoReply;
+    }
+
+std::size_t
+ModbusSerialMbap::serveRequest(
+    const std::uint8_t *pAdu, std::size_t nAdu,
+    ModbusSerialDevice *pDevice,
+    std::uint8_t *pResponse
+    )
+    {
+    const std::uint8_t * const pPdu = pAdu + knHeaderBytes;
+    std::uint8_t * const pOut = pResponse + knHeaderBytes;
+    std::size_t nOut;
+
+    if (pDevice == nullptr)
+        nOut = Pdu::putException(pOut, pPdu[0], kExceptionGatewayTarget);
+    else
+        nOut = Pdu::serveRequest(pPdu, nAdu - knHeaderBytes, *pDevice, pOut);
+
+    return putHeader(pResponse, getTransactionId(pAdu), getUnitId(pAdu), nOut);
+    }
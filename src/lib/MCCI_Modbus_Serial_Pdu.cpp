@@ -0,0 +1,224 @@
+/*
+
+Module:  MCCI_Modbus_Serial_Pdu.cpp
+
+Function:
+    ModbusSerialPdu encoding.
+
+Copyright notice and License:
+    See LICENSE file accompanying this project.
+
+Author:
+    MCCI Corporation   October 2026
+
+*/
+
+#include "MCCI_Modbus_Serial_Pdu.h"
+#include "MCCI_Modbus_Serial_Device.h"
+
+#include <cstring>
+
+using namespace McciCatena;
+
+namespace {
+
+using Function = ModbusSerialTransaction::Function;
+
+using RegisterImage = ModbusSerialProtocol::RegisterImage;
+
+// registers go on the wire high byte first, just as characters are
+// packed into them.
+std::uint8_t *putRegs(std::uint8_t *p, const std::uint16_t *pRegs, std::uint16_t nRegs)
+    {
+    RegisterImage::unpack(p, pRegs, 2u * nRegs);
+    return p + 2u * nRegs;
+    }
+
+void getRegs(const std::uint8_t *p, std::uint16_t *pRegs, std::uint16_t nRegs)
+    {
+    RegisterImage::pack(pRegs, p, 2u * nRegs);
+    }
+
+} // namespace
+
+std::size_t
+ModbusSerialPdu::encodeRequest(std::uint8_t *pBuf, const Transaction &t)
+    {
+    std::uint8_t *p = pBuf;
+
+    *p++ = std::uint8_t(t.function);
+    switch (t.function)
+        {
+    case Function::WriteMultipleRegisters:
+        p = putU16(p, t.writeAddress);
+        p = putU16(p, t.nWrite);
+        *p++ = std::uint8_t(2 * t.nWrite);
+        p = putRegs(p, t.writeRegs, t.nWrite);
+        break;
+
+    case Function::ReadWriteMultipleRegisters:
+        p = putU16(p, t.readAddress);
+        p = putU16(p, t.nRead);
+        p = putU16(p, t.writeAddress);
+        p = putU16(p, t.nWrite);
+        *p++ = std::uint8_t(2 * t.nWrite);
+        p = putRegs(p, t.writeRegs, t.nWrite);
+        break;
+
+    default:
+        p = putU16(p, t.readAddress);
+        p = putU16(p, t.nRead);
+        break;
+        }
+
+    return std::size_t(p - pBuf);
+    }
+
+std::size_t
+ModbusSerialPdu::encodeTxWrite(
+    std::uint8_t *pBuf,
+    std::size_t &nSent,
+    StatusBits status,
+    const std::uint8_t *pData, std::size_t nData,
+    const std::uint8_t *pWrap, std::size_t nWrap
+    )
+    {
+    ModbusSerialProtocol::Register baseReg;
+    std::uint16_t nRegs;
+
+    nSent = status.getTxRegisterAndCount(baseReg, nRegs, nData + nWrap);
+    if (nSent == 0)
+        return 0;
+
+    std::uint8_t *p = pBuf;
+    std::size_t const nFirst = nSent < nData ? nSent : nData;
+
+    *p++ = std::uint8_t(Function::WriteMultipleRegisters);
+    p = putU16(p, ModbusSerialProtocol::getAddress(baseReg));
+    p = putU16(p, nRegs);
+    *p++ = std::uint8_t(2 * nRegs);
+
+    std::memcpy(p, pData, nFirst);
+    if (nSent != nFirst)
+        std::memcpy(p + nFirst, pWrap, nSent - nFirst);
+    p += nSent;
+
+    // TxDataByte's low byte is ignored.
+    if (nSent & 1)
+        *p++ = 0;
+
+    return std::size_t(p - pBuf);
+    }
+
+void
+ModbusSerialPdu::decodeResponse(const std::uint8_t *pPdu, std::size_t nPdu, Transaction &t)
+    {
+    t.status = Transaction::Status::Error;
+    if (nPdu < 2 || (pPdu[0] & 0x7F) != std::uint8_t(t.function))
+        return;
+
+    if (pPdu[0] & 0x80)
+        {
+        t.exceptionCode = pPdu[1];
+        t.status = Transaction::Status::Exception;
+        return;
+        }
+
+    if (t.function == Function::WriteMultipleRegisters)
+        {
+        if (nPdu == 5 && getU16(pPdu + 1) == t.writeAddress && getU16(pPdu + 3) == t.nWrite)
+            t.status = Transaction::Status::Success;
+        return;
+        }
+
+    // reads: function, byte count, registers.
+    if (nPdu != 2u + 2u * t.nRead || pPdu[1] != 2 * t.nRead)
+        return;
+
+    getRegs(pPdu + 2, t.readRegs, t.nRead);
+    t.status = Transaction::Status::Success;
+    }
+
+std::size_t
+ModbusSerialPdu::serveRequest(
+    const std::uint8_t *pPdu, std::size_t nPdu,
+    ModbusSerialDevice &device,
+    std::uint8_t *pResponse
+    )
+    {
+    using Exception = ModbusSerialDevice::Exception;
+
+    std::uint16_t regs[ModbusSerialDevice::knMaxReadRegs];
+    std::uint16_t writeRegs[ModbusSerialDevice::knMaxWriteRegs];
+    std::uint8_t const fn = pPdu[0];
+    std::uint8_t *p = pResponse;
+    Exception e = Exception::IllegalDataValue;
+
+    *p++ = fn;
+    switch (Function(fn))
+        {
+    case Function::ReadHoldingRegisters:
+    case Function::ReadInputRegisters:
+        {
+        if (nPdu != 5)
+            break;
+
+        std::uint16_t const nRegs = getU16(pPdu + 3);
+        if (nRegs == 0 || nRegs > ModbusSerialDevice::knMaxReadRegs)
+            break;
+
+        e = device.readRegisters(getU16(pPdu + 1), nRegs, regs);
+        *p++ = std::uint8_t(2 * nRegs);
+        p = putRegs(p, regs, nRegs);
+        break;
+        }
+
+    case Function::WriteMultipleRegisters:
+        {
+        if (nPdu < 6)
+            break;
+
+        std::uint16_t const nRegs = getU16(pPdu + 3);
+        if (nRegs == 0 || nRegs > ModbusSerialDevice::knMaxWriteRegs ||
+            pPdu[5] != 2 * nRegs || nPdu != 6u + 2u * nRegs)
+            break;
+
+        getRegs(pPdu + 6, writeRegs, nRegs);
+        e = device.writeRegisters(getU16(pPdu + 1), nRegs, writeRegs);
+        p = putU16(p, getU16(pPdu + 1));
+        p = putU16(p, nRegs);
+        break;
+        }
+
+    case Function::ReadWriteMultipleRegisters:
+        {
+        if (nPdu < 10)
+            break;
+
+        std::uint16_t const nReadRegs = getU16(pPdu + 3);
+        std::uint16_t const nWriteRegs = getU16(pPdu + 7);
+        if (nReadRegs == 0 || nReadRegs > ModbusSerialDevice::knMaxReadRegs ||
+            nWriteRegs == 0 || nWriteRegs > ModbusSerialDevice::knMaxReadWriteWriteRegs ||
+            pPdu[9] != 2 * nWriteRegs || nPdu != 10u + 2u * nWriteRegs)
+            break;
+
+        getRegs(pPdu + 10, writeRegs, nWriteRegs);
+        e = device.readWriteRegisters(
+                getU16(pPdu + 1), nReadRegs, regs,
+                getU16(pPdu + 5), nWriteRegs, writeRegs
+                );
+        *p++ = std::uint8_t(2 * nReadRegs);
+        p = putRegs(p, regs, nReadRegs);
+        break;
+        }
+
+    default:
+        e = Exception::IllegalFunction;
+        break;
+        }
+
+    if (e != Exception::None)
+        return putException(pResponse, fn, std::uint8_t(e));
+
+    return std::size_t(p - pResponse);
+    }
@@ -0,0 +1,90 @@
+/*
+
+Module:  MCCI_Modbus_Serial_Protocol.cpp
+
+Function:
+    ModbusSerialProtocol::RegisterImage.
+
+Copyright notice and License:
+    See LICENSE file accompanying this project.
+
+Author:
+    MCCI Corporation   October 2026
+
+*/
+
+#include "MCCI_Modbus_Serial_Protocol.h"
+
+#include <cstring>
+
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+// registers are already big-endian in memory.
+#elif defined(__SSE2__)
+# include <emmintrin.h>
+#elif defined(__ARM_NEON)
+# include <arm_neon.h>
+#endif
+
+using namespace McciCatena;
+
+namespace {
+
+// copy nPairs pairs of bytes from pIn to pOut, swapping each pair, so
+// that characters become native registers or the reverse.
+void copyPairs(std::uint8_t *pOut, const std::uint8_t *pIn, std::size_t nPairs)
+    {
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    std::memcpy(pOut, pIn, 2 * nPairs);
+#else
+    std::size_t i = 0;
+
+# if defined(__SSE2__)
+    // SSE2 has no byte shuffle, but shifting each 16-bit lane both ways
+    // swaps its bytes just as well.
+    for (; i + 8 <= nPairs; i += 8)
+        {
+        __m128i const v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(pIn + 2 * i));
+
+        _mm_storeu_si128(
+            reinterpret_cast<__m128i *>(pOut + 2 * i),
+            _mm_or_si128(_mm_slli_epi16(v, 8), _mm_srli_epi16(v, 8))
+            );
+        }
+# elif defined(__ARM_NEON)
+    for (; i + 8 <= nPairs; i += 8)
+        vst1q_u8(pOut + 2 * i, vrev16q_u8(vld1q_u8(pIn + 2 * i)));
+# endif
+
+    for (; i < nPairs; ++i)
+        {
+        std::uint8_t const first = pIn[2 * i];
+
+        pOut[2 * i] = pIn[2 * i + 1];
+        pOut[2 * i + 1] = first;
+        }
+#endif
+    }
+
+} // namespace
+
+std::size_t
+ModbusSerialProtocol::RegisterImage::pack(std::uint16_t *pRegs, const std::uint8_t *pBuf, std::size_t nBytes)
+    {
+    std::size_t const nPairs = nBytes / 2;
+
+    copyPairs(reinterpret_cast<std::uint8_t *>(pRegs), pBuf, nPairs);
+    if (nBytes & 1)
+        pRegs[nPairs] = std::uint16_t(pBuf[nBytes - 1] << 8);
+
+    return (nBytes + 1) / 2;
+    }
+
+void
+ModbusSerialProtocol::RegisterImage::unpack(std::uint8_t *pBuf, const std::uint16_t *pRegs, std::size_t nBytes)
+    {
+    std::size_t const nPairs = nBytes / 2;
+
+    copyPairs(pBuf, reinterpret_cast<const std::uint8_t *>(pRegs), nPairs);
+    if (nBytes & 1)
+        pBuf[nBytes - 1] = std::uint8_t(pRegs[nPairs] >> 8);
+    }
@@ -0,0 +1,292 @@
+/*
+
+Module:  MCCI_Modbus_Serial_PtyBridge.cpp
+
+Function:
+    ModbusSerialPtyBridge.
+
+Copyright notice and License:
+    See LICENSE file accompanying this project.
+
+Author:
+    MCCI Corporation   October 2026
+
+*/
+
+#include "MCCI_Modbus_Serial_PtyBridge.h"
+
+#if defined(__linux__) && ! defined(ARDUINO)
+
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/epoll.h>
+#include <sys/stat.h>
+#include <termios.h>
+#include <unistd.h>
+
+using namespace McciCatena;
+
+namespace {
+
+// epoll data is the entry index, shifted, plus one of these; the stop
+// event has a value of its own.
+constexpr std::uint64_t kEventMaster = 0;
+constexpr std::uint64_t kEventRx = 1;
+constexpr std::uint64_t kEventTx = 2;
+constexpr std::uint64_t kEventStop = UINT64_MAX;
+
+void drainEvent(int fd)
+    {
+    std::uint64_t count;
+    (void) ::read(fd, &count, sizeof(count));
+    }
+
+} // namespace
+
+ModbusSerialPtyBridge::~ModbusSerialPtyBridge()
+    {
+    this->end();
+
+    for (std::size_t i = 0; i < this->m_nEntries; ++i)
+        {
+        Entry &entry = this->m_entries[i];
+
+        if (entry.link[0] != '\0')
+            (void) ::unlink(entry.link);
+        ::close(entry.slaveFd);
+        ::close(entry.masterFd);
+        }
+    }
+
+bool
+ModbusSerialPtyBridge::add(Client &client, const char *pLink)
+    {
+    if (this->isRunning() || this->m_nEntries == knMaxPtys)
+        return false;
+    if (pLink != nullptr && std::strlen(pLink) >= knMaxPath)
+        return false;
+
+    Entry &entry = this->m_entries[this->m_nEntries];
+
+    int const masterFd = ::posix_openpt(O_RDWR | O_NOCTTY | O_NONBLOCK | O_CLOEXEC);
+    if (masterFd < 0)
+        return false;
+
+    int slaveFd = -1;
+    termios tio;
+
+    if (::grantpt(masterFd) != 0 ||
+        ::unlockpt(masterFd) != 0 ||
+        ::ptsname_r(masterFd, entry.path, sizeof(entry.path)) != 0 ||
+        (slaveFd = ::open(entry.path, O_RDWR | O_NOCTTY | O_CLOEXEC)) < 0 ||
+        ::tcgetattr(slaveFd, &tio) != 0)
+        {
+        if (slaveFd >= 0)
+            ::close(slaveFd);
+        ::close(masterFd);
+        return false;
+        }
+
+    // bytes pass through untouched: no echo, no line editing, no CR/LF
+    // translation.
+    ::cfmakeraw(&tio);
+    if (::tcsetattr(slaveFd, TCSANOW, &tio) != 0)
+        {
+        ::close(slaveFd);
+        ::close(masterFd);
+        return false;
+        }
+
+    entry.link[0] = '\0';
+    if (pLink != nullptr)
+        {
+        struct stat st;
+
+        // replace a stale link from an earlier run, but nothing else.
+        if (::lstat(pLink, &st) == 0 && S_ISLNK(st.st_mode))
+            (void) ::unlink(pLink);
+
+        if (::symlink(entry.path, pLink) != 0)
+            {
+            ::close(slaveFd);
+            ::close(masterFd);
+            return false;
+            }
+        std::strcpy(entry.link, pLink);
+        }
+
+    entry.pClient = &client;
+    entry.masterFd = masterFd;
+    entry.slaveFd = slaveFd;
+    ++this->m_nEntries;
+    return true;
+    }
+
+const char *
+ModbusSerialPtyBridge::getPath(const Client &client) const
+    {
+    for (std::size_t i = 0; i < this->m_nEntries; ++i)
+        {
+        if (this->m_entries[i].pClient == &client)
+            return this->m_entries[i].path;
+        }
+    return nullptr;
+    }
+
+bool
+ModbusSerialPtyBridge::begin(int cpu)
+    {
+    if (this->isRunning())
+        return false;
+
+    if (! this->setup())
+        {
+        this->teardown();
+        return false;
+        }
+
+    if (! ModbusSerialThreadControl::start(this->m_thread, [this] { this->run(); }, cpu))
+        {
+        this->end();
+        return false;
+        }
+
+    return true;
+    }
+
+bool
+ModbusSerialPtyBridge::setup()
+    {
+    if (! this->m_control.begin(true))
+        return false;
+
+    this->m_epollFd = ::epoll_create1(EPOLL_CLOEXEC);
+    if (this->m_epollFd < 0)
+        return false;
+
+    epoll_event ev {};
+    ev.events = EPOLLIN;
+    ev.data.u64 = kEventStop;
+    if (::epoll_ctl(this->m_epollFd, EPOLL_CTL_ADD, this->m_control.getStopFd(), &ev) != 0)
+        return false;
+
+    for (std::size_t i = 0; i < this->m_nEntries; ++i)
+        {
+        Entry &entry = this->m_entries[i];
+
+        entry.events = EPOLLIN;
+        entry.pump.reset();
+
+        ev.events = EPOLLIN;
+        ev.data.u64 = (std::uint64_t(i) << 2) | kEventMaster;
+        if (::epoll_ctl(this->m_epollFd, EPOLL_CTL_ADD, entry.masterFd, &ev) != 0)
+            return false;
+
+        ev.data.u64 = (std::uint64_t(i) << 2) | kEventRx;
+        if (::epoll_ctl(this->m_epollFd, EPOLL_CTL_ADD, entry.pClient->getRxEventFd(), &ev) != 0)
+            return false;
+
+        ev.data.u64 = (std::uint64_t(i) << 2) | kEventTx;
+        if (::epoll_ctl(this->m_epollFd, EPOLL_CTL_ADD, entry.pClient->getTxEventFd(), &ev) != 0)
+            return false;
+        }
+
+    return true;
+    }
+
+void
+ModbusSerialPtyBridge::teardown()
+    {
+    // closing the epoll instance drops its registrations.
+    if (this->m_epollFd >= 0)
+        {
+        ::close(this->m_epollFd);
+        this->m_epollFd = -1;
+        }
+    this->m_control.end();
+    }
+
+void
+ModbusSerialPtyBridge::end()
+    {
+    if (this->isRunning())
+        {
+        this->m_control.requestStop();
+        ModbusSerialThreadControl::join(this->m_thread);
+        }
+
+    this->teardown();
+    }
+
+void
+ModbusSerialPtyBridge::run()
+    {
+    // anything that arrived before we started.
+    for (std::size_t i = 0; i < this->m_nEntries; ++i)
+        this->pump(this->m_entries[i]);
+
+    while (! this->m_control.isStopRequested())
+        {
+        epoll_event events[32];
+        int const n = ::epoll_wait(this->m_epollFd, events, 32, -1);
+
+        if (n < 0 && errno != EINTR)
+            break;
+
+        for (int i = 0; i < n; ++i)
+            {
+            auto const data = events[i].data.u64;
+            if (data == kEventStop)
+                continue;
+
+            Entry &entry = this->m_entries[data >> 2];
+            switch (data & 3)
+                {
+            case kEventRx:
+                drainEvent(entry.pClient->getRxEventFd());
+                break;
+
+            case kEventTx:
+                drainEvent(entry.pClient->getTxEventFd());
+                entry.pump.clearTxBlocked();
+                break;
+
+            default:
+                break;
+                }
+
+            this->pump(entry);
+            }
+        }
+    }
+
+// move whatever can move, each way. The bridge holds the slave open, so
+// the master never sees end of file.
+void
+ModbusSerialPtyBridge::pump(Entry &entry)
+    {
+    (void) entry.pump.pump(*entry.pClient, entry.masterFd);
+    (void) this->updateEvents(entry);
+    }
+
+bool
+ModbusSerialPtyBridge::updateEvents(Entry &entry)
+    {
+    std::uint32_t const events = entry.pump.getEvents();
+
+    if (events == entry.events)
+        return true;
+
+    epoll_event ev {};
+    ev.events = events;
+    ev.data.u64 = (std::uint64_t(&entry - this->m_entries) << 2) | kEventMaster;
+    if (::epoll_ctl(this->m_epollFd, EPOLL_CTL_MOD, entry.masterFd, &ev) != 0)
+        return false;
+
+    entry.events = events;
+    return true;
+    }
+
+#endif // defined(__linux__) && ! defined(ARDUINO)
@@ -0,0 +1,237 @@
+/*
+
+Module:  MCCI_Modbus_Serial_Requester.cpp
+
+Function:
+    ModbusSerialRequest and ModbusSerialRequester.
+
+Copyright notice and License:
+    See LICENSE file accompanying this project.
+
+Author:
+    MCCI Corporation   October 2026
+
+*/
+
+#include "MCCI_Modbus_Serial_Requester.h"
+
+#include <cstring>
+
+using namespace McciCatena;
+
+void
+ModbusSerialRequest::setReadInput(std::uint8_t unitId, std::size_t nMaxBytes)
+    {
+    if (nMaxBytes > knMaxData)
+        nMaxBytes = knMaxData;
+
+    auto const nRegs = StatusBits().setInputAvail(std::uint8_t(nMaxBytes)).getRegsToReadForInput();
+
+    this->m_txn.unitId = unitId;
+    this->m_txn.setRead(Transaction::Function::ReadInputRegisters, Register::Status_u16, 1 + nRegs);
+    this->m_kind = Kind::ReadInput;
+    this->m_nData = 0;
+    }
+
+std::size_t
+ModbusSerialRequest::setWriteTx(
+    std::uint8_t unitId,
+    StatusBits status,
+    const std::uint8_t *pBuf,
+    std::size_t nBuf
+    )
+    {
+    Register baseReg;
+    std::uint16_t nRegs;
+    auto const nToSend = status.getTxRegisterAndCount(baseReg, nRegs, nBuf);
+
+    if (nToSend == 0)
+        {
+        this->m_kind = Kind::None;
+        return 0;
+        }
+
+    std::memcpy(this->m_data, pBuf, nToSend);
+
+    // an odd final byte lands in the high byte of TxDataByte.
+    Protocol::RegisterImage::pack(this->m_txn.writeRegs, pBuf, nToSend);
+
+    // the requester picks 0x10 or 0x17 when the request starts.
+    this->m_txn.unitId = unitId;
+    this->m_txn.setWrite(baseReg, nRegs);
+    this->m_kind = Kind::WriteTx;
+    this->m_nData = nToSend;
+    return nToSend;
+    }
+
+// unpack the input from a successful read.
+void
+ModbusSerialRequest::decode()
+    {
+    if (this->m_kind != Kind::ReadInput)
+        return;
+
+    this->m_nData = 0;
+    if (! this->m_txn.isSuccess())
+        return;
+
+    StatusBits const status(this->m_txn.readRegs[0]);
+    std::uint16_t nData = 2 * (this->m_txn.nRead - 1);
+
+    if (nData > status.getInputAvail())
+        nData = status.getInputAvail();
+
+    Protocol::RegisterImage::unpack(this->m_data, &this->m_txn.readRegs[1], nData);
+    this->m_nData = nData;
+    }
+
+bool
+ModbusSerialRequester::submit(Request &request, Request::CompletionFn *pFn, void *pCtx)
+    {
+    if (request.m_fBusy || request.m_kind == Request::Kind::None)
+        return false;
+
+    request.m_pDoneFn = pFn;
+    request.m_pDoneCtx = pCtx;
+    request.m_fBusy = true;
+    request.m_pNext = nullptr;
+
+    if (this->m_pQueueTail != nullptr)
+        this->m_pQueueTail->m_pNext = &request;
+    else
+        this->m_pQueueHead = &request;
+    this->m_pQueueTail = &request;
+
+    ++this->m_nBusy;
+    return true;
+    }
+
+bool
+ModbusSerialRequester::cancel(Request &request)
+    {
+    Request *pPrev = nullptr;
+
+    for (auto p = this->m_pQueueHead; p != nullptr; pPrev = p, p = p->m_pNext)
+        {
+        if (p != &request)
+            continue;
+
+        if (pPrev != nullptr)
+            pPrev->m_pNext = p->m_pNext;
+        else
+            this->m_pQueueHead = p->m_pNext;
+        if (this->m_pQueueTail == p)
+            this->m_pQueueTail = pPrev;
+
+        p->m_pNext = nullptr;
+        p->m_fBusy = false;
+        --this->m_nBusy;
+        return true;
+        }
+
+    return false;
+    }
+
+void
+ModbusSerialRequester::poll()
+    {
+    this->m_transport.poll();
+
+    // unlink everything that finished before calling back, so callbacks
+    // can resubmit. The active list is newest first, so pushing onto
+    // the done list puts it oldest first.
+    Request *pDone = nullptr;
+
+    for (Request **pp = &this->m_pActive; *pp != nullptr; )
+        {
+        Request * const p = *pp;
+
+        if (! p->m_txn.isDone())
+            {
+            pp = &p->m_pNext;
+            continue;
+            }
+
+        *pp = p->m_pNext;
+
+        // a device without 0x17 gets the write again as 0x10.
+        if (p->m_txn.function == Transaction::Function::ReadWriteMultipleRegisters &&
+            p->m_txn.status == Transaction::Status::Exception &&
+            p->m_txn.exceptionCode == Transaction::kExceptionIllegalFunction)
+            {
+            auto const unitId = p->m_txn.unitId;
+
+            this->m_readWriteRefused[unitId / 32] |= std::uint32_t(1) << (unitId % 32);
+            p->m_pNext = this->m_pQueueHead;
+            this->m_pQueueHead = p;
+            if (this->m_pQueueTail == nullptr)
+                this->m_pQueueTail = p;
+            continue;
+            }
+
+        p->m_pNext = pDone;
+        pDone = p;
+        }
+
+    this->startQueued();
+
+    while (pDone != nullptr)
+        {
+        Request &request = *pDone;
+
+        pDone = request.m_pNext;
+        request.m_pNext = nullptr;
+        request.decode();
+        request.m_fBusy = false;
+        --this->m_nBusy;
+
+        if (request.m_pDoneFn != nullptr)
+            request.m_pDoneFn(request.m_pDoneCtx, request);
+        }
+
+    // callbacks may have queued more.
+    this->startQueued();
+    }
+
+// hand queued requests to the transport while it will take them.
+void
+ModbusSerialRequester::startQueued()
+    {
+    while (this->m_pQueueHead != nullptr && this->m_transport.isReady())
+        {
+        Request &request = *this->m_pQueueHead;
+
+        this->prepare(request);
+        request.m_txn.responseTimeout = this->m_timing.getResponseTimeout(
+                                            request.m_txn.getResponseBytes(),
+                                            this->m_turnaroundLimit
+                                            );
+        if (! this->m_transport.submit(request.m_txn))
+            break;
+
+        this->m_pQueueHead = request.m_pNext;
+        if (this->m_pQueueHead == nullptr)
+            this->m_pQueueTail = nullptr;
+
+        request.m_pNext = this->m_pActive;
+        this->m_pActive = &request;
+        }
+    }
+
+// choose the function code for a write; reads are already set.
+void
+ModbusSerialRequester::prepare(Request &request)
+    {
+    auto &txn = request.m_txn;
+
+    txn.status = Transaction::Status::Idle;
+    if (request.m_kind != Request::Kind::WriteTx)
+        return;
+
+    auto const writeReg = Request::Protocol::getRegister<Request::Register>(txn.writeAddress);
+
+    if (this->isReadWriteEnabled(txn.unitId))
+        txn.setReadWrite(Request::Register::Status_u16, 1, writeReg, txn.nWrite);
+    else
+        txn.setWrite(writeReg, txn.nWrite);
+    }
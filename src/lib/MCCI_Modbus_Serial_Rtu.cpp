@@ -0,0 +1,151 @@
+/*
+
+Module:  MCCI_Modbus_Serial_Rtu.cpp
+
+Function:
+    ModbusSerialRtu framing.
+
+Copyright notice and License:
+    See LICENSE file accompanying this project.
+
+Author:
+    MCCI Corporation   October 2026
+
+*/
+
+#include "MCCI_Modbus_Serial_Rtu.h"
+#include "MCCI_Modbus_Serial_Pdu.h"
+
+using namespace McciCatena;
+
+using Pdu = ModbusSerialPdu;
+using Function = ModbusSerialTransaction::Function;
+
+std::uint16_t
+ModbusSerialRtu::getCrc(const std::uint8_t *pBuf, std::size_t nBytes)
+    {
+    std::uint16_t crc = 0xFFFF;
+
+    for (std::size_t i = 0; i < nBytes; ++i)
+        {
+        crc ^= pBuf[i];
+        for (unsigned bit = 0; bit < 8; ++bit)
+            crc = (crc & 1) ? std::uint16_t((crc >> 1) ^ 0xA001) : std::uint16_t(crc >> 1);
+        }
+
+    return crc;
+    }
+
+std::size_t
+ModbusSerialRtu::putCrc(std::uint8_t *pBuf, std::size_t nBytes)
+    {
+    auto const crc = getCrc(pBuf, nBytes);
+
+    pBuf[nBytes] = std::uint8_t(crc);
+    pBuf[nBytes + 1] = std::uint8_t(crc >> 8);
+    return nBytes + 2;
+    }
+
+bool
+ModbusSerialRtu::checkCrc(const std::uint8_t *pFrame, std::size_t nFrame)
+    {
+    auto const crc = getCrc(pFrame, nFrame - 2);
+
+    return pFrame[nFrame - 2] == std::uint8_t(crc) &&
+           pFrame[nFrame - 1] == std::uint8_t(crc >> 8);
+    }
+
+std::size_t
+ModbusSerialRtu::encodeRequest(std::uint8_t *pBuf, const Transaction &t)
+    {
+    pBuf[0] = t.unitId;
+    return putCrc(pBuf, 1 + Pdu::encodeRequest(pBuf + 1, t));
+    }
+
+std::size_t
+ModbusSerialRtu::encodeTxWrite(
+    std::uint8_t *pBuf,
+    std::size_t &nSent,
+    std::uint8_t unitId,
+    ModbusSerialProtocol::StatusBits status,
+    const std::uint8_t *pData, std::size_t nData,
+    const std::uint8_t *pWrap, std::size_t nWrap
+    )
+    {
+    auto const nPdu = Pdu::encodeTxWrite(pBuf + 1, nSent, status, pData, nData, pWrap, nWrap);
+
+    if (nPdu == 0)
+        return 0;
+
+    pBuf[0] = unitId;
+    return putCrc(pBuf, 1 + nPdu);
+    }
+
+std::size_t
+ModbusSerialRtu::getResponseSize(const std::uint8_t *pBuf, std::size_t nBuf, const Transaction &t)
+    {
+    if (nBuf < 2)
+        return 0;
+
+    return 3 + Pdu::getResponseSize(t, (pBuf[1] & 0x80) != 0);
+    }
+
+void
+ModbusSerialRtu::decodeResponse(const std::uint8_t *pFrame, std::size_t nFrame, Transaction &t)
+    {
+    if (nFrame < knMinFrameBytes || ! checkCrc(pFrame, nFrame) || pFrame[0] != t.unitId)
+        {
+        t.status = Transaction::Status::Error;
+        return;
+        }
+
+    Pdu::decodeResponse(pFrame + 1, nFrame - 3, t);
+    }
+
+std::size_t
+ModbusSerialRtu::getRequestSize(const std::uint8_t *pBuf, std::size_t nBuf)
+    {
+    if (nBuf < 2)
+        return 0;
+
+    std::size_t nFrame;
+
+    switch (Function(pBuf[1]))
+        {
+    case Function::ReadHoldingRegisters:
+    case Function::ReadInputRegisters:
+        nFrame = 8;
+        break;
+
+    case Function::WriteMultipleRegisters:
+        if (nBuf < 7)
+            return 0;
+        nFrame = 9 + pBuf[6];
+        break;
+
+    case Function::ReadWriteMultipleRegisters:
+        if (nBuf < 11)
+            return 0;
+        nFrame = 13 + pBuf[10];
+        break;
+
+    default:
+        return SIZE_MAX;
+        }
+
+    return nBuf < nFrame ? 0 : nFrame;
+    }
+
+std::size_t
+ModbusSerialRtu::serveRequest(
+    const std::uint8_t *pFrame, std::size_t nFrame,
+    ModbusSerialDevice &device,
+    std::uint8_t *pResponse
+    )
+    {
+    if (nFrame < 4 || ! checkCrc(pFrame, nFrame))
+        return 0;
+
+    pResponse[0] = pFrame[0];
+    return putCrc(pResponse, 1 + Pdu::serveRequest(pFrame + 1, nFrame - 3, device, pResponse + 1));
+    }
@@ -0,0 +1,195 @@
+/*
+
+Module:  MCCI_Modbus_Serial_Scanner.cpp
+
+Function:
+    ModbusSerialScanner.
+
+Copyright notice and License:
+    See LICENSE file accompanying this project.
+
+Author:
+    MCCI Corporation   October 2026
+
+*/
+
+#include "MCCI_Modbus_Serial_Scanner.h"
+
+using namespace McciCatena;
+
+bool
+ModbusSerialScanner::begin(std::uint8_t first, std::uint8_t last)
+    {
+    if (this->isRunning())
+        return false;
+
+    if (first < kMinUnitId)
+        first = kMinUnitId;
+    if (last > kMaxUnitId)
+        last = kMaxUnitId;
+
+    for (auto &unit : this->m_units)
+        unit = Unit();
+
+    this->m_timing.setBaudrate(this->m_transport.getBusBaudrate());
+    this->m_nextUnit = first;
+    this->m_lastUnit = last;
+    return true;
+    }
+
+void
+ModbusSerialScanner::poll()
+    {
+    this->m_transport.poll();
+
+    for (auto &slot : this->m_slots)
+        {
+        if (slot.state == SlotState::Busy && slot.txn.isDone())
+            this->complete(slot);
+        }
+
+    // second reads and retries go first, so units finish in about the
+    // order they started.
+    for (auto &slot : this->m_slots)
+        {
+        if (slot.state == SlotState::Ready && ! this->submit(slot))
+            return;
+        }
+
+    while (this->m_nextUnit <= this->m_lastUnit &&
+           this->m_nActive < this->m_nMaxInFlight &&
+           this->m_transport.isReady())
+        {
+        Slot *pSlot = nullptr;
+
+        for (auto &slot : this->m_slots)
+            {
+            if (slot.state == SlotState::Free)
+                {
+                pSlot = &slot;
+                break;
+                }
+            }
+
+        this->startProbe(*pSlot, std::uint8_t(this->m_nextUnit++), Register::DummyReg_i32, 2);
+        ++this->m_nActive;
+        if (! this->submit(*pSlot))
+            break;
+        }
+    }
+
+std::size_t
+ModbusSerialScanner::getFound(std::uint8_t *pUnits, std::size_t nUnits) const
+    {
+    std::size_t nFound = 0;
+
+    for (unsigned unitId = kMinUnitId; unitId <= kMaxUnitId; ++unitId)
+        {
+        if (this->m_units[unitId].result != Result::Found)
+            continue;
+
+        if (nFound < nUnits)
+            pUnits[nFound] = std::uint8_t(unitId);
+        ++nFound;
+        }
+
+    return nFound;
+    }
+
+void
+ModbusSerialScanner::complete(Slot &slot)
+    {
+    auto const &txn = slot.txn;
+
+    switch (txn.status)
+        {
+    case Transaction::Status::Success:
+        break;
+
+    case Transaction::Status::Exception:
+        // it's a Modbus device, but it doesn't have our registers.
+        this->finish(slot, Result::Foreign);
+        return;
+
+    default:
+        this->retry(slot, Result::Absent);
+        return;
+        }
+
+    if (txn.readAddress == Protocol::getAddress(Register::DummyReg_i32))
+        {
+        // DummyReg is always zero; anything else is somebody else's
+        // register.
+        if (txn.readRegs[0] != 0 || txn.readRegs[1] != 0)
+            this->finish(slot, Result::Foreign);
+        else
+            this->startProbe(slot, txn.unitId, Register::Status_u16, 1);
+        return;
+        }
+
+    StatusBits const status(txn.readRegs[0]);
+
+    if (! isValidStatus(status))
+        {
+        this->finish(slot, Result::Foreign);
+        return;
+        }
+
+    this->m_units[txn.unitId].status = status.getBits();
+    this->finish(slot, Result::Found);
+    }
+
+// try a silent unit again, or give up on it.
+void
+ModbusSerialScanner::retry(Slot &slot, Result result)
+    {
+    if (slot.nTries < this->m_nTries)
+        slot.state = SlotState::Ready;
+    else
+        this->finish(slot, result);
+    }
+
+void
+ModbusSerialScanner::finish(Slot &slot, Result result)
+    {
+    this->m_units[slot.txn.unitId].result = result;
+    slot.state = SlotState::Free;
+    --this->m_nActive;
+    }
+
+void
+ModbusSerialScanner::startProbe(Slot &slot, std::uint8_t unitId, Register reg, std::uint16_t nRegs)
+    {
+    slot.txn.setRead(Transaction::Function::ReadInputRegisters, reg, nRegs);
+    slot.txn.unitId = unitId;
+    slot.txn.responseTimeout = this->m_timing.getResponseTimeout(
+                                    slot.txn.getResponseBytes(),
+                                    this->m_turnaroundLimit
+                                    );
+    slot.nTries = 0;
+    slot.state = SlotState::Ready;
+    }
+
+bool
+ModbusSerialScanner::submit(Slot &slot)
+    {
+    slot.txn.status = Transaction::Status::Idle;
+    if (! this->m_transport.isReady() || ! this->m_transport.submit(slot.txn))
+        return false;
+
+    ++slot.nTries;
+    slot.state = SlotState::Busy;
+    return true;
+    }
+
+// RxAvail and TxAvail fit the windows, and a device whose queue is
+// empty has room in it. Older devices leave TxEmpty (bit 7) zero.
+bool
+ModbusSerialScanner::isValidStatus(StatusBits status)
+    {
+    if (status.getInputAvail() > 2 * Protocol::knRxDataReg ||
+        status.getTxAvail() > 2 * Protocol::knTxDataReg)
+        return false;
+
+    return ! status.isTxEmpty() || status.getTxAvail() != 0;
+    }
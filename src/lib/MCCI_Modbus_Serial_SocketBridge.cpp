@@ -0,0 +1,340 @@
+/*
+
+Module:  MCCI_Modbus_Serial_SocketBridge.cpp
+
+Function:
+    ModbusSerialSocketBridge.
+
+Copyright notice and License:
+    See LICENSE file accompanying this project.
+
+Author:
+    MCCI Corporation   October 2026
+
+*/
+
+#include "MCCI_Modbus_Serial_SocketBridge.h"
+
+#if defined(__linux__) && ! defined(ARDUINO)
+
+#include <arpa/inet.h>
+#include <cerrno>
+#include <cstring>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+using namespace McciCatena;
+
+namespace {
+
+// epoll data is the entry index, shifted, plus one of these; the stop
+// event has a value of its own.
+constexpr std::uint64_t kEventListen = 0;
+constexpr std::uint64_t kEventConn = 1;
+constexpr std::uint64_t kEventRx = 2;
+constexpr std::uint64_t kEventTx = 3;
+constexpr std::uint64_t kEventStop = UINT64_MAX;
+
+void drainEvent(int fd)
+    {
+    std::uint64_t count;
+    (void) ::read(fd, &count, sizeof(count));
+    }
+
+} // namespace
+
+ModbusSerialSocketBridge::~ModbusSerialSocketBridge()
+    {
+    this->end();
+
+    for (std::size_t i = 0; i < this->m_nEntries; ++i)
+        ::close(this->m_entries[i].listenFd);
+    }
+
+bool
+ModbusSerialSocketBridge::add(Client &client, std::uint16_t port, const char *pAddr)
+    {
+    if (this->isRunning() || this->m_nEntries == knMaxPorts)
+        return false;
+
+    sockaddr_storage addr;
+    socklen_t addrLen;
+    auto const pIn4 = reinterpret_cast<sockaddr_in *>(&addr);
+    auto const pIn6 = reinterpret_cast<sockaddr_in6 *>(&addr);
+
+    std::memset(&addr, 0, sizeof(addr));
+    if (pAddr == nullptr)
+        {
+        pIn4->sin_family = AF_INET;
+        pIn4->sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        pIn4->sin_port = htons(port);
+        addrLen = sizeof(*pIn4);
+        }
+    else if (inet_pton(AF_INET, pAddr, &pIn4->sin_addr) == 1)
+        {
+        pIn4->sin_family = AF_INET;
+        pIn4->sin_port = htons(port);
+        addrLen = sizeof(*pIn4);
+        }
+    else if (inet_pton(AF_INET6, pAddr, &pIn6->sin6_addr) == 1)
+        {
+        pIn6->sin6_family = AF_INET6;
+        pIn6->sin6_port = htons(port);
+        addrLen = sizeof(*pIn6);
+        }
+    else
+        return false;
+
+    int const fd = ::socket(addr.ss_family, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (fd < 0)
+        return false;
+
+    int const one = 1;
+    (void) ::setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+
+    socklen_t len = sizeof(addr);
+    if (::bind(fd, reinterpret_cast<sockaddr *>(&addr), addrLen) != 0 ||
+        ::listen(fd, 4) != 0 ||
+        ::getsockname(fd, reinterpret_cast<sockaddr *>(&addr), &len) != 0)
+        {
+        ::close(fd);
+        return false;
+        }
+
+    Entry &entry = this->m_entries[this->m_nEntries++];
+
+    entry.pClient = &client;
+    entry.listenFd = fd;
+    entry.connFd = -1;
+    entry.port = ntohs(addr.ss_family == AF_INET ? pIn4->sin_port : pIn6->sin6_port);
+    return true;
+    }
+
+std::uint16_t
+ModbusSerialSocketBridge::getPort(const Client &client) const
+    {
+    for (std::size_t i = 0; i < this->m_nEntries; ++i)
+        {
+        if (this->m_entries[i].pClient == &client)
+            return this->m_entries[i].port;
+        }
+    return 0;
+    }
+
+bool
+ModbusSerialSocketBridge::begin(int cpu)
+    {
+    if (this->isRunning())
+        return false;
+
+    if (! this->setup())
+        {
+        this->teardown();
+        return false;
+        }
+
+    if (! ModbusSerialThreadControl::start(this->m_thread, [this] { this->run(); }, cpu))
+        {
+        this->end();
+        return false;
+        }
+
+    return true;
+    }
+
+bool
+ModbusSerialSocketBridge::setup()
+    {
+    if (! this->m_control.begin(true))
+        return false;
+
+    this->m_epollFd = ::epoll_create1(EPOLL_CLOEXEC);
+    if (this->m_epollFd < 0)
+        return false;
+
+    epoll_event ev {};
+    ev.events = EPOLLIN;
+    ev.data.u64 = kEventStop;
+    if (::epoll_ctl(this->m_epollFd, EPOLL_CTL_ADD, this->m_control.getStopFd(), &ev) != 0)
+        return false;
+
+    for (std::size_t i = 0; i < this->m_nEntries; ++i)
+        {
+        Entry &entry = this->m_entries[i];
+
+        ev.data.u64 = (std::uint64_t(i) << 2) | kEventListen;
+        if (::epoll_ctl(this->m_epollFd, EPOLL_CTL_ADD, entry.listenFd, &ev) != 0)
+            return false;
+
+        ev.data.u64 = (std::uint64_t(i) << 2) | kEventRx;
+        if (::epoll_ctl(this->m_epollFd, EPOLL_CTL_ADD, entry.pClient->getRxEventFd(), &ev) != 0)
+            return false;
+
+        ev.data.u64 = (std::uint64_t(i) << 2) | kEventTx;
+        if (::epoll_ctl(this->m_epollFd, EPOLL_CTL_ADD, entry.pClient->getTxEventFd(), &ev) != 0)
+            return false;
+        }
+
+    return true;
+    }
+
+void
+ModbusSerialSocketBridge::teardown()
+    {
+    for (std::size_t i = 0; i < this->m_nEntries; ++i)
+        this->disconnect(this->m_entries[i]);
+
+    // closing the epoll instance drops its registrations.
+    if (this->m_epollFd >= 0)
+        {
+        ::close(this->m_epollFd);
+        this->m_epollFd = -1;
+        }
+    this->m_control.end();
+    }
+
+void
+ModbusSerialSocketBridge::end()
+    {
+    if (this->isRunning())
+        {
+        this->m_control.requestStop();
+        ModbusSerialThreadControl::join(this->m_thread);
+        }
+
+    this->teardown();
+    }
+
+void
+ModbusSerialSocketBridge::run()
+    {
+    while (! this->m_control.isStopRequested())
+        {
+        epoll_event events[64];
+        int const n = ::epoll_wait(this->m_epollFd, events, 64, -1);
+
+        if (n < 0 && errno != EINTR)
+            break;
+
+        for (int i = 0; i < n; ++i)
+            {
+            auto const data = events[i].data.u64;
+            if (data == kEventStop)
+                continue;
+
+            Entry &entry = this->m_entries[data >> 2];
+            switch (data & 3)
+                {
+            case kEventListen:
+                this->accept(entry);
+                break;
+
+            case kEventConn:
+                // a reset; an orderly close is seen as end of file.
+                if (events[i].events & (EPOLLERR | EPOLLHUP))
+                    this->disconnect(entry);
+                else
+                    this->pump(entry);
+                break;
+
+            case kEventRx:
+                drainEvent(entry.pClient->getRxEventFd());
+                this->pump(entry);
+                break;
+
+            case kEventTx:
+                drainEvent(entry.pClient->getTxEventFd());
+                entry.pump.clearTxBlocked();
+                this->pump(entry);
+                break;
+                }
+            }
+        }
+    }
+
+// take the waiting connections; keep the first if we have none.
+void
+ModbusSerialSocketBridge::accept(Entry &entry)
+    {
+    for (;;)
+        {
+        int const fd = ::accept4(entry.listenFd, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+
+        if (fd < 0)
+            {
+            if (errno == EINTR || errno == ECONNABORTED)
+                continue;
+            return;
+            }
+
+        if (entry.connFd >= 0)
+            {
+            ::close(fd);
+            continue;
+            }
+
+        // interactive traffic: don't hold small writes back.
+        int const one = 1;
+        (void) ::setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+
+        epoll_event ev {};
+        ev.events = EPOLLIN;
+        ev.data.u64 = (std::uint64_t(&entry - this->m_entries) << 2) | kEventConn;
+        if (::epoll_ctl(this->m_epollFd, EPOLL_CTL_ADD, fd, &ev) != 0)
+            {
+            ::close(fd);
+            continue;
+            }
+
+        entry.connFd = fd;
+        entry.events = EPOLLIN;
+        entry.pump.reset();
+        this->pump(entry);
+        }
+    }
+
+// move whatever can move, each way; close the connection if it's done.
+void
+ModbusSerialSocketBridge::pump(Entry &entry)
+    {
+    if (entry.connFd < 0)
+        return;
+
+    if (! entry.pump.pump(*entry.pClient, entry.connFd) || ! this->updateEvents(entry))
+        this->disconnect(entry);
+    }
+
+void
+ModbusSerialSocketBridge::disconnect(Entry &entry)
+    {
+    if (entry.connFd < 0)
+        return;
+
+    // closing the fd drops it from the epoll set.
+    ::close(entry.connFd);
+    entry.connFd = -1;
+    entry.pump.reset();
+    }
+
+bool
+ModbusSerialSocketBridge::updateEvents(Entry &entry)
+    {
+    std::uint32_t const events = entry.pump.getEvents();
+
+    if (events == entry.events)
+        return true;
+
+    epoll_event ev {};
+    ev.events = events;
+    ev.data.u64 = (std::uint64_t(&entry - this->m_entries) << 2) | kEventConn;
+    if (::epoll_ctl(this->m_epollFd, EPOLL_CTL_MOD, entry.connFd, &ev) != 0)
+        return false;
+
+    entry.events = events;
+    return true;
+    }
+
+#endif // defined(__linux__) && ! defined(ARDUINO)
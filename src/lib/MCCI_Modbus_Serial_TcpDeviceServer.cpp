@@ -0,0 +1,288 @@
+/*
+
+Module:  MCCI_Modbus_Serial_TcpDeviceServer.cpp
+
+Function:
+    ModbusSerialTcpDeviceServer.
+
+Copyright notice and License:
+    See LICENSE file accompanying this project.
+
+Author:
+    MCCI Corporation   October 2026
+
+*/
+
+#include "MCCI_Modbus_Serial_TcpDeviceServer.h"
+
+#if defined(__linux__) && ! defined(ARDUINO)
+
+#include "MCCI_Modbus_Serial_Transport.h"
+
+#include <arpa/inet.h>
+#include <cerrno>
+#include <cstring>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+using namespace McciCatena;
+
+bool
+ModbusSerialTcpDeviceServer::begin(std::uint16_t port)
+    {
+    this->end();
+
+    int const fd = ::socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (fd < 0)
+        return false;
+
+    int const one = 1;
+    (void) ::setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+
+    sockaddr_in addr;
+    std::memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(port);
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+    socklen_t len = sizeof(addr);
+    if (::bind(fd, reinterpret_cast<sockaddr *>(&addr), sizeof(addr)) != 0 ||
+        ::listen(fd, int(knMaxClients)) != 0 ||
+        ::getsockname(fd, reinterpret_cast<sockaddr *>(&addr), &len) != 0)
+        {
+        ::close(fd);
+        return false;
+        }
+
+    this->m_listenFd = fd;
+    this->m_port = ntohs(addr.sin_port);
+    return true;
+    }
+
+void
+ModbusSerialTcpDeviceServer::end()
+    {
+    for (auto &client : this->m_clients)
+        this->close(client);
+
+    if (this->m_listenFd >= 0)
+        {
+        ::close(this->m_listenFd);
+        this->m_listenFd = -1;
+        }
+    }
+
+bool
+ModbusSerialTcpDeviceServer::attach(std::uint8_t unitId, Device &device)
+    {
+    Entry *pFree = nullptr;
+
+    // replace the unit's entry if it has one, so it never has two.
+    for (auto &e : this->m_devices)
+        {
+        if (e.pDevice != nullptr && e.unitId == unitId)
+            {
+            e.pDevice = &device;
+            return true;
+            }
+        if (e.pDevice == nullptr && pFree == nullptr)
+            pFree = &e;
+        }
+
+    if (pFree == nullptr)
+        return false;
+
+    pFree->unitId = unitId;
+    pFree->pDevice = &device;
+    return true;
+    }
+
+void
+ModbusSerialTcpDeviceServer::detach(std::uint8_t unitId)
+    {
+    for (auto &e : this->m_devices)
+        {
+        if (e.pDevice != nullptr && e.unitId == unitId)
+            e.pDevice = nullptr;
+        }
+    }
+
+ModbusSerialTcpDeviceServer::Device *
+ModbusSerialTcpDeviceServer::findDevice(std::uint8_t unitId) const
+    {
+    for (auto const &e : this->m_devices)
+        {
+        if (e.pDevice != nullptr && e.unitId == unitId)
+            return e.pDevice;
+        }
+    return nullptr;
+    }
+
+void
+ModbusSerialTcpDeviceServer::poll()
+    {
+    if (this->m_listenFd < 0)
+        return;
+
+    auto const now = Internal::getMicros();
+
+    this->accept();
+    for (auto &client : this->m_clients)
+        {
+        if (client.fd >= 0 && ! this->serviceClient(client, now))
+            this->close(client);
+        }
+    }
+
+void
+ModbusSerialTcpDeviceServer::accept()
+    {
+    for (;;)
+        {
+        int const fd = ::accept4(this->m_listenFd, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (fd < 0)
+            return;
+
+        Client *pClient = nullptr;
+        for (auto &client : this->m_clients)
+            {
+            if (client.fd < 0)
+                {
+                pClient = &client;
+                break;
+                }
+            }
+
+        if (pClient == nullptr)
+            {
+            ::close(fd);
+            continue;
+            }
+
+        int const one = 1;
+        (void) ::setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+
+        pClient->fd = fd;
+        pClient->nRx = 0;
+        pClient->iHead = 0;
+        pClient->nQueued = 0;
+        pClient->nSent = 0;
+        }
+    }
+
+bool
+ModbusSerialTcpDeviceServer::serviceClient(Client &client, std::uint32_t now)
+    {
+    return this->receive(client, now) && this->send(client, now);
+    }
+
+// read and serve requests while there's room to queue the responses.
+bool
+ModbusSerialTcpDeviceServer::receive(Client &client, std::uint32_t now)
+    {
+    for (;;)
+        {
+        // serve what's already buffered first.
+        std::size_t iAdu = 0;
+
+        while (client.nQueued < knMaxQueued)
+            {
+            auto const nAdu = Mbap::getAduSize(&client.rxBuf[iAdu], client.nRx - iAdu);
+
+            if (nAdu == SIZE_MAX)
+                return false;
+            if (nAdu == 0)
+                break;
+
+            std::size_t iTail = client.iHead + client.nQueued;
+            if (iTail >= knMaxQueued)
+                iTail -= knMaxQueued;
+
+            Response &response = client.queue[iTail];
+            const std::uint8_t * const pAdu = &client.rxBuf[iAdu];
+
+            response.nBytes = std::uint16_t(
+                Mbap::serveRequest(pAdu, nAdu, this->findDevice(Mbap::getUnitId(pAdu)), response.adu)
+                );
+            response.tDue = now + this->m_responseDelay;
+
+            if (++client.nQueued > this->m_maxQueued)
+                this->m_maxQueued = client.nQueued;
+            ++this->m_nRequests;
+            iAdu += nAdu;
+            }
+
+        std::memmove(client.rxBuf, &client.rxBuf[iAdu], client.nRx - iAdu);
+        client.nRx -= iAdu;
+
+        if (client.nQueued == knMaxQueued || client.nRx == sizeof(client.rxBuf))
+            return true;
+
+        auto const n = ::recv(client.fd, &client.rxBuf[client.nRx], sizeof(client.rxBuf) - client.nRx, 0);
+
+        if (n == 0)
+            return false;
+        if (n < 0)
+            {
+            if (errno == EINTR)
+                continue;
+            return errno == EAGAIN || errno == EWOULDBLOCK;
+            }
+
+        client.nRx += std::size_t(n);
+        }
+    }
+
+// send the responses that are due, in order.
+bool
+ModbusSerialTcpDeviceServer::send(Client &client, std::uint32_t now)
+    {
+    while (client.nQueued != 0)
+        {
+        Response &response = client.queue[client.iHead];
+
+        if (std::int32_t(now - response.tDue) < 0)
+            return true;
+
+        auto const n = ::send(
+                            client.fd,
+                            &response.adu[client.nSent],
+                            response.nBytes - client.nSent,
+                            MSG_NOSIGNAL
+                            );
+        if (n < 0)
+            {
+            if (errno == EINTR)
+                continue;
+            return errno == EAGAIN || errno == EWOULDBLOCK;
+            }
+
+        client.nSent += std::size_t(n);
+        if (client.nSent < response.nBytes)
+            return true;
+
+        client.nSent = 0;
+        if (++client.iHead == knMaxQueued)
+            client.iHead = 0;
+        --client.nQueued;
+        }
+
+    return true;
+    }
+
+void
+ModbusSerialTcpDeviceServer::close(Client &client)
+    {
+    if (client.fd >= 0)
+        {
+        ::close(client.fd);
+        client.fd = -1;
+        }
+    client.nRx = 0;
+    client.nQueued = 0;
+    client.nSent = 0;
+    }
+
+#endif // defined(__linux__) && ! defined(ARDUINO)
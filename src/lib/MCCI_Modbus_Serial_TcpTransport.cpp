@@ -0,0 +1,335 @@
+/*
+
+Module:  MCCI_Modbus_Serial_TcpTransport.cpp
+
+Function:
+    ModbusSerialTcpTransport.
+
+Copyright notice and License:
+    See LICENSE file accompanying this project.
+
+Author:
+    MCCI Corporation   October 2026
+
+*/
+
+#include "MCCI_Modbus_Serial_TcpTransport.h"
+
+#if defined(__linux__) && ! defined(ARDUINO)
+
+#include <arpa/inet.h>
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+using namespace McciCatena;
+
+bool
+ModbusSerialTcpTransport::begin(const char *pAddress, std::uint16_t port)
+    {
+    this->end();
+
+    std::memset(&this->m_addr, 0, sizeof(this->m_addr));
+
+    auto const pIn4 = reinterpret_cast<sockaddr_in *>(&this->m_addr);
+    auto const pIn6 = reinterpret_cast<sockaddr_in6 *>(&this->m_addr);
+
+    if (inet_pton(AF_INET, pAddress, &pIn4->sin_addr) == 1)
+        {
+        pIn4->sin_family = AF_INET;
+        pIn4->sin_port = htons(port);
+        this->m_addrLen = sizeof(*pIn4);
+        }
+    else if (inet_pton(AF_INET6, pAddress, &pIn6->sin6_addr) == 1)
+        {
+        pIn6->sin6_family = AF_INET6;
+        pIn6->sin6_port = htons(port);
+        this->m_addrLen = sizeof(*pIn6);
+        }
+    else
+        return false;
+
+    return this->connect();
+    }
+
+void
+ModbusSerialTcpTransport::end()
+    {
+    this->fail(this->getMicros());
+    this->m_state = State::Closed;
+    }
+
+// start a non-blocking connect.
+bool
+ModbusSerialTcpTransport::connect()
+    {
+    auto const pAddr = reinterpret_cast<const sockaddr *>(&this->m_addr);
+    int const fd = ::socket(pAddr->sa_family, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+
+    if (fd < 0)
+        {
+        this->m_state = State::Backoff;
+        this->m_tBackoff = this->getMicros();
+        return false;
+        }
+
+    // requests are small and latency matters more than packet count.
+    int const one = 1;
+    (void) ::setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+
+    this->m_fd = fd;
+    this->m_nTx = 0;
+    this->m_nRx = 0;
+
+    if (::connect(fd, pAddr, this->m_addrLen) == 0)
+        this->m_state = State::Connected;
+    else if (errno == EINPROGRESS)
+        this->m_state = State::Connecting;
+    else
+        {
+        this->fail(this->getMicros());
+        return false;
+        }
+
+    return true;
+    }
+
+// drop the connection, fail everything outstanding, and schedule a
+// reconnect.
+void
+ModbusSerialTcpTransport::fail(std::uint32_t now)
+    {
+    if (this->m_fd >= 0)
+        {
+        ::close(this->m_fd);
+        this->m_fd = -1;
+        }
+
+    for (auto &pending : this->m_pending)
+        {
+        if (pending.pTxn != nullptr)
+            {
+            pending.pTxn->status = Transaction::Status::Error;
+            pending.pTxn = nullptr;
+            }
+        }
+
+    this->m_nPending = 0;
+    this->m_nTx = 0;
+    this->m_nRx = 0;
+    this->m_state = State::Backoff;
+    this->m_tBackoff = now;
+    }
+
+bool
+ModbusSerialTcpTransport::isReady() const
+    {
+    return this->m_state == State::Connected &&
+           this->m_nPending < this->m_nMaxPending &&
+           sizeof(this->m_txBuf) - this->m_nTx >= Mbap::knMaxAduBytes;
+    }
+
+bool
+ModbusSerialTcpTransport::submit(Transaction &t)
+    {
+    if (! this->isReady())
+        return false;
+
+    Pending *pSlot = nullptr;
+    for (auto &pending : this->m_pending)
+        {
+        if (pending.pTxn == nullptr)
+            {
+            pSlot = &pending;
+            break;
+            }
+        }
+
+    // IDs wrap after 65536 transactions; skip any still in use.
+    std::uint16_t id;
+    bool fInUse;
+    do  {
+        id = this->m_nextTransactionId++;
+        fInUse = false;
+        for (auto const &pending : this->m_pending)
+            fInUse = fInUse || (pending.pTxn != nullptr && pending.transactionId == id);
+        } while (fInUse);
+
+    this->m_nTx += Mbap::encodeRequest(&this->m_txBuf[this->m_nTx], id, t);
+
+    auto const timeout = t.responseTimeout != 0 ? t.responseTimeout : this->m_responseTimeout;
+
+    t.status = Transaction::Status::Pending;
+    pSlot->pTxn = &t;
+    pSlot->transactionId = id;
+    pSlot->tDeadline = this->getMicros() + timeout;
+    ++this->m_nPending;
+
+    // get it on the wire now; whatever doesn't fit goes from poll().
+    if (! this->send())
+        this->fail(this->getMicros());
+    return true;
+    }
+
+void
+ModbusSerialTcpTransport::poll()
+    {
+    auto const now = this->getMicros();
+
+    switch (this->m_state)
+        {
+    case State::Closed:
+        return;
+
+    case State::Backoff:
+        if (now - this->m_tBackoff >= this->m_reconnectInterval)
+            this->connect();
+        return;
+
+    case State::Connecting:
+        this->checkConnect(now);
+        return;
+
+    case State::Connected:
+        break;
+        }
+
+    if (! this->send() || ! this->receive())
+        {
+        this->fail(now);
+        return;
+        }
+
+    this->expire(now);
+    }
+
+// see whether a non-blocking connect has finished.
+void
+ModbusSerialTcpTransport::checkConnect(std::uint32_t now)
+    {
+    pollfd pfd;
+
+    pfd.fd = this->m_fd;
+    pfd.events = POLLOUT;
+    pfd.revents = 0;
+    if (::poll(&pfd, 1, 0) <= 0)
+        return;
+
+    int error = 0;
+    socklen_t len = sizeof(error);
+
+    if (::getsockopt(this->m_fd, SOL_SOCKET, SO_ERROR, &error, &len) != 0 || error != 0)
+        this->fail(now);
+    else
+        this->m_state = State::Connected;
+    }
+
+// write as much queued output as the socket takes; false on error.
+bool
+ModbusSerialTcpTransport::send()
+    {
+    if (this->m_state != State::Connected)
+        return true;
+
+    std::size_t nSent = 0;
+
+    while (nSent < this->m_nTx)
+        {
+        auto const n = ::send(this->m_fd, &this->m_txBuf[nSent], this->m_nTx - nSent, MSG_NOSIGNAL);
+
+        if (n > 0)
+            nSent += std::size_t(n);
+        else if (n < 0 && errno == EINTR)
+            continue;
+        else if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK))
+            break;
+        else
+            return false;
+        }
+
+    if (nSent != 0)
+        {
+        std::memmove(this->m_txBuf, &this->m_txBuf[nSent], this->m_nTx - nSent);
+        this->m_nTx -= nSent;
+        }
+    return true;
+    }
+
+// read what has arrived and complete transactions; false on error or
+// when the gateway closes the connection.
+bool
+ModbusSerialTcpTransport::receive()
+    {
+    for (;;)
+        {
+        auto const n = ::recv(this->m_fd, &this->m_rxBuf[this->m_nRx], sizeof(this->m_rxBuf) - this->m_nRx, 0);
+
+        if (n == 0)
+            return false;
+        if (n < 0)
+            {
+            if (errno == EINTR)
+                continue;
+            return errno == EAGAIN || errno == EWOULDBLOCK;
+            }
+
+        this->m_nRx += std::size_t(n);
+
+        std::size_t iAdu = 0;
+        for (;;)
+            {
+            auto const nAdu = Mbap::getAduSize(&this->m_rxBuf[iAdu], this->m_nRx - iAdu);
+
+            if (nAdu == SIZE_MAX)
+                return false;
+            if (nAdu == 0)
+                break;
+
+            this->complete(&this->m_rxBuf[iAdu], nAdu);
+            iAdu += nAdu;
+            }
+
+        std::memmove(this->m_rxBuf, &this->m_rxBuf[iAdu], this->m_nRx - iAdu);
+        this->m_nRx -= iAdu;
+        }
+    }
+
+// match a response to its transaction; drop it if nobody's waiting (it
+// timed out).
+void
+ModbusSerialTcpTransport::complete(const std::uint8_t *pAdu, std::size_t nAdu)
+    {
+    auto const id = Mbap::getTransactionId(pAdu);
+
+    for (auto &pending : this->m_pending)
+        {
+        if (pending.pTxn != nullptr && pending.transactionId == id)
+            {
+            Mbap::decodeResponse(pAdu, nAdu, *pending.pTxn);
+            pending.pTxn = nullptr;
+            --this->m_nPending;
+            return;
+            }
+        }
+    }
+
+void
+ModbusSerialTcpTransport::expire(std::uint32_t now)
+    {
+    for (auto &pending : this->m_pending)
+        {
+        if (pending.pTxn != nullptr && std::int32_t(now - pending.tDeadline) >= 0)
+            {
+            pending.pTxn->status = Transaction::Status::NoReply;
+            pending.pTxn = nullptr;
+            --this->m_nPending;
+            }
+        }
+    }
+
+#endif // defined(__linux__) && ! defined(ARDUINO)
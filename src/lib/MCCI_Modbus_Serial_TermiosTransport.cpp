@@ -0,0 +1,336 @@
+/*
+
+Module:  MCCI_Modbus_Serial_TermiosTransport.cpp
+
+Function:
+    ModbusSerialTermiosTransport.
+
+Copyright notice and License:
+    See LICENSE file accompanying this project.
+
+Author:
+    MCCI Corporation   October 2026
+
+*/
+
+#include "MCCI_Modbus_Serial_TermiosTransport.h"
+
+#if defined(__linux__) && ! defined(ARDUINO)
+
+#include <cerrno>
+#include <fcntl.h>
+#include <termios.h>
+#include <unistd.h>
+
+using namespace McciCatena;
+
+namespace {
+
+speed_t getSpeed(std::uint32_t baudrate)
+    {
+    switch (baudrate)
+        {
+    case 1200:      return B1200;
+    case 2400:      return B2400;
+    case 4800:      return B4800;
+    case 9600:      return B9600;
+    case 19200:     return B19200;
+    case 38400:     return B38400;
+    case 57600:     return B57600;
+    case 115200:    return B115200;
+    case 230400:    return B230400;
+    case 460800:    return B460800;
+    case 921600:    return B921600;
+    default:        return B0;
+        }
+    }
+
+} // namespace
+
+bool
+ModbusSerialTermiosTransport::begin(const char *pPath, std::uint32_t baudrate, Parity parity)
+    {
+    this->end();
+
+    speed_t const speed = getSpeed(baudrate);
+    if (speed == B0)
+        return false;
+
+    int const fd = ::open(pPath, O_RDWR | O_NOCTTY | O_NONBLOCK | O_CLOEXEC);
+    if (fd < 0)
+        return false;
+
+    termios tio;
+    if (::tcgetattr(fd, &tio) != 0)
+        {
+        ::close(fd);
+        return false;
+        }
+
+    ::cfmakeraw(&tio);
+    tio.c_cflag |= CLOCAL | CREAD;
+    tio.c_cflag &= ~(PARENB | PARODD | CSTOPB);
+    switch (parity)
+        {
+    case Parity::Even:
+        tio.c_cflag |= PARENB;
+        break;
+    case Parity::Odd:
+        tio.c_cflag |= PARENB | PARODD;
+        break;
+    case Parity::None:
+        tio.c_cflag |= CSTOPB;
+        break;
+        }
+
+    // reads return whatever has arrived, without waiting.
+    tio.c_cc[VMIN] = 0;
+    tio.c_cc[VTIME] = 0;
+
+    if (::cfsetispeed(&tio, speed) != 0 ||
+        ::cfsetospeed(&tio, speed) != 0 ||
+        ::tcsetattr(fd, TCSANOW, &tio) != 0)
+        {
+        ::close(fd);
+        return false;
+        }
+
+    (void) ::tcflush(fd, TCIOFLUSH);
+
+    this->m_fd = fd;
+    this->m_timing.setBaudrate(baudrate);
+    this->m_state = State::Idle;
+    this->m_nRx = 0;
+    this->m_tNextRequest = this->getMicros();
+    return true;
+    }
+
+void
+ModbusSerialTermiosTransport::end()
+    {
+    if (this->m_pActive != nullptr)
+        this->complete(Transaction::Status::Error, this->getMicros());
+
+    if (this->m_fd >= 0)
+        {
+        ::close(this->m_fd);
+        this->m_fd = -1;
+        }
+    }
+
+bool
+ModbusSerialTermiosTransport::submit(Transaction &t)
+    {
+    if (! this->isReady())
+        return false;
+
+    auto const now = this->getMicros();
+
+    this->m_nTx = Rtu::encodeRequest(this->m_txBuf, t);
+    this->m_pActive = &t;
+    t.status = Transaction::Status::Pending;
+
+    // accepted during the gap after the last frame; sent at its end.
+    this->m_tStart = now;
+    if (std::int32_t(this->m_tNextRequest - now) > 0)
+        this->m_tStart = this->m_tNextRequest;
+
+    this->m_state = State::Gap;
+    if (this->m_tStart == now)
+        this->startSending(now);
+
+    return true;
+    }
+
+std::uint32_t
+ModbusSerialTermiosTransport::getWakeDelay(std::uint32_t now) const
+    {
+    std::uint32_t tWake;
+
+    switch (this->m_state)
+        {
+    case State::Gap:
+        tWake = this->m_tStart;
+        break;
+
+    case State::Receiving:
+        tWake = this->m_tDeadline;
+        if (this->m_nRx != 0 && std::int32_t(tWake - (this->m_tLastByte + this->getSilence())) > 0)
+            tWake = this->m_tLastByte + this->getSilence();
+        break;
+
+    default:
+        return UINT32_MAX;
+        }
+
+    auto const delay = std::int32_t(tWake - now);
+    return delay > 0 ? std::uint32_t(delay) : 0;
+    }
+
+void
+ModbusSerialTermiosTransport::poll()
+    {
+    if (this->m_fd < 0)
+        return;
+
+    auto const now = this->getMicros();
+
+    // finish the request first: a write that completes asynchronously
+    // may be reported together with the start of the response.
+    if (this->m_state == State::Sending)
+        this->send(now);
+
+    // always drain input, so a stray frame doesn't keep the fd readable.
+    this->receive(now);
+
+    switch (this->m_state)
+        {
+    case State::Gap:
+        if (std::int32_t(now - this->m_tStart) >= 0)
+            this->startSending(now);
+        break;
+
+    case State::Receiving:
+        if (this->m_nRx != 0 && now - this->m_tLastByte >= this->getSilence())
+            {
+            // the response stopped short.
+            Rtu::decodeResponse(this->m_rxBuf, this->m_nRx, *this->m_pActive);
+            this->finish(now);
+            }
+        else if (std::int32_t(now - this->m_tDeadline) >= 0)
+            this->complete(
+                this->m_nRx == 0 ? Transaction::Status::NoReply : Transaction::Status::Error,
+                now
+                );
+        break;
+
+    default:
+        break;
+        }
+    }
+
+void
+ModbusSerialTermiosTransport::startSending(std::uint32_t now)
+    {
+    // anything left over belongs to an earlier exchange.
+    this->flushInput();
+    this->m_nRx = 0;
+    this->m_nSent = 0;
+    this->m_state = State::Sending;
+    this->send(now);
+    }
+
+void
+ModbusSerialTermiosTransport::send(std::uint32_t now)
+    {
+    while (this->m_nSent < this->m_nTx)
+        {
+        auto const n = this->writeOutput(&this->m_txBuf[this->m_nSent], this->m_nTx - this->m_nSent);
+
+        if (n > 0)
+            this->m_nSent += std::size_t(n);
+        else if (n < 0 && errno == EINTR)
+            continue;
+        else if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK))
+            return;
+        else
+            {
+            this->complete(Transaction::Status::Error, now);
+            return;
+            }
+        }
+
+    // the frame is still going out of the UART; the response timeout
+    // runs from its end.
+    auto const &t = *this->m_pActive;
+    auto const timeout = t.responseTimeout != 0
+                            ? t.responseTimeout
+                            : this->m_timing.getResponseTimeout(t.getResponseBytes(), this->m_turnaroundLimit);
+
+    this->m_tDeadline = now + this->m_timing.getFrameMicros(std::uint32_t(this->m_nTx)) + timeout;
+    this->m_state = State::Receiving;
+    }
+
+void
+ModbusSerialTermiosTransport::receive(std::uint32_t now)
+    {
+    for (;;)
+        {
+        std::uint8_t discard[64];
+        std::uint8_t *pBuf = discard;
+        std::size_t nBuf = sizeof(discard);
+
+        if (this->m_state == State::Receiving && this->m_nRx < sizeof(this->m_rxBuf))
+            {
+            pBuf = &this->m_rxBuf[this->m_nRx];
+            nBuf = sizeof(this->m_rxBuf) - this->m_nRx;
+            }
+
+        auto const n = this->readInput(pBuf, nBuf);
+
+        if (n < 0 && errno == EINTR)
+            continue;
+        if (n <= 0)
+            return;
+
+        if (pBuf == discard)
+            continue;
+
+        this->m_nRx += std::size_t(n);
+        this->m_tLastByte = now;
+
+        auto const nExpected = Rtu::getResponseSize(this->m_rxBuf, this->m_nRx, *this->m_pActive);
+        if (nExpected != 0 && this->m_nRx >= nExpected)
+            {
+            Rtu::decodeResponse(this->m_rxBuf, nExpected, *this->m_pActive);
+            this->finish(now);
+            }
+        }
+    }
+
+// the active transaction's status is set; release it.
+void
+ModbusSerialTermiosTransport::finish(std::uint32_t now)
+    {
+    if (this->m_pActive->status == Transaction::Status::Error)
+        ++this->m_nErrors;
+
+    this->m_pActive = nullptr;
+    this->m_state = State::Idle;
+    this->m_tNextRequest = this->m_timing.getNextRequestTime(now);
+    }
+
+void
+ModbusSerialTermiosTransport::complete(Transaction::Status status, std::uint32_t now)
+    {
+    this->m_pActive->status = status;
+    this->finish(now);
+    }
+
+ssize_t
+ModbusSerialTermiosTransport::readInput(std::uint8_t *pBuf, std::size_t nBuf)
+    {
+    return ::read(this->m_fd, pBuf, nBuf);
+    }
+
+ssize_t
+ModbusSerialTermiosTransport::writeOutput(const std::uint8_t *pBuf, std::size_t nBuf)
+    {
+    return ::write(this->m_fd, pBuf, nBuf);
+    }
+
+void
+ModbusSerialTermiosTransport::flushInput()
+    {
+    (void) ::tcflush(this->m_fd, TCIFLUSH);
+    }
+
+std::uint32_t
+ModbusSerialTermiosTransport::getSilence() const
+    {
+    auto const t35 = this->m_timing.getT35();
+
+    return t35 > kMinSilence ? t35 : kMinSilence;
+    }
+
+#endif // defined(__linux__) && ! defined(ARDUINO)
@@ -0,0 +1,75 @@
+/*
+
+Module:  MCCI_Modbus_Serial_ThreadControl.cpp
+
+Function:
+    ModbusSerialThreadControl.
+
+Copyright notice and License:
+    See LICENSE file accompanying this project.
+
+Author:
+    MCCI Corporation   October 2026
+
+*/
+
+#include "MCCI_Modbus_Serial_ThreadControl.h"
+
+#if defined(__linux__) && ! defined(ARDUINO)
+
+#include <cstdint>
+#include <pthread.h>
+#include <sched.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+using namespace McciCatena;
+
+bool
+ModbusSerialThreadControl::begin(bool fStopFd)
+    {
+    this->end();
+    this->m_fStop.store(false);
+
+    if (fStopFd)
+        this->m_stopFd = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+
+    return ! fStopFd || this->m_stopFd >= 0;
+    }
+
+void
+ModbusSerialThreadControl::end()
+    {
+    if (this->m_stopFd >= 0)
+        {
+        ::close(this->m_stopFd);
+        this->m_stopFd = -1;
+        }
+    }
+
+void
+ModbusSerialThreadControl::requestStop()
+    {
+    this->m_fStop.store(true);
+
+    if (this->m_stopFd >= 0)
+        {
+        std::uint64_t const one = 1;
+
+        (void) ::write(this->m_stopFd, &one, sizeof(one));
+        }
+    }
+
+bool
+ModbusSerialThreadControl::pin(std::thread &thread, int cpu)
+    {
+    if (cpu < 0)
+        return true;
+
+    cpu_set_t cpus;
+    CPU_ZERO(&cpus);
+    CPU_SET(cpu, &cpus);
+    return ::pthread_setaffinity_np(thread.native_handle(), sizeof(cpus), &cpus) == 0;
+    }
+
+#endif // defined(__linux__) && ! defined(ARDUINO)
@@ -0,0 +1,496 @@
+/*
+
+Module:  MCCI_Modbus_Serial_UringLoop.cpp
+
+Function:
+    ModbusSerialUringLoop.
+
+Copyright notice and License:
+    See LICENSE file accompanying this project.
+
+Author:
+    MCCI Corporation   October 2026
+
+*/
+
+#include "MCCI_Modbus_Serial_UringLoop.h"
+
+#if defined(__linux__) && ! defined(ARDUINO) && defined(MCCI_MODBUS_SERIAL_IO_URING)
+
+#include <cerrno>
+#include <cstring>
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+using namespace McciCatena;
+
+namespace {
+
+// user data: the entry index, shifted, and which operation.
+constexpr std::uint64_t kOpRead = 0;
+constexpr std::uint64_t kOpWrite = 1;
+constexpr std::uint64_t kUserDataCancel = ~std::uint64_t(0);
+
+// how long remove() waits for cancelled I/O, in microseconds.
+constexpr std::uint32_t kCancelWait = 100 * 1000;
+
+void *mapRing(int fd, std::size_t nBytes, off_t offset)
+    {
+    void * const p = ::mmap(nullptr, nBytes, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, offset);
+    return p == MAP_FAILED ? nullptr : p;
+    }
+
+template <typename T>
+T *ringPointer(void *pBase, std::uint32_t offset)
+    {
+    return reinterpret_cast<T *>(static_cast<std::uint8_t *>(pBase) + offset);
+    }
+
+} // namespace
+
+bool
+ModbusSerialUringLoop::begin()
+    {
+    this->end();
+
+    io_uring_params params;
+    std::memset(&params, 0, sizeof(params));
+
+    // a read and a write in flight per port.
+    int const fd = int(::syscall(__NR_io_uring_setup, unsigned(2 * knMaxPorts), &params));
+    if (fd < 0)
+        return false;
+
+    this->m_ringFd = fd;
+    if (! (params.features & IORING_FEAT_EXT_ARG))
+        {
+        this->end();
+        return false;
+        }
+
+    auto &ring = this->m_ring;
+
+    ring.nSqRing = params.sq_off.array + params.sq_entries * sizeof(std::uint32_t);
+    ring.nCqRing = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+    if (params.features & IORING_FEAT_SINGLE_MMAP)
+        {
+        if (ring.nCqRing > ring.nSqRing)
+            ring.nSqRing = ring.nCqRing;
+        ring.nCqRing = 0;
+        }
+
+    ring.pSqRing = mapRing(fd, ring.nSqRing, IORING_OFF_SQ_RING);
+    ring.pCqRing = ring.nCqRing == 0 ? ring.pSqRing : mapRing(fd, ring.nCqRing, IORING_OFF_CQ_RING);
+    ring.nSqes = params.sq_entries * sizeof(io_uring_sqe);
+    ring.pSqes = mapRing(fd, ring.nSqes, IORING_OFF_SQES);
+    if (ring.pSqRing == nullptr || ring.pCqRing == nullptr || ring.pSqes == nullptr)
+        {
+        this->end();
+        return false;
+        }
+
+    ring.pSqHead = ringPointer<std::uint32_t>(ring.pSqRing, params.sq_off.head);
+    ring.pSqTail = ringPointer<std::uint32_t>(ring.pSqRing, params.sq_off.tail);
+    ring.pSqArray = ringPointer<std::uint32_t>(ring.pSqRing, params.sq_off.array);
+    ring.sqMask = *ringPointer<std::uint32_t>(ring.pSqRing, params.sq_off.ring_mask);
+    ring.pCqHead = ringPointer<std::uint32_t>(ring.pCqRing, params.cq_off.head);
+    ring.pCqTail = ringPointer<std::uint32_t>(ring.pCqRing, params.cq_off.tail);
+    ring.pCqes = ringPointer<void>(ring.pCqRing, params.cq_off.cqes);
+    ring.cqMask = *ringPointer<std::uint32_t>(ring.pCqRing, params.cq_off.ring_mask);
+
+    // register every port's buffers once, so fixed reads and writes
+    // needn't map them each time.
+    this->m_pRxBufs = new std::uint8_t[knMaxPorts][Port::knRxBufferBytes];
+    this->m_pTxBufs = new std::uint8_t[knMaxPorts][Port::knTxBufferBytes];
+
+    iovec iov[2 * knMaxPorts];
+    for (std::size_t i = 0; i < knMaxPorts; ++i)
+        {
+        iov[i].iov_base = this->m_pRxBufs[i];
+        iov[i].iov_len = Port::knRxBufferBytes;
+        iov[knMaxPorts + i].iov_base = this->m_pTxBufs[i];
+        iov[knMaxPorts + i].iov_len = Port::knTxBufferBytes;
+        }
+
+    if (::syscall(__NR_io_uring_register, fd, IORING_REGISTER_BUFFERS, iov, unsigned(2 * knMaxPorts)) != 0)
+        {
+        this->end();
+        return false;
+        }
+
+    return true;
+    }
+
+void
+ModbusSerialUringLoop::end()
+    {
+    for (auto &entry : this->m_entries)
+        {
+        if (entry.pPort != nullptr)
+            this->remove(*entry.pPort);
+        }
+
+    // give I/O orphaned by remove() a last chance to finish.
+    auto const tStart = Internal::getMicros();
+    while (this->hasOrphans() && Internal::getMicros() - tStart < kCancelWait)
+        {
+        if (! this->enter(this->m_nQueued, kCancelWait))
+            break;
+        this->reap();
+        }
+
+    bool const fOrphans = this->hasOrphans();
+
+    for (auto &entry : this->m_entries)
+        entry = Entry();
+
+    auto &ring = this->m_ring;
+
+    if (ring.pSqes != nullptr)
+        ::munmap(ring.pSqes, ring.nSqes);
+    if (ring.pCqRing != nullptr && ring.nCqRing != 0)
+        ::munmap(ring.pCqRing, ring.nCqRing);
+    if (ring.pSqRing != nullptr)
+        ::munmap(ring.pSqRing, ring.nSqRing);
+    ring = Ring();
+
+    // closing the ring cancels anything still in it, and unregisters the
+    // buffers, so they can go after.
+    if (this->m_ringFd >= 0)
+        {
+        ::close(this->m_ringFd);
+        this->m_ringFd = -1;
+        }
+
+    // unless the kernel might still be writing to them, in which case
+    // they're leaked rather than handed back to the heap.
+    if (! fOrphans)
+        {
+        delete[] this->m_pRxBufs;
+        delete[] this->m_pTxBufs;
+        }
+    this->m_pRxBufs = nullptr;
+    this->m_pTxBufs = nullptr;
+    this->m_nQueued = 0;
+    }
+
+bool
+ModbusSerialUringLoop::add(Port &port, Bus *pBus, Host *pHost)
+    {
+    if (this->m_ringFd < 0 || port.getFd() < 0 || port.m_pLoop != nullptr)
+        return false;
+
+    for (std::size_t i = 0; i < knMaxPorts; ++i)
+        {
+        auto &entry = this->m_entries[i];
+
+        if (! entry.isFree())
+            continue;
+
+        port.m_pLoop = this;
+        port.m_pRxBuf = this->m_pRxBufs[i];
+        port.m_pTxBuf = this->m_pTxBufs[i];
+        port.m_nInput = 0;
+        port.m_iInput = 0;
+        port.m_fReadBusy = false;
+        port.m_fWriteQueued = false;
+        port.m_fWriteBusy = false;
+        port.m_fWriteDone = false;
+
+        entry.pPort = &port;
+        entry.pBus = pBus;
+        entry.pHost = pHost;
+        entry.fReady = true;
+        entry.tLastPoll = port.getMicros();
+        return true;
+        }
+
+    return false;
+    }
+
+bool
+ModbusSerialUringLoop::remove(Port &port)
+    {
+    std::size_t i;
+
+    for (i = 0; i < knMaxPorts; ++i)
+        {
+        if (this->m_entries[i].pPort == &port)
+            break;
+        }
+    if (i == knMaxPorts)
+        return false;
+
+    // the buffers can't be reused until the kernel is done with them.
+    if (port.m_fReadBusy)
+        this->queueSqe(IORING_OP_ASYNC_CANCEL, -1, 0, reinterpret_cast<void *>((i << 1) | kOpRead), 0, kUserDataCancel);
+    if (port.m_fWriteBusy)
+        this->queueSqe(IORING_OP_ASYNC_CANCEL, -1, 0, reinterpret_cast<void *>((i << 1) | kOpWrite), 0, kUserDataCancel);
+
+    auto const tStart = port.getMicros();
+    while ((port.m_fReadBusy || port.m_fWriteBusy) && port.getMicros() - tStart < kCancelWait)
+        {
+        if (! this->enter(this->m_nQueued, kCancelWait))
+            break;
+        this->reap();
+        }
+
+    if (port.m_fWriteQueued || port.m_fWriteBusy)
+        {
+        port.m_fWriteDone = true;
+        port.m_writeResult = -ECANCELED;
+        }
+
+    // whatever the kernel still has keeps the slot, and its buffers,
+    // from being reused.
+    Entry orphan;
+
+    orphan.fReadOrphan = port.m_fReadBusy;
+    orphan.fWriteOrphan = port.m_fWriteBusy;
+
+    port.m_pLoop = nullptr;
+    port.m_fReadBusy = false;
+    port.m_fWriteQueued = false;
+    port.m_fWriteBusy = false;
+    port.m_nInput = 0;
+    port.m_iInput = 0;
+    this->m_entries[i] = orphan;
+    return true;
+    }
+
+bool
+ModbusSerialUringLoop::queueSqe(
+    std::uint8_t opcode,
+    int fd,
+    std::uint16_t iBuf,
+    void *pBuf,
+    std::size_t nBuf,
+    std::uint64_t userData
+    )
+    {
+    auto &ring = this->m_ring;
+    std::uint32_t const tail = *ring.pSqTail;
+
+    if (tail - __atomic_load_n(ring.pSqHead, __ATOMIC_ACQUIRE) > ring.sqMask)
+        return false;
+
+    std::uint32_t const index = tail & ring.sqMask;
+    auto const pSqe = static_cast<io_uring_sqe *>(ring.pSqes) + index;
+
+    std::memset(pSqe, 0, sizeof(*pSqe));
+    pSqe->opcode = opcode;
+    pSqe->fd = fd;
+    pSqe->addr = reinterpret_cast<std::uintptr_t>(pBuf);
+    pSqe->len = std::uint32_t(nBuf);
+    // ttys have no file position; a cancel must have no offset at all,
+    // or the kernel rejects it with EINVAL.
+    pSqe->off = opcode == IORING_OP_ASYNC_CANCEL ? 0 : ~std::uint64_t(0);
+    pSqe->buf_index = iBuf;
+    pSqe->user_data = userData;
+
+    ring.pSqArray[index] = index;
+    __atomic_store_n(ring.pSqTail, tail + 1, __ATOMIC_RELEASE);
+    ++this->m_nQueued;
+    return true;
+    }
+
+// queue a read for every port that has consumed its last one, and the
+// writes the ports have asked for.
+std::size_t
+ModbusSerialUringLoop::queueIo()
+    {
+    for (std::size_t i = 0; i < knMaxPorts; ++i)
+        {
+        auto const pPort = this->m_entries[i].pPort;
+
+        if (pPort == nullptr)
+            continue;
+
+        if (! pPort->m_fReadBusy && ! pPort->m_fReadFailed && pPort->m_iInput == pPort->m_nInput &&
+            this->queueSqe(
+                IORING_OP_READ_FIXED, pPort->getFd(), std::uint16_t(i),
+                pPort->m_pRxBuf, Port::knRxBufferBytes,
+                (i << 1) | kOpRead
+                ))
+            pPort->m_fReadBusy = true;
+
+        if (pPort->m_fWriteQueued &&
+            this->queueSqe(
+                IORING_OP_WRITE_FIXED, pPort->getFd(), std::uint16_t(knMaxPorts + i),
+                pPort->m_pTxBuf, pPort->m_nWrite,
+                (i << 1) | kOpWrite
+                ))
+            {
+            pPort->m_fWriteQueued = false;
+            pPort->m_fWriteBusy = true;
+            }
+        }
+
+    return this->m_nQueued;
+    }
+
+// submit what's queued, and wait up to timeout for a completion.
+bool
+ModbusSerialUringLoop::enter(std::size_t nSubmit, std::uint32_t timeout)
+    {
+    if (nSubmit == 0 && timeout == 0)
+        return true;
+
+    __kernel_timespec ts;
+    io_uring_getevents_arg arg;
+    std::memset(&arg, 0, sizeof(arg));
+
+    unsigned flags = 0;
+    unsigned minComplete = 0;
+
+    if (timeout != 0)
+        {
+        flags = IORING_ENTER_GETEVENTS | IORING_ENTER_EXT_ARG;
+        minComplete = 1;
+        if (timeout != UINT32_MAX)
+            {
+            ts.tv_sec = timeout / 1000000u;
+            ts.tv_nsec = long(timeout % 1000000u) * 1000;
+            arg.ts = reinterpret_cast<std::uintptr_t>(&ts);
+            }
+        }
+
+    long const result = ::syscall(
+                            __NR_io_uring_enter, this->m_ringFd,
+                            unsigned(nSubmit), minComplete, flags,
+                            flags != 0 ? &arg : nullptr, flags != 0 ? sizeof(arg) : 0
+                            );
+    ++this->m_nEnter;
+
+    if (result >= 0)
+        {
+        this->m_nQueued -= std::size_t(result) < this->m_nQueued ? std::size_t(result) : this->m_nQueued;
+        return true;
+        }
+
+    // timeouts and signals are normal; a full completion queue clears
+    // when it's reaped.
+    return errno == ETIME || errno == EINTR || errno == EBUSY || errno == EAGAIN;
+    }
+
+// collect completions, and mark the ports they belong to.
+void
+ModbusSerialUringLoop::reap()
+    {
+    auto &ring = this->m_ring;
+    std::uint32_t head = *ring.pCqHead;
+    std::uint32_t const tail = __atomic_load_n(ring.pCqTail, __ATOMIC_ACQUIRE);
+
+    for (; head != tail; ++head)
+        {
+        auto const &cqe = static_cast<const io_uring_cqe *>(ring.pCqes)[head & ring.cqMask];
+
+        if (cqe.user_data == kUserDataCancel)
+            continue;
+
+        auto &entry = this->m_entries[cqe.user_data >> 1];
+        auto const pPort = entry.pPort;
+        if (pPort == nullptr)
+            {
+            // I/O left over from a removed port; its slot is free now.
+            if ((cqe.user_data & 1) == kOpRead)
+                entry.fReadOrphan = false;
+            else
+                entry.fWriteOrphan = false;
+            continue;
+            }
+
+        if ((cqe.user_data & 1) == kOpRead)
+            {
+            pPort->m_fReadBusy = false;
+            if (cqe.res > 0)
+                {
+                pPort->m_nInput = std::size_t(cqe.res);
+                pPort->m_iInput = 0;
+                }
+            else if (cqe.res != -EINTR && cqe.res != -EAGAIN && cqe.res != -ECANCELED)
+                // end of file or an error: the tty has gone away.
+                pPort->m_fReadFailed = true;
+            }
+        else
+            {
+            pPort->m_fWriteBusy = false;
+            pPort->m_fWriteDone = true;
+            pPort->m_writeResult = cqe.res;
+            }
+
+        entry.fReady = true;
+        }
+
+    __atomic_store_n(ring.pCqHead, head, __ATOMIC_RELEASE);
+    }
+
+bool
+ModbusSerialUringLoop::hasOrphans() const
+    {
+    for (auto const &entry : this->m_entries)
+        {
+        if (entry.fReadOrphan || entry.fWriteOrphan)
+            return true;
+        }
+    return false;
+    }
+
+std::uint32_t
+ModbusSerialUringLoop::getWakeDelay(const Entry &entry, std::uint32_t now) const
+    {
+    auto delay = entry.pPort->getWakeDelay(now);
+    auto const sinceLastPoll = now - entry.tLastPoll;
+    auto const tickDelay = sinceLastPoll >= this->m_tick ? 0 : this->m_tick - sinceLastPoll;
+
+    return tickDelay < delay ? tickDelay : delay;
+    }
+
+bool
+ModbusSerialUringLoop::run(std::uint32_t maxWait)
+    {
+    if (this->m_ringFd < 0)
+        return false;
+
+    auto timeout = maxWait;
+
+    for (auto &entry : this->m_entries)
+        {
+        if (entry.pPort == nullptr)
+            continue;
+
+        auto const delay = entry.fReady ? 0 : this->getWakeDelay(entry, entry.pPort->getMicros());
+        if (delay < timeout)
+            timeout = delay;
+        }
+
+    // one system call submits everything and waits.
+    if (! this->enter(this->queueIo(), timeout))
+        return false;
+
+    this->reap();
+
+    for (auto &entry : this->m_entries)
+        {
+        if (entry.pPort == nullptr)
+            continue;
+
+        auto const now = entry.pPort->getMicros();
+        if (! entry.fReady && this->getWakeDelay(entry, now) != 0)
+            continue;
+
+        entry.fReady = false;
+        entry.tLastPoll = now;
+        if (entry.pBus != nullptr)
+            entry.pBus->poll();
+        else
+            entry.pHost->poll();
+        }
+
+    return true;
+    }
+
+#endif // defined(__linux__) && ! defined(ARDUINO) && defined(MCCI_MODBUS_SERIAL_IO_URING)
@@ -0,0 +1,135 @@
+/*
+
+Module:  MCCI_Modbus_Serial_UringTransport.cpp
+
+Function:
+    ModbusSerialUringTransport.
+
+Copyright notice and License:
+    See LICENSE file accompanying this project.
+
+Author:
+    MCCI Corporation   October 2026
+
+*/
+
+#include "MCCI_Modbus_Serial_UringTransport.h"
+
+#if defined(__linux__) && ! defined(ARDUINO) && defined(MCCI_MODBUS_SERIAL_IO_URING)
+
+#include "MCCI_Modbus_Serial_UringLoop.h"
+
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <termios.h>
+
+using namespace McciCatena;
+
+bool
+ModbusSerialUringTransport::begin(const char *pPath, std::uint32_t baudrate, Parity parity)
+    {
+    this->end();
+
+    if (! this->ModbusSerialTermiosTransport::begin(pPath, baudrate, parity))
+        return false;
+
+    // the ring waits for input, not us: a read that would block is
+    // parked until the tty is readable, and a read of nothing (VMIN 0)
+    // would complete at once, over and over.
+    int const fd = this->getFd();
+    int const flags = ::fcntl(fd, F_GETFL);
+    termios tio;
+
+    if (flags < 0 ||
+        ::fcntl(fd, F_SETFL, flags & ~O_NONBLOCK) != 0 ||
+        ::tcgetattr(fd, &tio) != 0)
+        {
+        this->ModbusSerialTermiosTransport::end();
+        return false;
+        }
+
+    tio.c_cc[VMIN] = 1;
+    tio.c_cc[VTIME] = 0;
+    if (::tcsetattr(fd, TCSANOW, &tio) != 0)
+        {
+        this->ModbusSerialTermiosTransport::end();
+        return false;
+        }
+
+    this->m_nInput = 0;
+    this->m_iInput = 0;
+    this->m_fReadFailed = false;
+    return true;
+    }
+
+void
+ModbusSerialUringTransport::end()
+    {
+    if (this->m_pLoop != nullptr)
+        this->m_pLoop->remove(*this);
+
+    this->ModbusSerialTermiosTransport::end();
+    }
+
+ssize_t
+ModbusSerialUringTransport::readInput(std::uint8_t *pBuf, std::size_t nBuf)
+    {
+    std::size_t const nAvail = this->m_nInput - this->m_iInput;
+
+    if (nAvail == 0)
+        {
+        errno = EAGAIN;
+        return -1;
+        }
+
+    if (nBuf > nAvail)
+        nBuf = nAvail;
+
+    std::memcpy(pBuf, &this->m_pRxBuf[this->m_iInput], nBuf);
+    this->m_iInput += nBuf;
+    return ssize_t(nBuf);
+    }
+
+ssize_t
+ModbusSerialUringTransport::writeOutput(const std::uint8_t *pBuf, std::size_t nBuf)
+    {
+    if (this->m_fWriteDone)
+        {
+        this->m_fWriteDone = false;
+        if (this->m_writeResult >= 0)
+            return this->m_writeResult;
+
+        errno = int(-this->m_writeResult);
+        return -1;
+        }
+
+    if (this->m_pLoop == nullptr)
+        {
+        errno = ENOTCONN;
+        return -1;
+        }
+
+    // queue it for the loop's next submission, and report that it's in
+    // progress until the completion comes back.
+    if (! this->m_fWriteQueued && ! this->m_fWriteBusy)
+        {
+        if (nBuf > knTxBufferBytes)
+            nBuf = knTxBufferBytes;
+
+        std::memcpy(this->m_pTxBuf, pBuf, nBuf);
+        this->m_nWrite = nBuf;
+        this->m_fWriteQueued = true;
+        }
+
+    errno = EAGAIN;
+    return -1;
+    }
+
+void
+ModbusSerialUringTransport::flushInput()
+    {
+    this->m_iInput = this->m_nInput;
+    }
+
+#endif // defined(__linux__) && ! defined(ARDUINO) && defined(MCCI_MODBUS_SERIAL_IO_URING)
@@ -0,0 +1,216 @@
+/*
+
+Module:  test_backoff.cpp
+
+Function:
+    ModbusSerialBackoff, and what it buys a bus where most of the
+    devices have gone away.
+
+Copyright notice and License:
+    See LICENSE file accompanying this project.
+
+Author:
+    MCCI Corporation   October 2026
+
+*/
+
+#include "MCCI_Modbus_Serial_Bus.h"
+#include "MCCI_Modbus_Serial_BufferedClient.h"
+#include "MCCI_Modbus_Serial_LoopbackTransport.h"
+
+#include <memory>
+
+#include "test_common.h"
+
+using namespace McciCatena;
+
+namespace {
+
+using Backoff = ModbusSerialBackoff;
+using Host = ModbusSerialHost;
+
+/// @brief each wait is in the upper half of the interval, and the
+///     interval doubles up to the ceiling.
+void testRange()
+    {
+    Backoff backoff;
+    std::uint32_t interval = Backoff::kDefaultFloor;
+    bool fInRange = true;
+    bool fDoubling = true;
+
+    backoff.seed(12345);
+    for (unsigned i = 0; i < 20; ++i)
+        {
+        fDoubling = fDoubling && backoff.getInterval() == interval;
+
+        auto const delay = backoff.next();
+
+        fInRange = fInRange && delay >= interval - interval / 2 && delay <= interval;
+        interval = interval > Backoff::kDefaultCeiling / 2 ? Backoff::kDefaultCeiling : 2 * interval;
+        }
+
+    TEST_CHECK(fInRange);
+    TEST_CHECK(fDoubling);
+    TEST_CHECK(backoff.getInterval() == Backoff::kDefaultCeiling);
+
+    backoff.reset();
+    TEST_CHECK(backoff.getInterval() == Backoff::kDefaultFloor);
+    }
+
+/// @brief floor == ceiling is a fixed interval, still jittered; and the
+///     limits are kept sane.
+void testLimits()
+    {
+    constexpr std::uint32_t kFixed = 2000 * 1000;
+    Backoff backoff(kFixed, kFixed);
+    std::uint32_t lo = UINT32_MAX, hi = 0;
+
+    for (unsigned i = 0; i < 1000; ++i)
+        {
+        auto const delay = backoff.next();
+
+        lo = delay < lo ? delay : lo;
+        hi = delay > hi ? delay : hi;
+        }
+
+    TEST_CHECK(backoff.getInterval() == kFixed);
+    TEST_CHECK(lo >= kFixed / 2 && hi <= kFixed);
+    TEST_CHECK(hi - lo > kFixed / 4);
+
+    backoff.setLimits(0, 0);
+    TEST_CHECK(backoff.getFloor() == 1 && backoff.getCeiling() == 1);
+    TEST_CHECK(backoff.next() == 1);
+
+    // a lower ceiling pulls the interval down with it.
+    Backoff high(1000, 1000000);
+
+    for (unsigned i = 0; i < 20; ++i)
+        high.next();
+    high.setLimits(1000, 8000);
+    TEST_CHECK(high.getInterval() == 8000);
+    }
+
+/// @brief hosts with different seeds don't probe in step.
+void testSeeds()
+    {
+    Backoff a, b;
+    unsigned nSame = 0;
+
+    a.seed(1);
+    b.seed(2);
+    for (unsigned i = 0; i < 20; ++i)
+        nSame += a.next() == b.next();
+
+    TEST_CHECK(nSame < 3);
+    }
+
+bool isFound(const Host &host)
+    {
+    return host.getState() == Host::State::stIdle || host.getState() == Host::State::stRead;
+    }
+
+/// @brief one live device and thirty that have gone away, on a 19200
+///     baud bus. The dead ones' probes mustn't starve the live one, and
+///     a device that comes back is found again.
+void testDeadDevices()
+    {
+    constexpr unsigned knHosts = 31;
+    constexpr std::uint32_t kBaudrate = 19200;
+    constexpr std::uint32_t kStepMicros = 10;
+
+    ModbusSerialLoopbackTransport transport(kBaudrate);
+    ModbusSerialBus bus(transport);
+    std::unique_ptr<ModbusSerialDevice> pDevice[knHosts];
+    std::unique_ptr<Host> pHost[knHosts];
+    std::unique_ptr<ModbusSerialBufferedClient<>> pClient[knHosts];
+
+    for (unsigned i = 0; i < knHosts; ++i)
+        {
+        pDevice[i].reset(new ModbusSerialDevice);
+        pHost[i].reset(new Host(transport, std::uint8_t(i + 1)));
+        pClient[i].reset(new ModbusSerialBufferedClient<>);
+        transport.attach(std::uint8_t(i + 1), *pDevice[i]);
+        bus.addHost(*pHost[i]);
+        pHost[i]->begin(*pClient[i], kBaudrate);
+        }
+
+    // everyone found; then all but the first go away.
+    for (unsigned k = 0; k < 100000; ++k)
+        {
+        bus.poll();
+        transport.advanceMicros(kStepMicros);
+        }
+    for (unsigned i = 1; i < knHosts; ++i)
+        transport.detach(std::uint8_t(i + 1));
+
+    // the live device offers 1000 characters a second.
+    std::size_t nGot = 0;
+    auto const run = [&](std::uint32_t us)
+        {
+        for (std::uint32_t k = 0; k < us / kStepMicros; ++k)
+            {
+            std::uint8_t buf[256];
+
+            bus.poll();
+            if (k % 100 == 0)
+                (void) pDevice[0]->getRxQueue().put('a');
+            nGot += pClient[0]->getRx(buf, sizeof(buf));
+            transport.advanceMicros(kStepMicros);
+            }
+        };
+    auto const countProbes = [&]
+        {
+        std::uint32_t n = 0;
+
+        for (unsigned i = 1; i < knHosts; ++i)
+            n += pHost[i]->getStats().nNoReply;
+        return n;
+        };
+
+    run(2000000);
+
+    auto const nGot0 = nGot;
+    auto const nProbes0 = countProbes();
+
+    run(60000000);
+
+    auto const nRate = (nGot - nGot0) / 60;
+    auto const nProbes = countProbes() - nProbes0;
+
+    std::printf("live device: %zu characters/s; dead devices: %u probes in 60 s\n", nRate, nProbes);
+    TEST_CHECK(nRate >= 800);
+    // at the ceiling a dead host probes at most every 8 s; allow a few
+    // more for the climb to it.
+    TEST_CHECK(nProbes <= (knHosts - 1) * 12);
+
+    // long gone: found within a ceiling.
+    transport.attach(6, *pDevice[5]);
+
+    auto t0 = transport.getMicros();
+
+    while (! isFound(*pHost[5]) && transport.getMicros() - t0 < 2 * Backoff::kDefaultCeiling)
+        run(1000);
+    std::printf("back after %u us\n", transport.getMicros() - t0);
+    TEST_CHECK(transport.getMicros() - t0 <= Backoff::kDefaultCeiling + 500000);
+
+    // just dropped out: found again in a few floors.
+    transport.detach(6);
+    run(500000);
+    transport.attach(6, *pDevice[5]);
+    t0 = transport.getMicros();
+    while (! isFound(*pHost[5]) && transport.getMicros() - t0 < 2 * Backoff::kDefaultCeiling)
+        run(1000);
+    std::printf("flap back after %u us\n", transport.getMicros() - t0);
+    TEST_CHECK(transport.getMicros() - t0 <= 4 * Backoff::kDefaultFloor);
+    }
+
+} // namespace
+
+int main()
+    {
+    testRange();
+    testLimits();
+    testSeeds();
+    testDeadDevices();
+    return Test::report("backoff");
+    }
@@ -0,0 +1,417 @@
+/*
+
+Module:  test_bus.cpp
+
+Function:
+    ModbusSerialBus scheduling several hosts over the loopback transport.
+
+Copyright notice and License:
+    See LICENSE file accompanying this project.
+
+Author:
+    MCCI Corporation   October 2026
+
+*/
+
+#include "MCCI_Modbus_Serial_Bus.h"
+#include "MCCI_Modbus_Serial_BufferedClient.h"
+#include "MCCI_Modbus_Serial_LoopbackTransport.h"
+
+#include <cstdio>
+
+#include "test_common.h"
+
+using namespace McciCatena;
+
+namespace {
+
+using Host = ModbusSerialHost;
+using Transaction = ModbusSerialTransaction;
+using Client = ModbusSerialBufferedClient<256, 256>;
+
+constexpr unsigned knHosts = 3;
+constexpr std::uint32_t kStepMicros = 100;
+
+/// @brief a loopback transport that refuses every nth submit(), as a
+///     transport might if it couldn't start the write; and counts, per
+///     unit, the Status reads, TxData writes and 0x17s it accepted. The
+///     first knLog transactions accepted after nLog is cleared are
+///     logged.
+class RefusingTransport : public ModbusSerialLoopbackTransport
+    {
+public:
+    RefusingTransport(std::uint32_t baudrate, unsigned nRefuseEvery)
+        : ModbusSerialLoopbackTransport(baudrate)
+        , m_nRefuseEvery(nRefuseEvery)
+        {}
+
+    struct LogEntry
+        {
+        std::uint32_t   tSubmit;
+        std::uint8_t    unitId;
+        std::uint16_t   nWrite;
+        std::uint16_t   nBusBytes;
+        };
+
+    static constexpr std::size_t knLog = 64;
+
+    LogEntry log[knLog];
+    std::size_t nLog = 0;
+    std::uint32_t nOffered = 0;
+    std::uint32_t nRefused = 0;
+    std::uint32_t nReads[knHosts + 1] = {};
+    std::uint32_t nWrites[knHosts + 1] = {};
+    std::uint32_t nReadWrites[knHosts + 1] = {};
+
+    virtual bool submit(Transaction &t) override
+        {
+        if (! this->isReady())
+            return false;
+        if (this->m_nRefuseEvery != 0 && ++this->nOffered % this->m_nRefuseEvery == 0)
+            {
+            ++this->nRefused;
+            return false;
+            }
+        if (! ModbusSerialLoopbackTransport::submit(t))
+            return false;
+
+        if (this->nLog < knLog)
+            {
+            this->log[this->nLog++] =
+                {
+                this->getMicros(),
+                t.unitId,
+                t.nWrite,
+                std::uint16_t(t.getRequestBytes() + t.getResponseBytes())
+                };
+            }
+
+        auto const i = t.unitId <= knHosts ? t.unitId : 0;
+
+        if (t.function == Transaction::Function::ReadWriteMultipleRegisters)
+            ++this->nReadWrites[i];
+        else if (t.function == Transaction::Function::WriteMultipleRegisters &&
+                 t.writeAddress != ModbusSerialProtocol::getAddress(ModbusSerialProtocol::Register::Baudrate_i32))
+            ++this->nWrites[i];
+        else if (t.function == Transaction::Function::ReadInputRegisters &&
+                 t.readAddress == ModbusSerialProtocol::getAddress(ModbusSerialProtocol::Register::Status_u16))
+            ++this->nReads[i];
+        return true;
+        }
+
+private:
+    unsigned m_nRefuseEvery;
+    };
+
+/// @brief knHosts devices on one bus, each streaming a pattern in both
+///     directions.
+struct Rig
+    {
+    RefusingTransport transport;
+    ModbusSerialBus bus { transport };
+    ModbusSerialDevice device[knHosts];
+    Host host[knHosts] = { { transport, 1 }, { transport, 2 }, { transport, 3 } };
+    Client client[knHosts];
+    std::size_t nRxPut[knHosts] = {};
+    std::size_t nRxGot[knHosts] = {};
+    std::size_t nTxPut[knHosts] = {};
+    std::size_t nTxGot[knHosts] = {};
+    bool fOk = true;
+
+    Rig(unsigned nRefuseEvery)
+        : transport(115200, nRefuseEvery)
+        {
+        for (unsigned i = 0; i < knHosts; ++i)
+            {
+            this->transport.attach(std::uint8_t(i + 1), this->device[i]);
+            TEST_CHECK(this->bus.addHost(this->host[i]));
+            TEST_CHECK(this->host[i].begin(this->client[i], 115200));
+            }
+        }
+
+    static std::uint8_t pattern(std::size_t i, unsigned iHost)
+        {
+        return std::uint8_t(i * 13 + iHost * 59 + (i >> 8));
+        }
+
+    /// @brief run the bus, moving up to nBytes each way for each host;
+    ///     return true if it all arrived within seconds.
+    bool run(std::size_t nBytes, std::uint32_t seconds)
+        {
+        for (std::uint32_t t = 0; t < seconds * 1000000; t += kStepMicros)
+            {
+            bool fDone = true;
+
+            for (unsigned i = 0; i < knHosts; ++i)
+                {
+                this->feed(i, nBytes);
+                fDone = fDone && this->nRxGot[i] == nBytes && this->nTxGot[i] == nBytes;
+                }
+
+            if (fDone)
+                return this->fOk;
+
+            this->bus.poll();
+            this->transport.advanceMicros(kStepMicros);
+            }
+
+        return false;
+        }
+
+    void feed(unsigned i, std::size_t nBytes)
+        {
+        auto &rxQueue = this->device[i].getRxQueue();
+
+        while (this->nRxPut[i] < nBytes && rxQueue.put(pattern(this->nRxPut[i], i)))
+            ++this->nRxPut[i];
+
+        while (this->nTxPut[i] < nBytes)
+            {
+            std::uint8_t const c = pattern(this->nTxPut[i], i + knHosts);
+
+            if (this->client[i].putTx(&c, 1) != 1)
+                break;
+            ++this->nTxPut[i];
+            }
+
+        std::uint8_t buf[64];
+        std::size_t n;
+
+        while ((n = this->client[i].getRx(buf, sizeof(buf))) != 0)
+            {
+            for (std::size_t j = 0; j < n; ++j, ++this->nRxGot[i])
+                this->fOk &= buf[j] == pattern(this->nRxGot[i], i);
+            }
+
+        int c;
+
+        while ((c = this->device[i].getTxQueue().get()) >= 0)
+            {
+            this->fOk &= std::uint8_t(c) == pattern(this->nTxGot[i], i + knHosts);
+            ++this->nTxGot[i];
+            }
+        }
+    };
+
+// every host's data moves both ways, whole and in order.
+void testMultiHost()
+    {
+    Rig rig(0);
+
+    TEST_CHECK(rig.run(4096, 30));
+    for (unsigned i = 0; i < knHosts; ++i)
+        {
+        auto const &stats = rig.host[i].getStats();
+
+        TEST_CHECK(stats.nRxBytes == 4096);
+        TEST_CHECK(stats.nTxBytes == 4096);
+        TEST_CHECK(stats.nErrors == 0);
+        TEST_CHECK(stats.nNoReply == 0);
+        }
+    }
+
+// a transaction the transport won't take leaves its host as it was: the
+// data still all moves, and only transactions that went out are counted.
+void testRefusedSubmit()
+    {
+    Rig rig(3);
+
+    TEST_CHECK(rig.run(4096, 60));
+    TEST_CHECK(rig.transport.nRefused != 0);
+
+    for (unsigned i = 0; i < knHosts; ++i)
+        {
+        auto const &stats = rig.host[i].getStats();
+
+        TEST_CHECK(stats.nReads == rig.transport.nReads[i + 1]);
+        TEST_CHECK(stats.nWrites == rig.transport.nWrites[i + 1]);
+        TEST_CHECK(stats.nReadWrites == rig.transport.nReadWrites[i + 1]);
+        TEST_CHECK(stats.nRxBytes == 4096);
+        TEST_CHECK(stats.nTxBytes == 4096);
+        }
+
+    for (unsigned i = 0; i < knHosts; ++i)
+        rig.host[i].end();
+    for (std::uint32_t t = 0; t < 1000000; t += kStepMicros)
+        {
+        rig.bus.poll();
+        rig.transport.advanceMicros(kStepMicros);
+        }
+    for (unsigned i = 0; i < knHosts; ++i)
+        TEST_CHECK(rig.host[i].getState() == Host::State::stStopped);
+    }
+
+// two devices with more input than the bus can carry, weighted 1 and 3,
+// share it about 1:3; a third device with the odd character for the host
+// is still heard within a poll interval or so.
+void testFairness()
+    {
+    constexpr std::uint32_t kWarmupMicros = 1000000;
+    constexpr std::uint32_t kRunMicros = 10 * 1000000;
+    constexpr std::uint32_t kQuietMicros = 50000;
+
+    Rig rig(0);
+
+    TEST_CHECK(rig.bus.setWeight(rig.host[1], 3));
+
+    std::size_t nGot[knHosts] = {};
+    std::uint32_t tQuietPut = 0;
+    std::uint32_t maxQuietLatency = 0;
+    unsigned nQuietPut = 0;
+    unsigned nQuietGot = 0;
+    bool fQuietPending = false;
+
+    for (std::uint32_t t = 0; t < kWarmupMicros + kRunMicros; t += kStepMicros)
+        {
+        for (unsigned i = 0; i < 2; ++i)
+            {
+            while (rig.device[i].getRxQueue().put(std::uint8_t(t)))
+                ;
+            }
+
+        if (t >= kWarmupMicros && ! fQuietPending && t % kQuietMicros == 0)
+            {
+            TEST_CHECK(rig.device[2].getRxQueue().put('!'));
+            tQuietPut = t;
+            fQuietPending = true;
+            ++nQuietPut;
+            }
+
+        for (unsigned i = 0; i < knHosts; ++i)
+            {
+            std::uint8_t buf[256];
+            auto const n = rig.client[i].getRx(buf, sizeof(buf));
+
+            if (t >= kWarmupMicros)
+                nGot[i] += n;
+            if (i == 2 && n != 0 && fQuietPending)
+                {
+                auto const latency = t - tQuietPut;
+
+                if (latency > maxQuietLatency)
+                    maxQuietLatency = latency;
+                fQuietPending = false;
+                ++nQuietGot;
+                }
+            }
+
+        rig.bus.poll();
+        rig.transport.advanceMicros(kStepMicros);
+        }
+
+    std::printf("weight 1: %zu bytes/s; weight 3: %zu bytes/s; quiet: %u/%u, worst %u us\n",
+        nGot[0] * 1000000 / kRunMicros, nGot[1] * 1000000 / kRunMicros,
+        nQuietGot, nQuietPut, maxQuietLatency);
+
+    TEST_CHECK(nGot[0] != 0);
+    TEST_CHECK(nGot[1] * 10 >= nGot[0] * 25);
+    TEST_CHECK(nGot[1] * 10 <= nGot[0] * 35);
+    TEST_CHECK(nQuietGot + 1 >= nQuietPut);
+    TEST_CHECK(maxQuietLatency <= ModbusSerialPollInterval::kDefaultCeiling + 20000);
+    }
+
+// device 1 has more input than the bus can carry, and a weight that
+// would let it keep the bus for a long time. While one of its long reads
+// is on the bus, device 2's output gets a deadline that expires before
+// the read is done, and device 3's output a looser one. Device 2 goes
+// first, even though it's late, and its bytes are counted late; device
+// 3 still makes its deadline.
+void testUrgent()
+    {
+    constexpr std::uint32_t kLateBound = 2000;
+    constexpr std::uint32_t kLooseBound = 40000;
+
+    Rig rig(0);
+    std::size_t nTxGot[knHosts] = {};
+
+    TEST_CHECK(rig.bus.setWeight(rig.host[0], 20));
+
+    auto const step = [&rig, &nTxGot]
+        {
+        while (rig.device[0].getRxQueue().put('x'))
+            ;
+
+        for (unsigned i = 0; i < knHosts; ++i)
+            {
+            std::uint8_t buf[256];
+
+            (void) rig.client[i].getRx(buf, sizeof(buf));
+            while (rig.device[i].getTxQueue().get() >= 0)
+                ++nTxGot[i];
+            }
+
+        rig.bus.poll();
+        rig.transport.advanceMicros(kStepMicros);
+        };
+
+    for (std::uint32_t t = 0; t < 1000000; t += kStepMicros)
+        step();
+
+    // wait for a long read of device 1 to go out.
+    auto const &log = rig.transport.log;
+    auto const kLongRead = 2 * (1 + ModbusSerialProtocol::knRxDataReg);
+
+    for (std::uint32_t t = 0; t < 1000000; t += kStepMicros)
+        {
+        rig.transport.nLog = 0;
+        step();
+        if (rig.transport.nLog != 0 && log[0].unitId == 1 && log[0].nBusBytes >= kLongRead)
+            break;
+        }
+    TEST_CHECK(rig.transport.nLog != 0 && log[0].nBusBytes >= kLongRead);
+    TEST_CHECK(! rig.transport.isReady());
+
+    std::uint8_t const data[3] = { 1, 2, 3 };
+    auto const tPut = rig.transport.getMicros();
+
+    rig.host[1].setTxLatencyBound(kLateBound);
+    rig.host[2].setTxLatencyBound(kLooseBound);
+    TEST_CHECK(rig.client[1].putTx(data, 3) == 3);
+    TEST_CHECK(rig.client[2].putTx(data, 1) == 1);
+
+    rig.transport.nLog = 0;
+    for (std::uint32_t t = 0; t < 100000; t += kStepMicros)
+        step();
+
+    // the read in flight outlasts device 2's deadline; device 2 goes
+    // next, and device 3 before its deadline.
+    TEST_CHECK(rig.transport.nLog >= 2);
+    TEST_CHECK(log[0].unitId == 2 && log[0].nWrite != 0);
+    TEST_CHECK(log[0].tSubmit - tPut > kLateBound);
+
+    std::size_t i3 = 1;
+    while (i3 < rig.transport.nLog && ! (log[i3].unitId == 3 && log[i3].nWrite != 0))
+        ++i3;
+    TEST_CHECK(i3 < rig.transport.nLog);
+    if (i3 < rig.transport.nLog)
+        TEST_CHECK(log[i3].tSubmit - tPut < kLooseBound);
+
+    // while the bounds are set, transactions are kept to half the
+    // tighter one; that's less than the floor the host allows, room for
+    // 0x17 with two registers each way.
+    for (std::size_t i = 1; i < rig.transport.nLog; ++i)
+        TEST_CHECK(log[i].nBusBytes <= 13 + 2 * 2 + 5 + 2 * 2);
+
+    auto const &late = rig.host[1].getStats();
+    auto const &loose = rig.host[2].getStats();
+
+    std::printf("late: %u bytes in %u writes; loose: %u bytes in %u writes\n",
+        late.nTxLateBytes, late.nTxLateWrites, loose.nTxLateBytes, loose.nTxLateWrites);
+    TEST_CHECK(nTxGot[1] == 3);
+    TEST_CHECK(nTxGot[2] == 1);
+    TEST_CHECK(late.nTxLateBytes == 3);
+    TEST_CHECK(late.nTxLateWrites == 1);
+    TEST_CHECK(loose.nTxLateBytes == 0);
+    TEST_CHECK(loose.nTxLateWrites == 0);
+    }
+
+} // namespace
+
+int main()
+    {
+    testMultiHost();
+    testRefusedSubmit();
+    testFairness();
+    testUrgent();
+    return Test::report("bus");
+    }
@@ -0,0 +1,64 @@
+/*
+
+Module:  test_common.h
+
+Function:
+    Checks and reporting shared by the test programs.
+
+Copyright notice and License:
+    See LICENSE file accompanying this project.
+
+Author:
+    MCCI Corporation   October 2026
+
+*/
+
+#pragma once
+
+#ifndef _test_common_h_
+# define _test_common_h_
+
+#include <cstdio>
+
+namespace McciCatena {
+namespace Test {
+
+/// @brief number of failed checks so far.
+inline unsigned &failures()
+    {
+    static unsigned nFailures = 0;
+    return nFailures;
+    }
+
+inline bool check(bool fOk, const char *pExpr, const char *pFile, int line)
+    {
+    if (! fOk)
+        {
+        std::fprintf(stderr, "%s:%d: check failed: %s\n", pFile, line, pExpr);
+        ++failures();
+        }
+    return fOk;
+    }
+
+/// @brief print a summary and return the exit code for main().
+inline int report(const char *pName)
+    {
+    if (failures() != 0)
+        {
+        std::fprintf(stderr, "%s: %u check(s) failed\n", pName, failures());
+        return 1;
+        }
+
+    std::printf("%s: passed\n", pName);
+    return 0;
+    }
+
+} // namespace Test
+} // namespace McciCatena
+
+/// @brief check a condition, carrying on if it fails; evaluates to the
+///     condition.
+#define TEST_CHECK(expr) \
+    ::McciCatena::Test::check(bool(expr), #expr, __FILE__, __LINE__)
+
+#endif // _test_common_h_
@@ -0,0 +1,213 @@
+/*
+
+Module:  test_coroutine.cpp
+
+Function:
+    ModbusSerialCoPort, ModbusSerialCoTask and ModbusSerialCoExecutor
+    over a loopback bus, and where coroutine frames go back to.
+
+Copyright notice and License:
+    See LICENSE file accompanying this project.
+
+Author:
+    MCCI Corporation   October 2026
+
+*/
+
+#include "MCCI_Modbus_Serial_Coroutine.h"
+#include "MCCI_Modbus_Serial_LoopbackTransport.h"
+
+#include "test_common.h"
+
+using namespace McciCatena;
+
+namespace {
+
+using Task = ModbusSerialCoTask;
+using Port = ModbusSerialCoPort<>;
+using Frames = ModbusSerialCoFrames<8, 512>;
+using Executor = ModbusSerialCoExecutor<4>;
+
+constexpr std::uint8_t kUnitId = 5;
+constexpr std::uint32_t kStepMicros = 100;
+constexpr std::size_t knBytes = 300;
+
+std::uint8_t pattern(std::size_t i)
+    {
+    return std::uint8_t(i * 11 + 3);
+    }
+
+/// @brief write n bytes of the pattern, starting at i, in one go.
+Task writeChunk(Port &port, std::size_t i, std::size_t n, std::size_t &nDone)
+    {
+    std::uint8_t buf[64];
+
+    for (std::size_t j = 0; j < n; ++j)
+        buf[j] = pattern(i + j);
+    nDone += co_await port.write(buf, n);
+    }
+
+/// @brief send knBytes out through nested tasks, then read knBytes back
+///     and check them.
+Task exchange(Port &port, std::size_t &nWritten, std::size_t &nRead, bool &fOk, bool &fDone)
+    {
+    for (std::size_t i = 0; i < knBytes; i += 50)
+        co_await writeChunk(port, i, 50, nWritten);
+
+    while (nRead < knBytes)
+        {
+        std::uint8_t buf[32];
+        auto const n = co_await port.read(buf, sizeof(buf));
+
+        for (std::size_t j = 0; j < n; ++j)
+            fOk = fOk && buf[j] == pattern(nRead + j);
+        nRead += n;
+        }
+
+    fDone = true;
+    }
+
+/// @brief a task that waits until told to stop.
+Task waitFor(const bool &fStop, Port &port)
+    {
+    while (! fStop)
+        {
+        std::uint8_t c;
+
+        (void) co_await port.read(&c, 1);
+        }
+    }
+
+/// @brief a task through a port, a host and a device, both ways.
+void testExchange()
+    {
+    Frames frames;
+    Executor executor(frames);
+    ModbusSerialLoopbackTransport transport(115200);
+    ModbusSerialDevice device;
+    ModbusSerialHost host(transport, kUnitId);
+    Port port;
+    std::size_t nWritten = 0, nRead = 0, nDevOut = 0, nDevIn = 0;
+    bool fOk = true, fDone = false;
+
+    transport.attach(kUnitId, device);
+    TEST_CHECK(host.begin(port, 115200));
+    executor.addWaitable(port);
+
+    auto const nFree = frames.getFreeCount();
+
+    TEST_CHECK(executor.spawn(exchange(port, nWritten, nRead, fOk, fDone)));
+    TEST_CHECK(executor.getTaskCount() == 1);
+
+    for (std::uint32_t t = 0; t < 20000000 && ! fDone; t += kStepMicros)
+        {
+        host.poll();
+        executor.poll();
+        transport.advanceMicros(kStepMicros);
+
+        // the device echoes its UART output, once the task is reading.
+        int c;
+
+        while ((c = device.getTxQueue().get()) >= 0)
+            {
+            fOk = fOk && std::uint8_t(c) == pattern(nDevOut++);
+            }
+        while (nDevIn < nDevOut && nWritten == knBytes && device.getRxQueue().put(pattern(nDevIn)))
+            ++nDevIn;
+        }
+
+    executor.poll();
+    std::printf("exchange: %zu written, %zu read; largest frame %zu bytes\n", nWritten, nRead, frames.getMaxRequested());
+    TEST_CHECK(fDone && fOk);
+    TEST_CHECK(nWritten == knBytes && nRead == knBytes);
+    TEST_CHECK(executor.getTaskCount() == 0);
+    TEST_CHECK(frames.getFreeCount() == nFree);
+    TEST_CHECK(frames.getFailedCount() == 0);
+
+    executor.removeWaitable(port);
+    }
+
+/// @brief with two executors, each task's frame goes back to the pool it
+///     came from, whichever pool is the default by then.
+void testTwoPools()
+    {
+    Frames framesA;
+    Frames framesB;
+    Port port;
+    bool fStopA = false, fStopB = false;
+    auto const nFree = framesA.getFreeCount();
+
+    Executor executorA(framesA);
+
+    executorA.addWaitable(port);
+    TEST_CHECK(executorA.spawn(waitFor(fStopA, port)));
+    executorA.poll();
+    TEST_CHECK(framesA.getFreeCount() == nFree - 1);
+
+    {
+    // a second executor makes its pool the default.
+    Executor executorB(framesB);
+
+    executorB.addWaitable(port);
+    TEST_CHECK(ModbusSerialCoFramePool::getDefault() == &framesB);
+    TEST_CHECK(executorB.spawn(waitFor(fStopB, port)));
+    TEST_CHECK(framesB.getFreeCount() == nFree - 1);
+    TEST_CHECK(framesA.getFreeCount() == nFree - 1);
+
+    // A's task finishes while B's pool is the default.
+    fStopA = true;
+    port.cancel();
+    executorA.poll();
+    TEST_CHECK(executorA.getTaskCount() == 0);
+    TEST_CHECK(framesA.getFreeCount() == nFree);
+    TEST_CHECK(framesB.getFreeCount() == nFree - 1);
+
+    executorB.removeWaitable(port);
+    // B goes with its task unfinished; the frame still goes home.
+    }
+
+    TEST_CHECK(framesB.getFreeCount() == nFree);
+    TEST_CHECK(framesA.getFreeCount() == nFree);
+
+    // and a task outlives the executor whose pool it came from.
+    framesA.setDefault();
+
+    Task orphan = waitFor(fStopB, port);
+
+    TEST_CHECK(orphan.isValid());
+    framesB.setDefault();
+    TEST_CHECK(framesA.getFreeCount() == nFree - 1);
+    orphan = Task();
+    TEST_CHECK(framesA.getFreeCount() == nFree);
+    TEST_CHECK(framesB.getFreeCount() == nFree);
+
+    executorA.removeWaitable(port);
+    }
+
+/// @brief an empty pool makes an invalid task, which spawn() refuses.
+void testExhausted()
+    {
+    ModbusSerialCoFrames<1, 512> frames;
+    Executor executor(frames);
+    Port port;
+    bool fStop = false;
+
+    Task first = waitFor(fStop, port);
+    Task second = waitFor(fStop, port);
+
+    TEST_CHECK(first.isValid());
+    TEST_CHECK(! second.isValid());
+    TEST_CHECK(frames.getFailedCount() == 1);
+    TEST_CHECK(! executor.spawn(std::move(second)));
+    TEST_CHECK(executor.spawn(std::move(first)));
+    }
+
+} // namespace
+
+int main()
+    {
+    testExchange();
+    testTwoPools();
+    testExhausted();
+    return Test::report("coroutine");
+    }
@@ -0,0 +1,346 @@
+/*
+
+Module:  test_executor.cpp
+
+Function:
+    ModbusSerialWorkDeque and ModbusSerialBusExecutor under concurrent
+    use.
+
+Copyright notice and License:
+    See LICENSE file accompanying this project.
+
+Author:
+    MCCI Corporation   October 2026
+
+*/
+
+#include "MCCI_Modbus_Serial_BusExecutor.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fcntl.h>
+#include <memory>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+#include "test_common.h"
+
+using namespace McciCatena;
+
+namespace {
+
+//---- the deque ----
+
+struct Item
+    {
+    std::atomic<unsigned> nTaken { 0 };
+    };
+
+using Deque = ModbusSerialWorkDeque<Item, 64>;
+
+constexpr unsigned knThieves = 3;
+
+/// @brief the owner pushes bursts and takes one at a time while thieves
+///     steal; every item comes out exactly once.
+void testDeque()
+    {
+    constexpr std::size_t knItems = 200000;
+
+    std::unique_ptr<Item[]> pItems(new Item[knItems]);
+    Deque deque;
+    std::atomic<bool> fDone { false };
+    std::atomic<std::size_t> nStolen { 0 };
+    std::size_t nTaken = 0;
+    std::vector<std::thread> thieves;
+
+    for (unsigned i = 0; i < knThieves; ++i)
+        {
+        thieves.emplace_back([&deque, &fDone, &nStolen]
+            {
+            for (;;)
+                {
+                // look at fDone first: once it's set, the owner has
+                // stopped, and an empty deque stays empty.
+                bool const fLast = fDone.load(std::memory_order_acquire);
+                Item * const pItem = deque.steal();
+
+                if (pItem != nullptr)
+                    {
+                    pItem->nTaken.fetch_add(1, std::memory_order_relaxed);
+                    nStolen.fetch_add(1, std::memory_order_relaxed);
+                    }
+                else if (fLast && deque.isEmpty())
+                    return;
+                }
+            });
+        }
+
+    auto const take = [&deque, &nTaken]
+        {
+        Item * const pItem = deque.take();
+
+        if (pItem != nullptr)
+            {
+            pItem->nTaken.fetch_add(1, std::memory_order_relaxed);
+            ++nTaken;
+            }
+        };
+
+    std::uint32_t x = 1;
+
+    for (std::size_t i = 0; i < knItems; )
+        {
+        x ^= x << 13;
+        x ^= x >> 17;
+        x ^= x << 5;
+
+        // push a burst of up to four, then take one.
+        for (unsigned n = 1 + x % 4; n > 0 && i < knItems; --n)
+            {
+            while (! deque.push(&pItems[i]))
+                take();
+            ++i;
+            }
+
+        take();
+        }
+
+    while (! deque.isEmpty())
+        take();
+
+    fDone.store(true, std::memory_order_release);
+    for (auto &thief : thieves)
+        thief.join();
+
+    std::size_t nBad = 0;
+    for (std::size_t i = 0; i < knItems; ++i)
+        nBad += pItems[i].nTaken.load(std::memory_order_relaxed) != 1;
+
+    std::printf("deque: %zu taken, %zu stolen\n", nTaken, nStolen.load());
+    TEST_CHECK(nBad == 0);
+    TEST_CHECK(nTaken + nStolen.load() == knItems);
+    }
+
+//---- the executor ----
+
+constexpr std::size_t knBuses = 16;
+constexpr std::size_t knWorkers = 4;
+
+/// @brief how long a wakeup may take to run its bus before it's called
+///     lost. Far less than the hosts' own timers.
+constexpr auto kLostWakeup = std::chrono::seconds(1);
+
+/// @brief a port that counts the runs of its bus (each run polls the
+///     transport once), notes if two ever overlap, and records the last
+///     wakeup number a run started after. Each run takes a little while,
+///     so wakes land while it's running, too.
+class CountingPort : public ModbusSerialTermiosTransport
+    {
+public:
+    std::atomic<std::uint32_t> nRuns { 0 };
+    std::atomic<std::uint32_t> wakeSeq { 0 };
+    std::atomic<std::uint32_t> seenSeq { 0 };
+    std::atomic<bool> fOverlap { false };
+
+    virtual void poll() override
+        {
+        if (this->m_nInside.fetch_add(1, std::memory_order_acquire) != 0)
+            this->fOverlap.store(true, std::memory_order_relaxed);
+
+        this->seenSeq.store(this->wakeSeq.load(std::memory_order_seq_cst), std::memory_order_relaxed);
+        this->nRuns.fetch_add(1, std::memory_order_seq_cst);
+        std::this_thread::sleep_for(std::chrono::microseconds(100));
+        ModbusSerialTermiosTransport::poll();
+
+        this->m_nInside.fetch_sub(1, std::memory_order_release);
+        }
+
+private:
+    std::atomic<unsigned> m_nInside { 0 };
+    };
+
+/// @brief knBuses ptys, each with one host for a device that never
+///     answers. Once the hosts have given up on their first probe, their
+///     next one is tens of seconds away, so a bus runs only when its
+///     client wakes it.
+struct Rig
+    {
+    int ptyFd[knBuses];
+    CountingPort port[knBuses];
+    std::unique_ptr<ModbusSerialBus> pBus[knBuses];
+    std::unique_ptr<ModbusSerialHost> pHost[knBuses];
+    ModbusSerialThreadedClient<> client[knBuses];
+    ModbusSerialBusExecutor executor;
+
+    Rig()
+        {
+        for (std::size_t i = 0; i < knBuses; ++i)
+            {
+            this->ptyFd[i] = ::posix_openpt(O_RDWR | O_NOCTTY | O_NONBLOCK);
+            TEST_CHECK(this->ptyFd[i] >= 0 && ::grantpt(this->ptyFd[i]) == 0 && ::unlockpt(this->ptyFd[i]) == 0);
+            TEST_CHECK(this->port[i].begin(::ptsname(this->ptyFd[i]), 115200));
+
+            this->pBus[i].reset(new ModbusSerialBus(this->port[i]));
+            this->pHost[i].reset(new ModbusSerialHost(this->port[i], 1));
+            this->pHost[i]->setTurnaroundLimit(10000);
+            this->pHost[i]->setAwaitInterval(30 * 1000000, 60 * 1000000);
+
+            TEST_CHECK(this->executor.add(this->port[i], *this->pBus[i]));
+            TEST_CHECK(this->executor.add(*this->pBus[i], *this->pHost[i], this->client[i]));
+            }
+        }
+
+    ~Rig()
+        {
+        this->executor.end();
+        for (std::size_t i = 0; i < knBuses; ++i)
+            {
+            this->port[i].end();
+            if (this->ptyFd[i] >= 0)
+                ::close(this->ptyFd[i]);
+            }
+        }
+
+    /// @brief wait until no bus has run for a while.
+    void settle()
+        {
+        std::uint32_t nLast = UINT32_MAX;
+
+        for (unsigned i = 0; i < 50; ++i)
+            {
+            std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+            std::uint32_t n = 0;
+            for (auto &p : this->port)
+                n += p.nRuns.load();
+            if (n == nLast)
+                return;
+            nLast = n;
+            }
+        }
+    };
+
+/// @brief wake the bus and return true once a run has started since.
+bool wakeAndWait(CountingPort &port, ModbusSerialThreadedClient<> &client, std::uint32_t seq)
+    {
+    port.wakeSeq.store(seq, std::memory_order_seq_cst);
+    client.flushTx();
+
+    auto const tLimit = std::chrono::steady_clock::now() + kLostWakeup;
+    while (port.seenSeq.load(std::memory_order_relaxed) != seq)
+        {
+        if (std::chrono::steady_clock::now() > tLimit)
+            return false;
+        std::this_thread::yield();
+        }
+    return true;
+    }
+
+/// @brief one thread per bus wakes it over and over, from outside the
+///     workers. Each wake waits for its run, so each must cause exactly
+///     one; then a burst of wakes that don't wait may merge, but the
+///     last must still be followed by a run. No bus ever runs on two
+///     workers at once.
+void testExecutor()
+    {
+    constexpr std::uint32_t knWakes = 500;
+    constexpr std::uint32_t knBurst = 2000;
+
+    Rig rig;
+
+    TEST_CHECK(rig.executor.begin(knWorkers));
+    rig.settle();
+
+    std::uint32_t nBase[knBuses];
+    for (std::size_t i = 0; i < knBuses; ++i)
+        nBase[i] = rig.port[i].nRuns.load();
+
+    std::atomic<unsigned> nLost { 0 };
+    std::vector<std::thread> threads;
+
+    for (std::size_t i = 0; i < knBuses; ++i)
+        {
+        threads.emplace_back([&rig, &nLost, i]
+            {
+            for (std::uint32_t seq = 1; seq <= knWakes; ++seq)
+                {
+                if (! wakeAndWait(rig.port[i], rig.client[i], seq))
+                    {
+                    nLost.fetch_add(1);
+                    break;
+                    }
+                }
+            });
+        }
+    for (auto &thread : threads)
+        thread.join();
+    threads.clear();
+
+    // let any rerun finish; then every wake ran its bus once.
+    rig.settle();
+
+    std::size_t nWrongCount = 0;
+    for (std::size_t i = 0; i < knBuses; ++i)
+        {
+        auto const nRuns = rig.port[i].nRuns.load() - nBase[i];
+
+        if (nRuns != knWakes)
+            {
+            std::printf("bus %zu: %u runs for %u wakes\n", i, nRuns, knWakes);
+            ++nWrongCount;
+            }
+        nBase[i] += nRuns;
+        }
+
+    TEST_CHECK(nLost.load() == 0);
+    TEST_CHECK(nWrongCount == 0);
+
+    // now without waiting.
+    for (std::size_t i = 0; i < knBuses; ++i)
+        {
+        threads.emplace_back([&rig, i]
+            {
+            for (std::uint32_t seq = knWakes + 1; seq < knWakes + knBurst; ++seq)
+                {
+                rig.port[i].wakeSeq.store(seq, std::memory_order_seq_cst);
+                rig.client[i].flushTx();
+                }
+            });
+        }
+    for (auto &thread : threads)
+        thread.join();
+
+    for (std::size_t i = 0; i < knBuses; ++i)
+        {
+        if (! wakeAndWait(rig.port[i], rig.client[i], knWakes + knBurst))
+            nLost.fetch_add(1);
+        }
+    rig.settle();
+
+    std::size_t nTooMany = 0;
+    for (std::size_t i = 0; i < knBuses; ++i)
+        nTooMany += rig.port[i].nRuns.load() - nBase[i] > knBurst;
+
+    bool fOverlap = false;
+    for (auto &p : rig.port)
+        fOverlap |= p.fOverlap.load();
+
+    std::printf("executor: %llu runs, %llu steals\n",
+        (unsigned long long) rig.executor.getRunCount(),
+        (unsigned long long) rig.executor.getStealCount());
+
+    TEST_CHECK(nLost.load() == 0);
+    TEST_CHECK(nTooMany == 0);
+    TEST_CHECK(! fOverlap);
+    }
+
+} // namespace
+
+int main()
+    {
+    testDeque();
+    testExecutor();
+    return Test::report("executor");
+    }
@@ -0,0 +1,253 @@
+/*
+
+Module:  test_host_loopback.cpp
+
+Function:
+    ModbusSerialHost and ModbusSerialBufferedClient against a simulated
+    device over the loopback transport.
+
+Copyright notice and License:
+    See LICENSE file accompanying this project.
+
+Author:
+    MCCI Corporation   October 2026
+
+*/
+
+#include "MCCI_Modbus_Serial_BufferedClient.h"
+#include "MCCI_Modbus_Serial_LoopbackTransport.h"
+
+#include "test_common.h"
+
+using namespace McciCatena;
+
+namespace {
+
+using Host = ModbusSerialHost;
+using State = Host::State;
+using Client = ModbusSerialBufferedClient<256, 256>;
+
+constexpr std::uint8_t kUnitId = 5;
+constexpr std::uint32_t kStepMicros = 100;
+
+/// @brief a device that counts writes of Baudrate.
+class CountingDevice : public ModbusSerialDevice
+    {
+public:
+    unsigned nBaudrateWrites = 0;
+
+protected:
+    virtual void notifyBaudrate(std::uint32_t baudrate) override
+        {
+        (void) baudrate;
+        ++this->nBaudrateWrites;
+        }
+    };
+
+/// @brief one host and one device on a loopback bus.
+struct Rig
+    {
+    ModbusSerialLoopbackTransport transport { 19200 };
+    CountingDevice device;
+    Host host { transport, kUnitId };
+    Client client;
+
+    Rig()
+        { this->transport.attach(kUnitId, this->device); }
+
+    void step()
+        {
+        this->host.poll();
+        this->transport.advanceMicros(kStepMicros);
+        }
+
+    /// @brief step until the host is in state, or seconds go by.
+    bool runUntil(State state, std::uint32_t seconds)
+        {
+        for (std::uint32_t t = 0; t < seconds * 1000000; t += kStepMicros)
+            {
+            if (this->host.getState() == state)
+                return true;
+            this->step();
+            }
+        return this->host.getState() == state;
+        }
+    };
+
+std::uint8_t pattern(std::size_t i, std::uint8_t seed)
+    {
+    return std::uint8_t(i * 7 + seed + (i >> 8));
+    }
+
+/// @brief move nBytes from the application to the device's UART and
+///     nBytes from the device's UART to the application, checking that
+///     every byte arrives once, in order.
+bool transfer(Rig &rig, std::size_t nBytes, std::uint8_t seed, std::uint32_t seconds)
+    {
+    std::size_t nAppOut = 0;    // queued by the application
+    std::size_t nDevOut = 0;    // received by the device UART
+    std::size_t nUartIn = 0;    // put into the device by its UART
+    std::size_t nAppIn = 0;     // read by the application
+    bool fOk = true;
+
+    for (std::uint32_t t = 0; t < seconds * 1000000; t += kStepMicros)
+        {
+        while (nAppOut < nBytes && rig.client.getTxSpace() != 0)
+            {
+            std::uint8_t const c = pattern(nAppOut, seed);
+
+            rig.client.putTx(&c, 1);
+            ++nAppOut;
+            }
+
+        while (nUartIn < nBytes && rig.device.getRxQueue().put(pattern(nUartIn, seed + 1)))
+            ++nUartIn;
+
+        rig.step();
+
+        int c;
+
+        while ((c = rig.device.getTxQueue().get()) >= 0)
+            {
+            if (nDevOut >= nBytes || std::uint8_t(c) != pattern(nDevOut, seed))
+                fOk = false;
+            ++nDevOut;
+            }
+
+        std::uint8_t buf[64];
+        std::size_t n;
+
+        while ((n = rig.client.getRx(buf, sizeof(buf))) != 0)
+            {
+            for (std::size_t i = 0; i < n; ++i, ++nAppIn)
+                {
+                if (nAppIn >= nBytes || buf[i] != pattern(nAppIn, seed + 1))
+                    fOk = false;
+                }
+            }
+
+        if (nDevOut == nBytes && nAppIn == nBytes)
+            return fOk;
+        }
+
+    std::fprintf(
+        stderr, "transfer: out %zu/%zu, in %zu/%zu\n",
+        nDevOut, nBytes, nAppIn, nBytes
+        );
+    return false;
+    }
+
+constexpr std::size_t knTransferBytes = 4096;
+
+void testReadWrite()
+    {
+    Rig rig;
+
+    TEST_CHECK(rig.host.begin(rig.client, 115200));
+    TEST_CHECK(rig.runUntil(State::stIdle, 5));
+    TEST_CHECK(rig.device.getBaudrate() == 115200);
+    TEST_CHECK(transfer(rig, knTransferBytes, 0x10, 60));
+
+    auto const &stats = rig.host.getStats();
+
+    TEST_CHECK(rig.host.isReadWriteActive());
+    TEST_CHECK(stats.nReadWrites != 0);
+    TEST_CHECK(stats.nTxBytes == knTransferBytes);
+    TEST_CHECK(stats.nRxBytes == knTransferBytes);
+    TEST_CHECK(stats.nNoReply == 0);
+    TEST_CHECK(stats.nErrors == 0);
+    }
+
+// the host doesn't use 0x17 at all.
+void testHostReadWriteDisabled()
+    {
+    Rig rig;
+
+    rig.host.setReadWriteEnabled(false);
+    TEST_CHECK(rig.host.begin(rig.client, 115200));
+    TEST_CHECK(transfer(rig, knTransferBytes, 0x20, 60));
+
+    auto const &stats = rig.host.getStats();
+
+    TEST_CHECK(! rig.host.isReadWriteActive());
+    TEST_CHECK(stats.nReadWrites == 0);
+    TEST_CHECK(stats.nWrites != 0);
+    TEST_CHECK(stats.nTxBytes == knTransferBytes);
+    TEST_CHECK(stats.nRxBytes == knTransferBytes);
+    TEST_CHECK(stats.nErrors == 0);
+    }
+
+// the device rejects 0x17; the host must fall back to 0x10 without
+// losing or repeating data.
+void testDeviceReadWriteDisabled()
+    {
+    Rig rig;
+
+    rig.device.setReadWriteEnabled(false);
+    TEST_CHECK(rig.host.begin(rig.client, 115200));
+    TEST_CHECK(transfer(rig, knTransferBytes, 0x30, 60));
+
+    auto const &stats = rig.host.getStats();
+
+    TEST_CHECK(! rig.host.isReadWriteActive());
+    TEST_CHECK(stats.nReadWrites <= 1);
+    TEST_CHECK(stats.nWrites != 0);
+    TEST_CHECK(stats.nTxBytes == knTransferBytes);
+    TEST_CHECK(stats.nRxBytes == knTransferBytes);
+    TEST_CHECK(stats.nNoReply == 0);
+    }
+
+// the device drops off the bus and comes back; the host has to find it
+// again and carry on.
+void testFlap()
+    {
+    Rig rig;
+
+    TEST_CHECK(rig.host.begin(rig.client, 115200));
+    TEST_CHECK(transfer(rig, 1024, 0x40, 30));
+    TEST_CHECK(rig.device.nBaudrateWrites == 1);
+
+    for (unsigned iFlap = 0; iFlap < 3; ++iFlap)
+        {
+        rig.transport.detach(kUnitId);
+        TEST_CHECK(rig.runUntil(State::stAwaitDevice, 5));
+
+        // stay away long enough for the backoff to grow.
+        for (std::uint32_t t = 0; t < 2000000; t += kStepMicros)
+            rig.step();
+        TEST_CHECK(rig.host.getState() == State::stAwaitDevice);
+
+        rig.transport.attach(kUnitId, rig.device);
+        TEST_CHECK(rig.runUntil(State::stIdle, 10));
+        TEST_CHECK(transfer(rig, 1024, std::uint8_t(0x50 + iFlap), 30));
+        }
+
+    // the device kept its rate, so reconnecting just read it back.
+    TEST_CHECK(rig.device.nBaudrateWrites == 1);
+    TEST_CHECK(rig.host.getStats().nNoReply != 0);
+
+    // a device that lost its baud rate gets it back.
+    rig.transport.detach(kUnitId);
+    TEST_CHECK(rig.runUntil(State::stAwaitDevice, 5));
+
+    CountingDevice fresh;
+
+    rig.transport.attach(kUnitId, fresh);
+    TEST_CHECK(rig.runUntil(State::stIdle, 30));
+    TEST_CHECK(fresh.getBaudrate() == 115200);
+    TEST_CHECK(fresh.nBaudrateWrites == 1);
+
+    rig.host.end();
+    TEST_CHECK(rig.runUntil(State::stStopped, 5));
+    }
+
+} // namespace
+
+int main()
+    {
+    testReadWrite();
+    testHostReadWriteDisabled();
+    testDeviceReadWriteDisabled();
+    testFlap();
+    return Test::report("host_loopback");
+    }
@@ -0,0 +1,286 @@
+/*
+
+Module:  test_pty.cpp
+
+Function:
+    ModbusSerialTermiosTransport and ModbusSerialEventLoop on a pseudo-
+    terminal, with a device served by ModbusSerialRtu on the other end.
+
+Copyright notice and License:
+    See LICENSE file accompanying this project.
+
+Author:
+    MCCI Corporation   October 2026
+
+*/
+
+#include "MCCI_Modbus_Serial_BufferedClient.h"
+#include "MCCI_Modbus_Serial_Device.h"
+#include "MCCI_Modbus_Serial_EventLoop.h"
+
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "test_common.h"
+
+using namespace McciCatena;
+
+namespace {
+
+using Transaction = ModbusSerialTransaction;
+using Transport = ModbusSerialTermiosTransport;
+using Rtu = ModbusSerialRtu;
+using Register = ModbusSerialProtocol::Register;
+using StatusBits = ModbusSerialProtocol::StatusBits;
+
+constexpr std::uint8_t kUnitId = 9;
+
+/// @brief the device end of the pty: answers requests with
+///     Rtu::serveRequest(), or spoils the answer as told.
+class PtyDevice
+    {
+public:
+    enum class Fault : std::uint8_t
+        {
+        None,
+        Truncate,       ///< drop the last three bytes of the response.
+        BadCrc,         ///< flip a bit in the CRC.
+        Silent,         ///< don't answer.
+        };
+
+    ~PtyDevice()
+        {
+        if (this->m_fd >= 0)
+            ::close(this->m_fd);
+        }
+
+    bool begin()
+        {
+        this->m_fd = ::posix_openpt(O_RDWR | O_NOCTTY | O_NONBLOCK);
+        return this->m_fd >= 0 && ::grantpt(this->m_fd) == 0 && ::unlockpt(this->m_fd) == 0;
+        }
+
+    const char *getPath() const
+        { return ::ptsname(this->m_fd); }
+
+    void setFault(Fault fault)
+        { this->m_fault = fault; }
+
+    /// @brief when the last response byte was written.
+    std::uint32_t getLastWrite() const
+        { return this->m_tLastWrite; }
+
+    /// @brief answer whatever requests have arrived; never waits.
+    void poll()
+        {
+        auto const n = ::read(this->m_fd, &this->m_rxBuf[this->m_nRx], sizeof(this->m_rxBuf) - this->m_nRx);
+
+        if (n > 0)
+            this->m_nRx += std::size_t(n);
+
+        for (;;)
+            {
+            auto const nFrame = Rtu::getRequestSize(this->m_rxBuf, this->m_nRx);
+
+            if (nFrame == 0 || nFrame > this->m_nRx)
+                return;
+            if (nFrame == SIZE_MAX)
+                {
+                this->m_nRx = 0;
+                return;
+                }
+
+            this->answer(nFrame);
+            std::memmove(this->m_rxBuf, &this->m_rxBuf[nFrame], this->m_nRx - nFrame);
+            this->m_nRx -= nFrame;
+            }
+        }
+
+    ModbusSerialDevice device;
+
+private:
+    void answer(std::size_t nFrame)
+        {
+        std::uint8_t response[Rtu::knMaxFrameBytes];
+
+        if (this->m_rxBuf[0] != kUnitId)
+            return;
+
+        auto nResponse = Rtu::serveRequest(this->m_rxBuf, nFrame, this->device, response);
+
+        switch (this->m_fault)
+            {
+        case Fault::None:
+            break;
+        case Fault::Truncate:
+            nResponse -= 3;
+            break;
+        case Fault::BadCrc:
+            response[nResponse - 1] ^= 0x01;
+            break;
+        case Fault::Silent:
+            nResponse = 0;
+            break;
+            }
+
+        if (nResponse != 0 && ::write(this->m_fd, response, nResponse) == ssize_t(nResponse))
+            this->m_tLastWrite = Internal::getMicros();
+        }
+
+    int             m_fd = -1;
+    Fault           m_fault = Fault::None;
+    std::uint8_t    m_rxBuf[2 * Rtu::knMaxFrameBytes];
+    std::size_t     m_nRx = 0;
+    std::uint32_t   m_tLastWrite = 0;
+    };
+
+/// @brief run one transaction on the bare transport; return how long it
+///     took from the last response byte (or from submit(), if none) to
+///     completion.
+std::uint32_t runTransaction(Transport &transport, PtyDevice &pty, Transaction &txn)
+    {
+    txn.status = Transaction::Status::Idle;
+    if (! TEST_CHECK(transport.submit(txn)))
+        return 0;
+
+    auto const tSubmit = Internal::getMicros();
+    auto const tLastWrite = pty.getLastWrite();
+
+    while (! txn.isDone() && Internal::getMicros() - tSubmit < 2000000)
+        {
+        pty.poll();
+        transport.poll();
+        ::usleep(50);
+        }
+
+    auto const tDone = Internal::getMicros();
+
+    return tDone - (pty.getLastWrite() != tLastWrite ? pty.getLastWrite() : tSubmit);
+    }
+
+void testFrames()
+    {
+    PtyDevice pty;
+    Transport transport;
+
+    TEST_CHECK(pty.begin());
+    TEST_CHECK(transport.begin(pty.getPath(), 115200));
+
+    for (std::uint8_t n = 0; n < 20; ++n)
+        pty.device.getRxQueue().put(n);
+
+    Transaction txn;
+
+    txn.setRead(Transaction::Function::ReadInputRegisters, Register::Status_u16, 11);
+    txn.unitId = kUnitId;
+
+    // a whole frame.
+    runTransaction(transport, pty, txn);
+    TEST_CHECK(txn.status == Transaction::Status::Success);
+    TEST_CHECK(StatusBits(txn.readRegs[0]).getInputAvail() == 20);
+    TEST_CHECK(transport.getErrorCount() == 0);
+
+    // a short frame ends only once the line has been quiet long enough.
+    pty.setFault(PtyDevice::Fault::Truncate);
+
+    auto const tShort = runTransaction(transport, pty, txn);
+
+    std::printf("short frame ended %u us after its last byte\n", tShort);
+    TEST_CHECK(txn.status == Transaction::Status::Error);
+    TEST_CHECK(tShort >= Transport::kMinSilence);
+    TEST_CHECK(tShort < 500000);
+    TEST_CHECK(transport.getErrorCount() == 1);
+
+    // a bad CRC.
+    pty.setFault(PtyDevice::Fault::BadCrc);
+    runTransaction(transport, pty, txn);
+    TEST_CHECK(txn.status == Transaction::Status::Error);
+    TEST_CHECK(transport.getErrorCount() == 2);
+
+    // no answer at all: NoReply, after the response timeout.
+    constexpr std::uint32_t kTimeout = 50000;
+
+    pty.setFault(PtyDevice::Fault::Silent);
+    txn.responseTimeout = kTimeout;
+
+    auto const tSilent = runTransaction(transport, pty, txn);
+
+    TEST_CHECK(txn.status == Transaction::Status::NoReply);
+    TEST_CHECK(tSilent >= kTimeout);
+    TEST_CHECK(transport.getErrorCount() == 2);
+
+    // and the port still works.
+    pty.setFault(PtyDevice::Fault::None);
+    txn.responseTimeout = 0;
+    runTransaction(transport, pty, txn);
+    TEST_CHECK(txn.status == Transaction::Status::Success);
+    }
+
+/// @brief a host in the event loop moves data each way.
+void testEventLoop()
+    {
+    constexpr std::size_t knBytes = 2048;
+
+    PtyDevice pty;
+    Transport transport;
+    ModbusSerialEventLoop loop;
+    ModbusSerialHost host(transport, kUnitId);
+    ModbusSerialBufferedClient<256, 256> client;
+
+    TEST_CHECK(pty.begin());
+    TEST_CHECK(transport.begin(pty.getPath(), 115200));
+    TEST_CHECK(loop.begin());
+    TEST_CHECK(loop.add(transport, host));
+    TEST_CHECK(host.begin(client, 115200));
+
+    std::size_t nOut = 0, nDevOut = 0, nDevIn = 0, nIn = 0;
+    bool fOk = true;
+    auto const t0 = Internal::getMicros();
+
+    while ((nDevOut < knBytes || nIn < knBytes) && Internal::getMicros() - t0 < 20000000)
+        {
+        loop.run(200);
+        pty.poll();
+
+        while (nOut < knBytes && client.getTxSpace() != 0)
+            {
+            std::uint8_t const c = std::uint8_t(nOut++ * 3);
+
+            client.putTx(&c, 1);
+            }
+        while (nDevIn < knBytes && pty.device.getRxQueue().put(std::uint8_t(nDevIn * 5)))
+            ++nDevIn;
+
+        int c;
+
+        while ((c = pty.device.getTxQueue().get()) >= 0)
+            fOk = fOk && std::uint8_t(c) == std::uint8_t(nDevOut++ * 3);
+
+        std::uint8_t buf[64];
+
+        for (std::size_t n; (n = client.getRx(buf, sizeof(buf))) != 0; )
+            {
+            for (std::size_t i = 0; i < n; ++i)
+                fOk = fOk && buf[i] == std::uint8_t(nIn++ * 5);
+            }
+        }
+
+    std::printf("event loop: %zu out, %zu in, %u errors\n", nDevOut, nIn, transport.getErrorCount());
+    TEST_CHECK(fOk);
+    TEST_CHECK(nDevOut == knBytes);
+    TEST_CHECK(nIn == knBytes);
+    TEST_CHECK(host.getStats().nErrors == 0);
+
+    loop.remove(transport);
+    }
+
+} // namespace
+
+int main()
+    {
+    testFrames();
+    testEventLoop();
+    return Test::report("pty");
+    }
@@ -0,0 +1,195 @@
+/*
+
+Module:  test_pty_bridge.cpp
+
+Function:
+    ModbusSerialPtyBridge between a pty and a host on the loopback
+    transport.
+
+Copyright notice and License:
+    See LICENSE file accompanying this project.
+
+Author:
+    MCCI Corporation   October 2026
+
+*/
+
+#include "MCCI_Modbus_Serial_LoopbackTransport.h"
+#include "MCCI_Modbus_Serial_PtyBridge.h"
+#include "MCCI_Modbus_Serial_ThreadedClient.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <memory>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "test_common.h"
+
+using namespace McciCatena;
+
+namespace {
+
+using Host = ModbusSerialHost;
+
+constexpr std::uint8_t kUnitId = 3;
+constexpr std::uint32_t kStepMicros = 100;
+constexpr std::size_t knBytes = 20000;
+
+/// @brief the longest, in wall-clock time, any exchange may take.
+constexpr auto kTimeLimit = std::chrono::seconds(20);
+
+std::uint8_t pattern(std::size_t i, std::uint8_t seed)
+    {
+    return std::uint8_t(i * 11 + seed + (i >> 8));
+    }
+
+/// @brief a device on the loopback transport whose host is polled here,
+///     in virtual time, while the bridge's thread moves the client's
+///     bytes to and from a pty.
+struct Rig
+    {
+    ModbusSerialLoopbackTransport transport { 115200 };
+    ModbusSerialDevice device;
+    Host host { transport, kUnitId };
+    ModbusSerialThreadedClient<> client;
+    std::unique_ptr<ModbusSerialPtyBridge> pBridge { new ModbusSerialPtyBridge };
+
+    Rig()
+        {
+        this->transport.attach(kUnitId, this->device);
+        TEST_CHECK(this->host.begin(this->client, 115200));
+        }
+
+    void step()
+        {
+        this->host.poll();
+        this->transport.advanceMicros(kStepMicros);
+        }
+    };
+
+/// @brief what the tool on the pty slave writes reaches the device's
+///     UART output, and what the device's UART receives comes out of
+///     the slave; both whole and in order.
+void testExchange()
+    {
+    Rig rig;
+    char link[64];
+
+    std::snprintf(link, sizeof(link), "/tmp/test_pty_bridge.%d", int(::getpid()));
+    TEST_CHECK(rig.pBridge->add(rig.client, link));
+
+    auto const pPath = rig.pBridge->getPath(rig.client);
+    TEST_CHECK(pPath != nullptr);
+    if (pPath == nullptr)
+        return;
+
+    char target[64] = {};
+    TEST_CHECK(::readlink(link, target, sizeof(target) - 1) > 0);
+    TEST_CHECK(std::strcmp(target, pPath) == 0);
+
+    TEST_CHECK(rig.pBridge->begin());
+
+    int const fd = ::open(link, O_RDWR | O_NOCTTY | O_NONBLOCK);
+    TEST_CHECK(fd >= 0);
+    if (fd < 0)
+        return;
+
+    std::size_t nWritten = 0;
+    std::size_t nToDevice = 0;
+    std::size_t nFed = 0;
+    std::size_t nRead = 0;
+    bool fOk = true;
+    auto const tLimit = std::chrono::steady_clock::now() + kTimeLimit;
+
+    while ((nToDevice < knBytes || nRead < knBytes) && std::chrono::steady_clock::now() < tLimit)
+        {
+        // the tool writes what the pty will take...
+        if (nWritten < knBytes)
+            {
+            std::uint8_t buf[256];
+            std::size_t n = knBytes - nWritten;
+
+            if (n > sizeof(buf))
+                n = sizeof(buf);
+            for (std::size_t i = 0; i < n; ++i)
+                buf[i] = pattern(nWritten + i, 0x11);
+
+            auto const nDone = ::write(fd, buf, n);
+            if (nDone > 0)
+                nWritten += std::size_t(nDone);
+            }
+
+        // ...and reads what's there.
+        std::uint8_t buf[256];
+        auto const nGot = ::read(fd, buf, sizeof(buf));
+        for (ssize_t i = 0; i < nGot; ++i, ++nRead)
+            fOk &= buf[i] == pattern(nRead, 0x22);
+
+        // the device's UART.
+        while (nFed < knBytes && rig.device.getRxQueue().put(pattern(nFed, 0x22)))
+            ++nFed;
+
+        int c;
+        while ((c = rig.device.getTxQueue().get()) >= 0)
+            {
+            fOk &= std::uint8_t(c) == pattern(nToDevice, 0x11);
+            ++nToDevice;
+            }
+
+        rig.step();
+        }
+
+    std::printf("pty bridge: %zu bytes to the device, %zu from it\n", nToDevice, nRead);
+    TEST_CHECK(fOk);
+    TEST_CHECK(nToDevice == knBytes);
+    TEST_CHECK(nRead == knBytes);
+
+    // input that arrives while no tool has the slave open waits in the
+    // pty for the next one.
+    ::close(fd);
+
+    for (std::size_t i = 0; i < 100; ++i)
+        TEST_CHECK(rig.device.getRxQueue().put(pattern(i, 0x33)));
+    for (std::uint32_t t = 0; t < 100000; t += kStepMicros)
+        rig.step();
+
+    int const fd2 = ::open(pPath, O_RDWR | O_NOCTTY | O_NONBLOCK);
+    TEST_CHECK(fd2 >= 0);
+
+    std::size_t nLater = 0;
+    fOk = true;
+    while (fd2 >= 0 && nLater < 100 && std::chrono::steady_clock::now() < tLimit)
+        {
+        std::uint8_t buf[256];
+        auto const nGot = ::read(fd2, buf, sizeof(buf));
+
+        for (ssize_t i = 0; i < nGot; ++i, ++nLater)
+            fOk &= buf[i] == pattern(nLater, 0x33);
+        rig.step();
+        }
+
+    TEST_CHECK(fOk);
+    TEST_CHECK(nLater == 100);
+    if (fd2 >= 0)
+        ::close(fd2);
+
+    // stopping leaves the pty; destroying the bridge removes the link.
+    rig.pBridge->end();
+    TEST_CHECK(! rig.pBridge->isRunning());
+
+    struct stat st;
+    TEST_CHECK(::lstat(link, &st) == 0);
+    rig.pBridge.reset();
+    TEST_CHECK(::lstat(link, &st) != 0);
+    }
+
+} // namespace
+
+int main()
+    {
+    testExchange();
+    return Test::report("pty_bridge");
+    }
@@ -0,0 +1,150 @@
+/*
+
+Module:  test_read_size.cpp
+
+Function:
+    Status+RxData reads saved by sizing them from RxAvail history
+    (ModbusSerialReadSize).
+
+Copyright notice and License:
+    See LICENSE file accompanying this project.
+
+Author:
+    MCCI Corporation   October 2026
+
+*/
+
+#include "MCCI_Modbus_Serial_BufferedClient.h"
+#include "MCCI_Modbus_Serial_LoopbackTransport.h"
+
+#include "test_common.h"
+
+using namespace McciCatena;
+
+namespace {
+
+using StatusBits = ModbusSerialProtocol::StatusBits;
+
+/// @brief a small, repeatable generator for burst sizes and gaps.
+struct Random
+    {
+    std::uint32_t   x = 1;
+
+    std::uint32_t operator()(std::uint32_t lo, std::uint32_t hi)
+        {
+        x ^= x << 13;
+        x ^= x >> 17;
+        x ^= x << 5;
+        return lo + x % (hi - lo + 1);
+        }
+    };
+
+/// @brief reads needed to fetch nAvail characters, reading nRegs
+///     RxData registers the first time.
+std::uint32_t getReads(std::uint32_t nAvail, std::uint16_t nRegs)
+    {
+    return StatusBits().setInputAvail(std::uint8_t(nAvail)).getRegsToReadForInput() > nRegs ? 2 : 1;
+    }
+
+/// @brief feed bursts straight to the estimator, against always reading
+///     one register first.
+void testEstimator()
+    {
+    ModbusSerialReadSize readSize;
+
+    readSize.setBusTiming(115200, ModbusSerialTiming::kDefaultTurnaround);
+    TEST_CHECK(readSize.getRegs() == 1);
+
+    Random random;
+    std::uint32_t nGuessed = 0;
+    std::uint32_t nOne = 0;
+
+    for (unsigned i = 0; i < 1000; ++i)
+        {
+        auto const nAvail = random(100, 120);
+
+        nGuessed += getReads(nAvail, readSize.getRegs());
+        nOne += getReads(nAvail, 1);
+        readSize.update(StatusBits().setInputAvail(std::uint8_t(nAvail)));
+        }
+
+    std::printf("100-120 byte bursts: %u reads with one register, %u sized\n", nOne, nGuessed);
+    TEST_CHECK(nGuessed * 10 < nOne * 6);
+
+    // a link that goes quiet goes back to one register.
+    for (unsigned i = 0; i < ModbusSerialReadSize::knHistory; ++i)
+        readSize.update(StatusBits().setInputAvail(0));
+    TEST_CHECK(readSize.getRegs() == 1);
+
+    // and one that's mostly quiet stays there.
+    for (unsigned i = 0; i < ModbusSerialReadSize::knHistory; ++i)
+        readSize.update(StatusBits().setInputAvail(i == 0 ? 60 : 0));
+    TEST_CHECK(readSize.getRegs() == 1);
+    }
+
+/// @brief the host, fetching back-to-back bursts over 0x04.
+void testHost()
+    {
+    ModbusSerialLoopbackTransport transport(115200);
+    ModbusSerialDevice device;
+    ModbusSerialHost host(transport, 5);
+    ModbusSerialBufferedClient<512, 512> client;
+
+    transport.setDeviceLatency(1000);
+    device.setReadWriteEnabled(false);
+    transport.attach(5, device);
+    host.begin(client, 9600);
+
+    Random random;
+    std::uint32_t tNext = 500000;
+    std::uint32_t nBursts = 0;
+    std::uint32_t nIn = 0;
+    std::uint32_t nGot = 0;
+    std::uint32_t nReadsBefore = 0;
+    bool fOk = true;
+
+    for (std::uint32_t t = 0; t < 30 * 1000000; t += 100)
+        {
+        if (t >= tNext && device.getRxQueue().isEmpty())
+            {
+            if (nBursts == 0)
+                nReadsBefore = host.getStats().nReads;
+
+            for (auto n = random(100, 120); n != 0; --n, ++nIn)
+                device.getRxQueue().put(std::uint8_t(nIn));
+            ++nBursts;
+            tNext = t + 40000;
+            }
+
+        host.poll();
+
+        std::uint8_t buf[64];
+        std::size_t n;
+
+        while ((n = client.getRx(buf, sizeof(buf))) != 0)
+            {
+            for (std::size_t i = 0; i < n; ++i, ++nGot)
+                fOk = fOk && buf[i] == std::uint8_t(nGot);
+            }
+
+        transport.advanceMicros(100);
+        }
+
+    auto const nReads = host.getStats().nReads - nReadsBefore;
+
+    std::printf("host: %u bursts, %u reads\n", nBursts, nReads);
+    TEST_CHECK(fOk);
+    TEST_CHECK(nGot + 120 >= nIn);
+
+    // one register first would take two reads a burst, at least.
+    TEST_CHECK(nReads * 10 < nBursts * 15);
+    }
+
+} // namespace
+
+int main()
+    {
+    testEstimator();
+    testHost();
+    return Test::report("read_size");
+    }
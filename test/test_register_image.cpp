@@ -0,0 +1,148 @@
+/*
+
+Module:  test_register_image.cpp
+
+Function:
+    ModbusSerialProtocol::RegisterImage against a byte-at-a-time
+    reference.
+
+Copyright notice and License:
+    See LICENSE file accompanying this project.
+
+Author:
+    MCCI Corporation   October 2026
+
+*/
+
+#include "MCCI_Modbus_Serial_Protocol.h"
+
+#include "test_common.h"
+
+using namespace McciCatena;
+
+namespace {
+
+using RegisterImage = ModbusSerialProtocol::RegisterImage;
+
+/// @brief longest run tried: past two full windows, so every SIMD
+///     block count and tail length comes up.
+constexpr std::size_t knMaxBytes = 260;
+/// @brief start offsets tried, to cover misaligned buffers.
+constexpr std::size_t knOffsets = 3;
+
+constexpr std::uint16_t kRegGuard = 0xAAAA;
+constexpr std::uint8_t kByteGuard = 0x55;
+
+std::uint32_t g_random = 1;
+
+std::uint8_t getRandom()
+    {
+    g_random ^= g_random << 13;
+    g_random ^= g_random >> 17;
+    g_random ^= g_random << 5;
+    return std::uint8_t(g_random);
+    }
+
+/// @brief the reference: high byte first, an odd last byte alone in the
+///     high byte of its register.
+std::uint16_t referenceReg(const std::uint8_t *pBuf, std::size_t nBytes, std::size_t iReg)
+    {
+    std::size_t const i = 2 * iReg;
+
+    return std::uint16_t((pBuf[i] << 8) | (i + 1 < nBytes ? pBuf[i + 1] : 0));
+    }
+
+void testPack()
+    {
+    std::uint8_t buf[knOffsets + knMaxBytes];
+    std::uint16_t regs[knOffsets + knMaxBytes / 2 + 2];
+    unsigned nBad = 0;
+
+    for (std::size_t off = 0; off < knOffsets; ++off)
+        {
+        for (std::size_t n = 0; n <= knMaxBytes; ++n)
+            {
+            std::uint8_t * const pBuf = &buf[off];
+            std::uint16_t * const pRegs = &regs[off];
+            std::size_t const nRegs = (n + 1) / 2;
+
+            for (std::size_t i = 0; i < n; ++i)
+                pBuf[i] = getRandom();
+            for (auto &r : regs)
+                r = kRegGuard;
+
+            nBad += RegisterImage::pack(pRegs, pBuf, n) != nRegs;
+            for (std::size_t i = 0; i < nRegs; ++i)
+                nBad += pRegs[i] != referenceReg(pBuf, n, i);
+            nBad += pRegs[nRegs] != kRegGuard;
+            }
+        }
+
+    TEST_CHECK(nBad == 0);
+    }
+
+void testUnpack()
+    {
+    std::uint8_t buf[knOffsets + knMaxBytes + 1];
+    std::uint16_t regs[knOffsets + knMaxBytes / 2 + 1];
+    unsigned nBad = 0;
+
+    for (std::size_t off = 0; off < knOffsets; ++off)
+        {
+        for (std::size_t n = 0; n <= knMaxBytes; ++n)
+            {
+            std::uint8_t * const pBuf = &buf[off];
+            std::uint16_t * const pRegs = &regs[off];
+
+            // the low byte of an odd last register is noise, and must
+            // be ignored.
+            for (std::size_t i = 0; i < (n + 1) / 2; ++i)
+                pRegs[i] = std::uint16_t((getRandom() << 8) | getRandom());
+            for (auto &b : buf)
+                b = kByteGuard;
+
+            RegisterImage::unpack(pBuf, pRegs, n);
+            for (std::size_t i = 0; i < n; ++i)
+                {
+                std::uint16_t const reg = pRegs[i / 2];
+
+                nBad += pBuf[i] != std::uint8_t(i % 2 == 0 ? reg >> 8 : reg);
+                }
+            nBad += pBuf[n] != kByteGuard;
+            }
+        }
+
+    TEST_CHECK(nBad == 0);
+    }
+
+/// @brief pack, then unpack, gives back what went in.
+void testRoundTrip()
+    {
+    std::uint8_t in[knMaxBytes] = {};
+    std::uint8_t out[knMaxBytes];
+    std::uint16_t regs[knMaxBytes / 2];
+    unsigned nBad = 0;
+
+    for (std::size_t n = 0; n <= knMaxBytes; ++n)
+        {
+        for (std::size_t i = 0; i < n; ++i)
+            in[i] = getRandom();
+
+        RegisterImage::pack(regs, in, n);
+        RegisterImage::unpack(out, regs, n);
+        for (std::size_t i = 0; i < n; ++i)
+            nBad += out[i] != in[i];
+        }
+
+    TEST_CHECK(nBad == 0);
+    }
+
+} // namespace
+
+int main()
+    {
+    testPack();
+    testUnpack();
+    testRoundTrip();
+    return Test::report("register_image");
+    }
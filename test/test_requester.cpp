@@ -0,0 +1,231 @@
+/*
+
+Module:  test_requester.cpp
+
+Function:
+    ModbusSerialRequester and ModbusSerialRequestPool over a loopback
+    bus.
+
+Copyright notice and License:
+    See LICENSE file accompanying this project.
+
+Author:
+    MCCI Corporation   October 2026
+
+*/
+
+#include "MCCI_Modbus_Serial_LoopbackTransport.h"
+#include "MCCI_Modbus_Serial_Requester.h"
+
+#include "test_common.h"
+
+using namespace McciCatena;
+
+namespace {
+
+using Request = ModbusSerialRequest;
+using Requester = ModbusSerialRequester;
+using Pool = ModbusSerialRequestPool;
+using StatusBits = ModbusSerialProtocol::StatusBits;
+using Transport = ModbusSerialLoopbackTransport;
+
+/// @brief a device with 0x17, and one without.
+constexpr std::uint8_t kUnitRw = 3;
+constexpr std::uint8_t kUnitNoRw = 4;
+constexpr std::uint8_t kUnitMissing = 9;
+
+constexpr std::uint32_t kStepMicros = 100;
+
+/// @brief what the callbacks saw.
+struct Log
+    {
+    static constexpr std::size_t knMax = 16;
+
+    Request         *pRequest[knMax];
+    std::size_t     nCalls = 0;
+    Pool            *pPool = nullptr;   ///< free each request here.
+
+    static void onDone(void *pCtx, Request &request)
+        {
+        Log &log = *static_cast<Log *>(pCtx);
+
+        if (log.nCalls < knMax)
+            log.pRequest[log.nCalls] = &request;
+        ++log.nCalls;
+        if (log.pPool != nullptr)
+            log.pPool->free(request);
+        }
+    };
+
+/// @brief poll until nothing is busy, or a few seconds go by.
+bool drain(Requester &requester, Transport &transport)
+    {
+    for (std::uint32_t t = 0; t < 5000000; t += kStepMicros)
+        {
+        requester.poll();
+        if (requester.getBusyCount() == 0)
+            return true;
+        transport.advanceMicros(kStepMicros);
+        }
+    return false;
+    }
+
+/// @brief the pool hands out each request once, then runs dry.
+void testPool()
+    {
+    Request requests[3];
+    Pool pool(requests, 3);
+    Request *p[4];
+
+    TEST_CHECK(pool.getFreeCount() == 3);
+    for (auto &pRequest : p)
+        pRequest = pool.allocate();
+
+    TEST_CHECK(p[0] != nullptr && p[1] != nullptr && p[2] != nullptr);
+    TEST_CHECK(p[0] != p[1] && p[1] != p[2] && p[0] != p[2]);
+    TEST_CHECK(p[3] == nullptr);
+    TEST_CHECK(pool.getFreeCount() == 0);
+
+    pool.free(*p[1]);
+    TEST_CHECK(pool.getFreeCount() == 1);
+    TEST_CHECK(pool.allocate() == p[1]);
+    TEST_CHECK(pool.allocate() == nullptr);
+    }
+
+/// @brief reads call back once each, in order, with the input; a
+///     request that isn't set up, or is busy, is refused.
+void testCallbacks()
+    {
+    Transport transport(115200);
+    ModbusSerialDevice device;
+    Requester requester(transport);
+    Request requests[4];
+    Pool pool(requests, 4);
+    Log log;
+
+    log.pPool = &pool;
+    transport.attach(kUnitRw, device);
+    for (std::uint8_t c = 0; c < 10; ++c)
+        device.getRxQueue().put(std::uint8_t('a' + c));
+
+    Request *pBlank = pool.allocate();
+
+    TEST_CHECK(! requester.submit(*pBlank, Log::onDone, &log));
+    pool.free(*pBlank);
+
+    Request *p[3];
+
+    for (auto &pRequest : p)
+        {
+        pRequest = pool.allocate();
+        pRequest->setReadInput(kUnitRw, 4);
+        TEST_CHECK(requester.submit(*pRequest, Log::onDone, &log));
+        }
+
+    TEST_CHECK(! requester.submit(*p[0], Log::onDone, &log));
+    TEST_CHECK(requester.getBusyCount() == 3);
+    TEST_CHECK(pool.getFreeCount() == 1);
+
+    // withdraw the last one before it goes.
+    TEST_CHECK(requester.cancel(*p[2]));
+    TEST_CHECK(! p[2]->isBusy());
+    pool.free(*p[2]);
+
+    TEST_CHECK(drain(requester, transport));
+    TEST_CHECK(log.nCalls == 2);
+    TEST_CHECK(log.pRequest[0] == p[0] && log.pRequest[1] == p[1]);
+    TEST_CHECK(pool.getFreeCount() == 4);
+
+    // four characters each, in order.
+    for (unsigned i = 0; i < 2; ++i)
+        {
+        Request const &r = *p[i];
+
+        TEST_CHECK(r.isSuccess() && r.hasStatus());
+        TEST_CHECK(r.getDataSize() == 4);
+        for (std::size_t j = 0; j < r.getDataSize(); ++j)
+            TEST_CHECK(r.getData()[j] == std::uint8_t('a' + 4 * i + j));
+        }
+    // Status is read ahead of RxData, so it counts what's read with it.
+    TEST_CHECK(p[0]->getStatus().getInputAvail() == 10);
+    TEST_CHECK(p[1]->getStatus().getInputAvail() == 6);
+
+    // a missing unit still calls back, with NoReply.
+    Request &missing = *pool.allocate();
+
+    missing.setReadInput(kUnitMissing, 2);
+    TEST_CHECK(requester.submit(missing, Log::onDone, &log));
+    TEST_CHECK(drain(requester, transport));
+    TEST_CHECK(log.nCalls == 3);
+    TEST_CHECK(missing.getResult() == ModbusSerialTransaction::Status::NoReply);
+    TEST_CHECK(! missing.hasStatus());
+    }
+
+/// @brief a device without 0x17 gets its write again as 0x10, and only
+///     it: the other unit keeps 0x17.
+void testReadWriteFallback()
+    {
+    Transport transport(115200);
+    ModbusSerialDevice rw, noRw;
+    Requester requester(transport);
+    Request request;
+    Log log;
+    std::uint8_t const data[5] = { 1, 2, 3, 4, 5 };
+    StatusBits status;
+
+    noRw.setReadWriteEnabled(false);
+    transport.attach(kUnitRw, rw);
+    transport.attach(kUnitNoRw, noRw);
+    status.setTxAvail(100);
+
+    TEST_CHECK(requester.isReadWriteEnabled(kUnitRw));
+    TEST_CHECK(requester.isReadWriteEnabled(kUnitNoRw));
+
+    // refused, then sent again with 0x10: two transactions, one callback.
+    auto nTxns = transport.getTransactionCount();
+
+    TEST_CHECK(request.setWriteTx(kUnitNoRw, status, data, sizeof(data)) == sizeof(data));
+    TEST_CHECK(requester.submit(request, Log::onDone, &log));
+    TEST_CHECK(drain(requester, transport));
+    TEST_CHECK(log.nCalls == 1);
+    TEST_CHECK(request.isSuccess() && ! request.hasStatus());
+    TEST_CHECK(transport.getTransactionCount() - nTxns == 2);
+    TEST_CHECK(noRw.getTxQueue().available() == sizeof(data));
+    TEST_CHECK(! requester.isReadWriteEnabled(kUnitNoRw));
+
+    // the other unit still gets 0x17, with Status.
+    TEST_CHECK(requester.isReadWriteEnabled(kUnitRw));
+    nTxns = transport.getTransactionCount();
+    request.setWriteTx(kUnitRw, status, data, sizeof(data));
+    TEST_CHECK(requester.submit(request, Log::onDone, &log));
+    TEST_CHECK(drain(requester, transport));
+    TEST_CHECK(request.isSuccess() && request.hasStatus());
+    TEST_CHECK(transport.getTransactionCount() - nTxns == 1);
+    TEST_CHECK(rw.getTxQueue().available() == sizeof(data));
+
+    // and the refusing unit goes straight to 0x10 now.
+    nTxns = transport.getTransactionCount();
+    request.setWriteTx(kUnitNoRw, status, data, sizeof(data));
+    TEST_CHECK(requester.submit(request, Log::onDone, &log));
+    TEST_CHECK(drain(requester, transport));
+    TEST_CHECK(request.isSuccess() && ! request.hasStatus());
+    TEST_CHECK(transport.getTransactionCount() - nTxns == 1);
+    TEST_CHECK(noRw.getTxQueue().available() == 2 * sizeof(data));
+    TEST_CHECK(log.nCalls == 3);
+
+    // re-enabling asks it again.
+    requester.setReadWriteEnabled(true);
+    TEST_CHECK(requester.isReadWriteEnabled(kUnitNoRw));
+    requester.setReadWriteEnabled(false);
+    TEST_CHECK(! requester.isReadWriteEnabled(kUnitRw));
+    }
+
+} // namespace
+
+int main()
+    {
+    testPool();
+    testCallbacks();
+    testReadWriteFallback();
+    return Test::report("requester");
+    }
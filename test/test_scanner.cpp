@@ -0,0 +1,154 @@
+/*
+
+Module:  test_scanner.cpp
+
+Function:
+    ModbusSerialScanner on a simulated RTU bus, and against
+    ModbusSerialTcpDeviceServer with many probes in flight.
+
+Copyright notice and License:
+    See LICENSE file accompanying this project.
+
+Author:
+    MCCI Corporation   October 2026
+
+*/
+
+#include "MCCI_Modbus_Serial_LoopbackTransport.h"
+#include "MCCI_Modbus_Serial_Scanner.h"
+#include "MCCI_Modbus_Serial_TcpDeviceServer.h"
+#include "MCCI_Modbus_Serial_TcpTransport.h"
+
+#include "test_common.h"
+
+using namespace McciCatena;
+
+namespace {
+
+using Scanner = ModbusSerialScanner;
+using Result = Scanner::Result;
+
+constexpr std::uint8_t kUnits[] = { 5, 77, 200 };
+constexpr std::size_t knUnits = sizeof(kUnits) / sizeof(kUnits[0]);
+
+/// @brief count the units with a given result.
+unsigned count(const Scanner &scanner, Result result)
+    {
+    unsigned n = 0;
+
+    for (unsigned i = 0; i < 256; ++i)
+        n += scanner.getResult(std::uint8_t(i)) == result;
+    return n;
+    }
+
+/// @brief the scan found exactly kUnits, and nothing else answered.
+void checkFound(const Scanner &scanner)
+    {
+    std::uint8_t found[knUnits + 1];
+    auto const nFound = scanner.getFound(found, sizeof(found));
+
+    TEST_CHECK(nFound == knUnits);
+    for (std::size_t i = 0; i < knUnits && i < nFound; ++i)
+        TEST_CHECK(found[i] == kUnits[i]);
+
+    TEST_CHECK(count(scanner, Result::Found) == knUnits);
+    TEST_CHECK(count(scanner, Result::Foreign) == 0);
+    TEST_CHECK(count(scanner, Result::Absent) == Scanner::kMaxUnitId - knUnits);
+    TEST_CHECK(scanner.getResult(0) == Result::NotScanned);
+    TEST_CHECK(scanner.getResult(248) == Result::NotScanned);
+
+    // getFound() says how many there are, even if they don't all fit.
+    TEST_CHECK(scanner.getFound(found, 1) == knUnits && found[0] == kUnits[0]);
+    }
+
+/// @brief one probe at a time on a 19200 baud bus.
+void testRtu()
+    {
+    ModbusSerialLoopbackTransport transport(19200);
+    ModbusSerialDevice device[knUnits];
+    Scanner scanner(transport);
+
+    device[1].getRxQueue().put('x');
+    for (std::size_t i = 0; i < knUnits; ++i)
+        transport.attach(kUnits[i], device[i]);
+
+    TEST_CHECK(scanner.begin());
+    TEST_CHECK(! scanner.begin());
+
+    auto const t0 = transport.getMicros();
+
+    while (scanner.isRunning() && transport.getMicros() - t0 < 60000000)
+        {
+        scanner.poll();
+        transport.advanceMicros(50);
+        }
+
+    std::printf("rtu: scanned in %u ms\n", (transport.getMicros() - t0) / 1000);
+    checkFound(scanner);
+    TEST_CHECK(scanner.getStatus(77).getInputAvail() == 1);
+    TEST_CHECK(scanner.getStatus(5).getInputAvail() == 0);
+
+    // a narrower scan forgets the rest.
+    TEST_CHECK(scanner.begin(70, 80));
+    while (scanner.isRunning())
+        {
+        scanner.poll();
+        transport.advanceMicros(50);
+        }
+
+    std::uint8_t found[4];
+
+    TEST_CHECK(scanner.getFound(found, 4) == 1 && found[0] == 77);
+    TEST_CHECK(count(scanner, Result::Absent) == 10);
+    TEST_CHECK(scanner.getResult(5) == Result::NotScanned);
+    }
+
+/// @brief over Modbus TCP, a full window of probes goes out at once.
+void testTcp()
+    {
+    ModbusSerialTcpDeviceServer server;
+    ModbusSerialTcpTransport transport;
+    ModbusSerialDevice device[knUnits];
+
+    TEST_CHECK(server.begin(0));
+    for (std::size_t i = 0; i < knUnits; ++i)
+        server.attach(kUnits[i], device[i]);
+
+    // slow enough that the probes pile up.
+    server.setResponseDelay(5000);
+    TEST_CHECK(transport.begin("127.0.0.1", server.getPort()));
+    transport.setResponseTimeout(200000);
+
+    Scanner scanner(transport);
+    std::size_t nMaxPending = 0;
+    auto const t0 = Internal::getMicros();
+
+    TEST_CHECK(scanner.begin());
+    while (scanner.isRunning() && Internal::getMicros() - t0 < 20000000)
+        {
+        server.poll();
+        scanner.poll();
+        if (transport.getPendingCount() > nMaxPending)
+            nMaxPending = transport.getPendingCount();
+        }
+
+    std::printf(
+        "tcp: scanned in %u ms, %zu in flight\n",
+        (Internal::getMicros() - t0) / 1000, nMaxPending
+        );
+    checkFound(scanner);
+    TEST_CHECK(nMaxPending == Scanner::knMaxInFlight);
+    TEST_CHECK(server.getMaxQueued() == Scanner::knMaxInFlight);
+
+    transport.end();
+    server.end();
+    }
+
+} // namespace
+
+int main()
+    {
+    testRtu();
+    testTcp();
+    return Test::report("scanner");
+    }
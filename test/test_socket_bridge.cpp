@@ -0,0 +1,365 @@
+/*
+
+Module:  test_socket_bridge.cpp
+
+Function:
+    ModbusSerialSocketBridge between TCP connections and hosts on the
+    loopback transport.
+
+Copyright notice and License:
+    See LICENSE file accompanying this project.
+
+Author:
+    MCCI Corporation   October 2026
+
+*/
+
+#include "MCCI_Modbus_Serial_LoopbackTransport.h"
+#include "MCCI_Modbus_Serial_SocketBridge.h"
+#include "MCCI_Modbus_Serial_ThreadedClient.h"
+
+#include <arpa/inet.h>
+#include <chrono>
+#include <cstdio>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include "test_common.h"
+
+using namespace McciCatena;
+
+namespace {
+
+using Host = ModbusSerialHost;
+
+constexpr std::uint8_t kUnitId = 4;
+constexpr std::uint32_t kStepMicros = 100;
+constexpr std::size_t knLines = 2;
+
+/// @brief the longest, in wall-clock time, any exchange may take.
+constexpr auto kTimeLimit = std::chrono::seconds(20);
+
+std::uint8_t pattern(std::size_t i, std::uint8_t seed)
+    {
+    return std::uint8_t(i * 13 + seed + (i >> 8));
+    }
+
+/// @brief a device on its own loopback transport, whose host is polled
+///     here, in virtual time.
+struct Line
+    {
+    ModbusSerialLoopbackTransport transport { 115200 };
+    ModbusSerialDevice device;
+    Host host { transport, kUnitId };
+    ModbusSerialThreadedClient<> client;
+
+    Line()
+        {
+        this->transport.attach(kUnitId, this->device);
+        TEST_CHECK(this->host.begin(this->client, 115200));
+        }
+
+    void step()
+        {
+        this->host.poll();
+        this->transport.advanceMicros(kStepMicros);
+        }
+    };
+
+/// @brief knLines lines, each with a port on the bridge.
+struct Rig
+    {
+    Line line[knLines];
+    ModbusSerialSocketBridge bridge;
+
+    Rig()
+        {
+        for (auto &l : this->line)
+            {
+            TEST_CHECK(this->bridge.add(l.client, 0));
+            TEST_CHECK(this->bridge.getPort(l.client) != 0);
+            }
+        TEST_CHECK(this->bridge.getPort(this->line[0].client) != this->bridge.getPort(this->line[1].client));
+        TEST_CHECK(this->bridge.begin());
+        }
+
+    void step()
+        {
+        for (auto &l : this->line)
+            l.step();
+        }
+
+    /// @brief open a non-blocking connection to line i's port.
+    int connect(std::size_t i)
+        {
+        int const fd = ::socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+        sockaddr_in addr {};
+
+        addr.sin_family = AF_INET;
+        addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        addr.sin_port = htons(this->bridge.getPort(this->line[i].client));
+
+        if (fd < 0 || ::connect(fd, reinterpret_cast<sockaddr *>(&addr), sizeof(addr)) != 0)
+            {
+            if (fd >= 0)
+                ::close(fd);
+            return -1;
+            }
+
+        (void) ::fcntl(fd, F_SETFL, ::fcntl(fd, F_GETFL) | O_NONBLOCK);
+        return fd;
+        }
+    };
+
+/// @brief one direction of one stream: what's been sent, and what's
+///     been checked at the far end.
+struct Stream
+    {
+    std::uint8_t seed;
+    std::size_t nSent = 0;
+    std::size_t nGot = 0;
+    bool fOk = true;
+
+    void check(const std::uint8_t *pBuf, std::size_t n)
+        {
+        for (std::size_t i = 0; i < n; ++i, ++this->nGot)
+            this->fOk &= pBuf[i] == pattern(this->nGot, this->seed);
+        }
+    };
+
+/// @brief write what the socket will take of nBytes of s.
+void send(int fd, Stream &s, std::size_t nBytes)
+    {
+    std::uint8_t buf[512];
+    std::size_t n = nBytes - s.nSent;
+
+    if (n > sizeof(buf))
+        n = sizeof(buf);
+    for (std::size_t i = 0; i < n; ++i)
+        buf[i] = pattern(s.nSent + i, s.seed);
+
+    auto const nDone = n != 0 ? ::write(fd, buf, n) : 0;
+    if (nDone > 0)
+        s.nSent += std::size_t(nDone);
+    }
+
+/// @brief read and check what's waiting; return false at end of file.
+bool receive(int fd, Stream &s)
+    {
+    std::uint8_t buf[512];
+    auto const n = ::read(fd, buf, sizeof(buf));
+
+    if (n > 0)
+        s.check(buf, std::size_t(n));
+    return n != 0;
+    }
+
+/// @brief feed up to nBytes of s to the device's UART input, and check
+///     its UART output against d.
+void serveDevice(Line &line, Stream &s, std::size_t nBytes, Stream &d)
+    {
+    while (s.nSent < nBytes && line.device.getRxQueue().put(pattern(s.nSent, s.seed)))
+        ++s.nSent;
+
+    int c;
+    while ((c = line.device.getTxQueue().get()) >= 0)
+        {
+        std::uint8_t const b = std::uint8_t(c);
+        d.check(&b, 1);
+        }
+    }
+
+/// @brief both lines move 20000 bytes each way at once, whole and in
+///     order; and a second connection to a busy port is turned away.
+void testExchange()
+    {
+    constexpr std::size_t knBytes = 20000;
+
+    Rig rig;
+    int fd[knLines];
+    Stream up[knLines] = { { 0x10 }, { 0x20 } };
+    Stream down[knLines] = { { 0x30 }, { 0x40 } };
+
+    for (std::size_t i = 0; i < knLines; ++i)
+        TEST_CHECK((fd[i] = rig.connect(i)) >= 0);
+
+    auto const tLimit = std::chrono::steady_clock::now() + kTimeLimit;
+    bool fDone = false;
+
+    while (! fDone && std::chrono::steady_clock::now() < tLimit)
+        {
+        fDone = true;
+        for (std::size_t i = 0; i < knLines; ++i)
+            {
+            send(fd[i], up[i], knBytes);
+            (void) receive(fd[i], down[i]);
+            serveDevice(rig.line[i], down[i], knBytes, up[i]);
+            fDone &= up[i].nGot == knBytes && down[i].nGot == knBytes;
+            }
+        rig.step();
+        }
+
+    for (std::size_t i = 0; i < knLines; ++i)
+        {
+        TEST_CHECK(up[i].fOk && up[i].nGot == knBytes);
+        TEST_CHECK(down[i].fOk && down[i].nGot == knBytes);
+        }
+
+    // the port is taken: the bridge accepts and closes at once.
+    int const fdExtra = rig.connect(0);
+    TEST_CHECK(fdExtra >= 0);
+
+    Stream none { 0 };
+    bool fClosed = false;
+    while (fdExtra >= 0 && ! fClosed && std::chrono::steady_clock::now() < tLimit)
+        fClosed = ! receive(fdExtra, none);
+    TEST_CHECK(fClosed && none.nGot == 0);
+    if (fdExtra >= 0)
+        ::close(fdExtra);
+
+    // and the first connection carries on.
+    Stream more { 0x50 };
+    Stream toDevice { 0x50 };
+    while (toDevice.nGot < 100 && std::chrono::steady_clock::now() < tLimit)
+        {
+        send(fd[0], more, 100);
+        serveDevice(rig.line[0], none, 0, toDevice);
+        rig.step();
+        }
+    TEST_CHECK(toDevice.fOk && toDevice.nGot == 100);
+
+    for (auto f : fd)
+        {
+        if (f >= 0)
+            ::close(f);
+        }
+    }
+
+/// @brief connections go away with data queued both ways. An orderly
+///     close still delivers everything sent before it. A reset loses
+///     what was in the kernel, but output the client already had still
+///     goes to the device, and the device's input waits for the next
+///     connection, which gets it in order.
+void testDisconnect()
+    {
+    constexpr std::size_t knUp = 3000;
+    constexpr std::size_t knDown = 20000;
+
+    Rig rig;
+    Line &line = rig.line[0];
+    auto const tLimit = std::chrono::steady_clock::now() + kTimeLimit;
+    Stream none { 0 };
+
+    // orderly: send, close without reading, and everything arrives.
+    int fd = rig.connect(0);
+    TEST_CHECK(fd >= 0);
+
+    Stream up { 0x60 };
+    Stream atDevice { 0x60 };
+
+    while (fd >= 0 && up.nSent < knUp && std::chrono::steady_clock::now() < tLimit)
+        {
+        send(fd, up, knUp);
+        rig.step();
+        }
+    if (fd >= 0)
+        ::close(fd);
+
+    while (atDevice.nGot < knUp && std::chrono::steady_clock::now() < tLimit)
+        {
+        serveDevice(line, none, 0, atDevice);
+        rig.step();
+        }
+    TEST_CHECK(atDevice.fOk && atDevice.nGot == knUp);
+
+    // reset: the tool sends more than the device can take in 20 ms, and
+    // reads nothing of the device's input, then aborts.
+    fd = rig.connect(0);
+    TEST_CHECK(fd >= 0);
+
+    Stream up2 { 0x70 };
+    Stream atDevice2 { 0x70 };
+    Stream down { 0x80 };
+
+    for (std::uint32_t t = 0; fd >= 0 && t < 20000; t += kStepMicros)
+        {
+        send(fd, up2, knUp);
+        serveDevice(line, down, knDown, atDevice2);
+        rig.step();
+        }
+
+    auto const nAtReset = atDevice2.nGot;
+    linger const abort { 1, 0 };
+
+    if (fd >= 0)
+        {
+        (void) ::setsockopt(fd, SOL_SOCKET, SO_LINGER, &abort, sizeof(abort));
+        ::close(fd);
+        }
+
+    for (std::uint32_t t = 0; t < 2000000; t += kStepMicros)
+        {
+        serveDevice(line, down, knDown, atDevice2);
+        rig.step();
+        }
+
+    // the device got a prefix of the tool's output, including what the
+    // client still had at the reset.
+    std::printf("socket bridge: reset with %zu of %zu bytes at the device; %zu after\n",
+        nAtReset, up2.nSent, atDevice2.nGot);
+    TEST_CHECK(atDevice2.fOk);
+    TEST_CHECK(atDevice2.nGot > nAtReset);
+    TEST_CHECK(atDevice2.nGot <= up2.nSent);
+
+    // the next connection works, and gets the rest of the device's
+    // input: from wherever the reset cut it, in order, to the end.
+    fd = rig.connect(0);
+    TEST_CHECK(fd >= 0);
+
+    static std::uint8_t tail[knDown];
+    std::size_t nTail = 0;
+    std::uint32_t nIdle = 0;
+    Stream up3 { 0x90 };
+    Stream atDevice3 { 0x90 };
+
+    while (fd >= 0 && std::chrono::steady_clock::now() < tLimit)
+        {
+        send(fd, up3, knUp);
+
+        auto const n = ::read(fd, &tail[nTail], sizeof(tail) - nTail);
+        if (n > 0)
+            {
+            nTail += std::size_t(n);
+            nIdle = 0;
+            }
+        else if (atDevice3.nGot == knUp && down.nSent == knDown && ++nIdle > 10000)
+            break;
+
+        serveDevice(line, down, knDown, atDevice3);
+        rig.step();
+        }
+
+    TEST_CHECK(atDevice3.fOk && atDevice3.nGot == knUp);
+    TEST_CHECK(down.nSent == knDown);
+    TEST_CHECK(nTail != 0);
+
+    bool fTailOk = true;
+    for (std::size_t i = 0; i < nTail; ++i)
+        fTailOk &= tail[i] == pattern(knDown - nTail + i, down.seed);
+    std::printf("socket bridge: the next connection got the last %zu bytes of input\n", nTail);
+    TEST_CHECK(fTailOk);
+
+    if (fd >= 0)
+        ::close(fd);
+    }
+
+} // namespace
+
+int main()
+    {
+    testExchange();
+    testDisconnect();
+    return Test::report("socket_bridge");
+    }
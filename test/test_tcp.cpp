@@ -0,0 +1,307 @@
+/*
+
+Module:  test_tcp.cpp
+
+Function:
+    ModbusSerialTcpTransport against ModbusSerialTcpDeviceServer, and
+    against a gateway that answers out of order.
+
+Copyright notice and License:
+    See LICENSE file accompanying this project.
+
+Author:
+    MCCI Corporation   October 2026
+
+*/
+
+#include "MCCI_Modbus_Serial_TcpDeviceServer.h"
+#include "MCCI_Modbus_Serial_TcpTransport.h"
+
+#include <arpa/inet.h>
+#include <cstring>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include "test_common.h"
+
+using namespace McciCatena;
+
+namespace {
+
+using Transaction = ModbusSerialTransaction;
+using Transport = ModbusSerialTcpTransport;
+using Server = ModbusSerialTcpDeviceServer;
+using Mbap = ModbusSerialMbap;
+using StatusBits = ModbusSerialProtocol::StatusBits;
+using Register = ModbusSerialProtocol::Register;
+
+constexpr std::size_t knUnits = Transport::knMaxPending;
+
+/// @brief poll the server and transport until fDone() or us go by.
+template <typename F>
+bool pump(Server *pServer, Transport &transport, F fDone, std::uint32_t us)
+    {
+    auto const t0 = Internal::getMicros();
+
+    while (! fDone())
+        {
+        if (Internal::getMicros() - t0 > us)
+            return false;
+        if (pServer != nullptr)
+            pServer->poll();
+        transport.poll();
+        ::usleep(100);
+        }
+    return true;
+    }
+
+void setStatusRead(Transaction &txn, std::uint8_t unitId)
+    {
+    txn = Transaction();
+    txn.setRead(Transaction::Function::ReadInputRegisters, Register::Status_u16, 1);
+    txn.unitId = unitId;
+    }
+
+bool allDone(const Transaction *pTxn, std::size_t n)
+    {
+    for (std::size_t i = 0; i < n; ++i)
+        {
+        if (! pTxn[i].isDone())
+            return false;
+        }
+    return true;
+    }
+
+/// @brief devices 1..knUnits, each holding as many input characters as
+///     its unit ID, so every Status read is different.
+struct Devices
+    {
+    ModbusSerialDevice device[knUnits];
+
+    Devices()
+        {
+        for (std::size_t i = 0; i < knUnits; ++i)
+            {
+            for (std::size_t n = 0; n <= i; ++n)
+                this->device[i].getRxQueue().put(std::uint8_t(n));
+            }
+        }
+
+    static bool checkRead(const Transaction &txn)
+        {
+        return txn.status == Transaction::Status::Success &&
+               StatusBits(txn.readRegs[0]).getInputAvail() == txn.unitId;
+        }
+    };
+
+void testServer()
+    {
+    Server server;
+    Transport transport;
+    Devices devices;
+
+    TEST_CHECK(server.begin(0));
+    TEST_CHECK(server.getPort() != 0);
+    for (std::size_t i = 0; i < knUnits; ++i)
+        server.attach(std::uint8_t(i + 1), devices.device[i]);
+
+    // long enough that everything is in flight before the first answer.
+    server.setResponseDelay(50000);
+    transport.setReconnectInterval(20000);
+    TEST_CHECK(transport.begin("127.0.0.1", server.getPort()));
+    TEST_CHECK(pump(&server, transport, [&] { return transport.isConnected(); }, 1000000));
+
+    // a full window of transactions, then one too many.
+    Transaction txn[knUnits];
+
+    for (std::size_t i = 0; i < knUnits; ++i)
+        {
+        setStatusRead(txn[i], std::uint8_t(i + 1));
+        TEST_CHECK(transport.isReady());
+        TEST_CHECK(transport.submit(txn[i]));
+        }
+
+    Transaction extra;
+
+    setStatusRead(extra, 1);
+    TEST_CHECK(transport.getPendingCount() == knUnits);
+    TEST_CHECK(! transport.isReady());
+    TEST_CHECK(! transport.submit(extra));
+
+    TEST_CHECK(pump(&server, transport, [&] { return allDone(txn, knUnits); }, 2000000));
+    TEST_CHECK(server.getMaxQueued() == knUnits);
+    for (auto const &t : txn)
+        TEST_CHECK(Devices::checkRead(t));
+
+    // a unit with no device: the gateway says so, and it's NoReply.
+    Transaction missing;
+
+    setStatusRead(missing, 99);
+    TEST_CHECK(transport.submit(missing));
+    TEST_CHECK(pump(&server, transport, [&] { return missing.isDone(); }, 1000000));
+    TEST_CHECK(missing.status == Transaction::Status::NoReply);
+
+    // the server goes away with a transaction in flight, and comes back
+    // on the same port.
+    std::uint16_t const port = server.getPort();
+    Transaction lost;
+
+    setStatusRead(lost, 3);
+    TEST_CHECK(transport.submit(lost));
+    TEST_CHECK(pump(&server, transport, [&] { return server.getRequestCount() == knUnits + 2; }, 1000000));
+    server.end();
+    TEST_CHECK(pump(nullptr, transport, [&] { return lost.isDone(); }, 1000000));
+    TEST_CHECK(lost.status == Transaction::Status::Error);
+    TEST_CHECK(! transport.isConnected());
+
+    TEST_CHECK(server.begin(port));
+    server.setResponseDelay(0);
+    TEST_CHECK(pump(&server, transport, [&] { return transport.isConnected(); }, 2000000));
+
+    Transaction again;
+
+    setStatusRead(again, 7);
+    TEST_CHECK(transport.submit(again));
+    TEST_CHECK(pump(&server, transport, [&] { return again.isDone(); }, 1000000));
+    TEST_CHECK(Devices::checkRead(again));
+
+    transport.end();
+    server.end();
+    }
+
+/// @brief a gateway that collects a window of requests and answers them
+///     last first.
+class ReversingGateway
+    {
+public:
+    ~ReversingGateway()
+        {
+        if (this->m_fd >= 0)
+            ::close(this->m_fd);
+        if (this->m_listenFd >= 0)
+            ::close(this->m_listenFd);
+        }
+
+    bool begin()
+        {
+        this->m_listenFd = ::socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+
+        sockaddr_in addr;
+        socklen_t len = sizeof(addr);
+
+        std::memset(&addr, 0, sizeof(addr));
+        addr.sin_family = AF_INET;
+        addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        if (this->m_listenFd < 0 ||
+            ::bind(this->m_listenFd, reinterpret_cast<sockaddr *>(&addr), sizeof(addr)) != 0 ||
+            ::listen(this->m_listenFd, 1) != 0 ||
+            ::getsockname(this->m_listenFd, reinterpret_cast<sockaddr *>(&addr), &len) != 0)
+            return false;
+
+        this->m_port = ntohs(addr.sin_port);
+        return true;
+        }
+
+    std::uint16_t getPort() const
+        { return this->m_port; }
+
+    /// @brief collect requests; once nWindow are in, answer them all in
+    ///     reverse order.
+    void poll(Devices &devices, std::size_t nWindow)
+        {
+        if (this->m_fd < 0)
+            {
+            this->m_fd = ::accept4(this->m_listenFd, nullptr, nullptr, SOCK_CLOEXEC);
+            return;
+            }
+
+        auto const n = ::recv(this->m_fd, &this->m_rxBuf[this->m_nRx], sizeof(this->m_rxBuf) - this->m_nRx, MSG_DONTWAIT);
+
+        if (n > 0)
+            this->m_nRx += std::size_t(n);
+
+        // count the complete requests.
+        std::size_t iAdu = 0;
+        std::size_t nAdus = 0;
+        std::size_t iAdus[knUnits];
+        std::size_t nAduBytes[knUnits];
+
+        while (nAdus < knUnits)
+            {
+            auto const nAdu = Mbap::getAduSize(&this->m_rxBuf[iAdu], this->m_nRx - iAdu);
+
+            if (nAdu == 0 || nAdu == SIZE_MAX)
+                break;
+            iAdus[nAdus] = iAdu;
+            nAduBytes[nAdus++] = nAdu;
+            iAdu += nAdu;
+            }
+
+        if (nAdus < nWindow)
+            return;
+
+        for (std::size_t i = nAdus; i-- > 0; )
+            {
+            const std::uint8_t * const pAdu = &this->m_rxBuf[iAdus[i]];
+            std::uint8_t response[Mbap::knMaxAduBytes];
+            auto const unitId = Mbap::getUnitId(pAdu);
+            auto const pDevice = unitId >= 1 && unitId <= knUnits ? &devices.device[unitId - 1] : nullptr;
+            auto const nResponse = Mbap::serveRequest(pAdu, nAduBytes[i], pDevice, response);
+
+            (void) ::send(this->m_fd, response, nResponse, MSG_NOSIGNAL);
+            }
+
+        this->m_nRx = 0;
+        }
+
+private:
+    int             m_listenFd = -1;
+    int             m_fd = -1;
+    std::uint16_t   m_port = 0;
+    std::uint8_t    m_rxBuf[knUnits * Mbap::knMaxAduBytes];
+    std::size_t     m_nRx = 0;
+    };
+
+void testOutOfOrder()
+    {
+    ReversingGateway gateway;
+    Transport transport;
+    Devices devices;
+
+    TEST_CHECK(gateway.begin());
+    TEST_CHECK(transport.begin("127.0.0.1", gateway.getPort()));
+
+    auto const fConnected = pump(
+        nullptr, transport,
+        [&] { gateway.poll(devices, knUnits); return transport.isConnected(); },
+        1000000
+        );
+    TEST_CHECK(fConnected);
+
+    Transaction txn[knUnits];
+
+    for (std::size_t i = 0; i < knUnits; ++i)
+        {
+        setStatusRead(txn[i], std::uint8_t(i + 1));
+        TEST_CHECK(transport.submit(txn[i]));
+        }
+
+    auto const fDone = pump(
+        nullptr, transport,
+        [&] { gateway.poll(devices, knUnits); return allDone(txn, knUnits); },
+        2000000
+        );
+    TEST_CHECK(fDone);
+    for (auto const &t : txn)
+        TEST_CHECK(Devices::checkRead(t));
+    }
+
+} // namespace
+
+int main()
+    {
+    testServer();
+    testOutOfOrder();
+    return Test::report("tcp");
+    }
@@ -0,0 +1,175 @@
+/*
+
+Module:  test_threaded_client.cpp
+
+Function:
+    ModbusSerialThreadedClient's transmit wakeups, with the application
+    and the worker on two threads.
+
+Copyright notice and License:
+    See LICENSE file accompanying this project.
+
+Author:
+    MCCI Corporation   October 2026
+
+*/
+
+#include "MCCI_Modbus_Serial_ThreadedClient.h"
+
+#include <fcntl.h>
+#include <thread>
+
+#include "test_common.h"
+
+using namespace McciCatena;
+
+namespace {
+
+using Client = ModbusSerialThreadedClient<64, 64>;
+
+constexpr std::size_t knBytes = 1000000;
+
+/// @brief how long the application waits for room before calling the
+///     wakeup lost, in milliseconds.
+constexpr int kLostWakeupMs = 1000;
+
+std::uint8_t pattern(std::size_t i)
+    {
+    return std::uint8_t(i ^ (i >> 7));
+    }
+
+/// @brief stand in for the host engine: take small, uneven bites of
+///     the transmit buffer, never waiting for the application.
+void consume(Client &client, bool &fOk)
+    {
+    std::size_t nGot = 0;
+    std::uint32_t x = 1;
+
+    while (nGot < knBytes)
+        {
+        std::uint8_t buf[8];
+
+        x ^= x << 13;
+        x ^= x >> 17;
+        x ^= x << 5;
+
+        auto const n = client.peekTx(buf, 1 + x % sizeof(buf));
+
+        if (n == 0)
+            {
+            std::this_thread::yield();
+            continue;
+            }
+
+        for (std::size_t i = 0; i < n; ++i)
+            fOk = fOk && buf[i] == pattern(nGot + i);
+
+        client.consumeTx(n);
+        nGot += n;
+        }
+    }
+
+/// @brief wait for the worker to announce room; false if it never does.
+bool waitTx(Client &client)
+    {
+    pollfd pfd;
+
+    pfd.fd = client.getTxEventFd();
+    pfd.events = POLLIN;
+    pfd.revents = 0;
+    if (::poll(&pfd, 1, kLostWakeupMs) <= 0)
+        return false;
+
+    std::uint64_t count;
+    (void) ::read(pfd.fd, &count, sizeof(count));
+    return true;
+    }
+
+/// @brief the application fills the buffer with putTx(), and waits on
+///     the tx eventfd whenever it's full.
+void testPutTx()
+    {
+    Client client;
+    bool fOk = true;
+    unsigned nLost = 0;
+    unsigned nWaits = 0;
+    std::thread worker(consume, std::ref(client), std::ref(fOk));
+
+    for (std::size_t nPut = 0; nPut < knBytes; )
+        {
+        std::uint8_t buf[32];
+        std::size_t const n = knBytes - nPut < sizeof(buf) ? knBytes - nPut : sizeof(buf);
+
+        for (std::size_t i = 0; i < n; ++i)
+            buf[i] = pattern(nPut + i);
+
+        auto const nDone = client.putTx(buf, n);
+
+        nPut += nDone;
+        if (nDone < n)
+            {
+            ++nWaits;
+            nLost += ! waitTx(client);
+            }
+        }
+
+    worker.join();
+    std::printf("putTx: %u waits, %u lost wakeups\n", nWaits, nLost);
+    TEST_CHECK(fOk);
+    TEST_CHECK(nLost == 0);
+    }
+
+/// @brief the same through readTx(), from a pipe kept full.
+void testReadTx()
+    {
+    Client client;
+    bool fOk = true;
+    unsigned nLost = 0;
+    unsigned nWaits = 0;
+    int pipeFd[2];
+
+    TEST_CHECK(::pipe2(pipeFd, O_NONBLOCK | O_CLOEXEC) == 0);
+
+    std::thread worker(consume, std::ref(client), std::ref(fOk));
+    std::size_t nWritten = 0;
+
+    for (std::size_t nRead = 0; nRead < knBytes; )
+        {
+        std::uint8_t buf[256];
+        std::size_t const n = knBytes - nWritten < sizeof(buf) ? knBytes - nWritten : sizeof(buf);
+
+        for (std::size_t i = 0; i < n; ++i)
+            buf[i] = pattern(nWritten + i);
+
+        auto const nPiped = ::write(pipeFd[1], buf, n);
+
+        if (nPiped > 0)
+            nWritten += std::size_t(nPiped);
+
+        auto const nDone = client.readTx(pipeFd[0]);
+
+        if (nDone > 0)
+            nRead += std::size_t(nDone);
+        else if (nDone < 0 && errno == ENOBUFS)
+            {
+            ++nWaits;
+            nLost += ! waitTx(client);
+            }
+        }
+
+    worker.join();
+    ::close(pipeFd[0]);
+    ::close(pipeFd[1]);
+    std::printf("readTx: %u waits, %u lost wakeups\n", nWaits, nLost);
+    TEST_CHECK(fOk);
+    TEST_CHECK(nLost == 0);
+    }
+
+} // namespace
+
+int main()
+    {
+    testPutTx();
+    testReadTx();
+    return Test::report("threaded_client");
+    }
@@ -0,0 +1,151 @@
+/*
+
+Module:  test_timing.cpp
+
+Function:
+    ModbusSerialTiming gaps, frame times and timeouts.
+
+Copyright notice and License:
+    See LICENSE file accompanying this project.
+
+Author:
+    MCCI Corporation   October 2026
+
+*/
+
+#include "MCCI_Modbus_Serial_Timing.h"
+
+#include "test_common.h"
+
+using namespace McciCatena;
+
+namespace {
+
+using Timing = ModbusSerialTiming;
+
+// everything is usable at compile time.
+static_assert(Timing(19200).getT35() == 2006, "t3.5 at 19200");
+static_assert(Timing::getFrameMicros(8, 115200) == 763, "frame at 115200");
+
+// at and below 19200 baud, t1.5 and t3.5 are 1.5 and 3.5 character
+// times of 11 bits, rounded up to the next microsecond.
+void testDerivedGaps()
+    {
+    Timing const t9600(9600);
+    Timing const t19200(19200);
+
+    TEST_CHECK(t9600.getT15() == 1719);     // 1718.75
+    TEST_CHECK(t9600.getT35() == 4011);     // 4010.42
+    TEST_CHECK(t19200.getT15() == 860);     // 859.375
+    TEST_CHECK(t19200.getT35() == 2006);    // 2005.21
+
+    // the same holds at any rate up to the switch.
+    for (std::uint32_t baudrate = 300; baudrate <= Timing::kFixedGapBaudrate; baudrate += 300)
+        {
+        Timing const timing(baudrate);
+        std::uint64_t const halfChar = std::uint64_t(Timing::kBitsPerChar) * 1000000u;
+
+        // 2 * baudrate * gap is at least nHalves half-characters, and
+        // less than one microsecond more.
+        TEST_CHECK(2u * baudrate * std::uint64_t(timing.getT15()) >= 3 * halfChar);
+        TEST_CHECK(2u * baudrate * std::uint64_t(timing.getT15() - 1) < 3 * halfChar);
+        TEST_CHECK(2u * baudrate * std::uint64_t(timing.getT35()) >= 7 * halfChar);
+        TEST_CHECK(2u * baudrate * std::uint64_t(timing.getT35() - 1) < 7 * halfChar);
+        }
+    }
+
+// above 19200 baud, the gaps are fixed.
+void testFixedGaps()
+    {
+    static const std::uint32_t kBaudrates[] = { 19201, 38400, 57600, 115200, 921600 };
+
+    for (auto const baudrate : kBaudrates)
+        {
+        Timing const timing(baudrate);
+
+        TEST_CHECK(timing.getT15() == 750);
+        TEST_CHECK(timing.getT35() == 1750);
+        }
+    }
+
+// frame times truncate; byte counts are whole characters.
+void testFrames()
+    {
+    TEST_CHECK(Timing(9600).getFrameMicros(8) == 9166);       // 9166.67
+    TEST_CHECK(Timing(19200).getFrameMicros(8) == 4583);      // 4583.33
+    TEST_CHECK(Timing(115200).getFrameMicros(8) == 763);      // 763.89
+    TEST_CHECK(Timing(115200).getFrameMicros(0) == 0);
+
+    TEST_CHECK(Timing(9600).getBytesInMicros(9167) == 8);
+    TEST_CHECK(Timing(9600).getBytesInMicros(9166) == 7);
+    TEST_CHECK(Timing(115200).getBytesInMicros(1000) == 10);
+
+    // no overflow for the longest times.
+    TEST_CHECK(Timing(300).getFrameMicros(65535) == std::uint32_t(65535ull * 11 * 1000000 / 300));
+    }
+
+// the response timeout covers t3.5 before the device answers, its
+// processing, the response frame and t3.5 after.
+void testResponseTimeout()
+    {
+    Timing const t9600(9600);
+    Timing const t19200(19200);
+    Timing const t115200(115200);
+
+    TEST_CHECK(t9600.getResponseTimeout(25, 100000) == 4011 + 100000 + 28645 + 4011);
+    TEST_CHECK(t19200.getResponseTimeout(25, 100000) == 2006 + 100000 + 14322 + 2006);
+    TEST_CHECK(t115200.getResponseTimeout(25, 100000) == 1750 + 100000 + 2387 + 1750);
+    TEST_CHECK(t115200.getResponseTimeout(0, Timing::kDefaultProbeTurnaroundLimit) == 1750 + 10000 + 1750);
+    }
+
+// a request starts t3.5 after the last frame ended, even across the
+// wrap of the microsecond clock; a transaction costs both frames, both
+// gaps and the turnaround.
+void testRequestSpacing()
+    {
+    Timing const t9600(9600);
+    Timing const t115200(115200);
+
+    TEST_CHECK(t9600.getNextRequestTime(1000) == 5011);
+    TEST_CHECK(t115200.getNextRequestTime(1000) == 2750);
+    TEST_CHECK(t115200.getNextRequestTime(0xFFFFFF00u) == 1750 - 0x100);
+
+    TEST_CHECK(t9600.getTransactionMicros(8, 25) == 9166 + 4011 + 1000 + 28645 + 4011);
+    TEST_CHECK(t115200.getTransactionMicros(8, 25, 0) == 763 + 1750 + 2387 + 1750);
+    TEST_CHECK(t115200.getOverheadMicros() == 1750 + 1000 + 1750);
+    TEST_CHECK(t115200.getOverheadMicros() == t115200.getTransactionMicros(0, 0));
+    }
+
+// with the baud rate unknown, the bus takes no time; only the device's
+// own turnaround is left.
+void testUnknownBaudrate()
+    {
+    Timing timing;
+
+    TEST_CHECK(timing.getBaudrate() == 0);
+    TEST_CHECK(timing.getT15() == 0);
+    TEST_CHECK(timing.getT35() == 0);
+    TEST_CHECK(timing.getFrameMicros(256) == 0);
+    TEST_CHECK(Timing::getFrameMicros(256, 0) == 0);
+    TEST_CHECK(timing.getBytesInMicros(1000000) == 0);
+    TEST_CHECK(timing.getResponseTimeout(25, 100000) == 0);
+    TEST_CHECK(timing.getNextRequestTime(1234) == 1234);
+    TEST_CHECK(timing.getTransactionMicros(8, 25) == Timing::kDefaultTurnaround);
+
+    // and setBaudrate() brings it all back.
+    timing.setBaudrate(9600);
+    TEST_CHECK(timing.getT35() == 4011);
+    }
+
+} // namespace
+
+int main()
+    {
+    testDerivedGaps();
+    testFixedGaps();
+    testFrames();
+    testResponseTimeout();
+    testRequestSpacing();
+    testUnknownBaudrate();
+    return Test::report("timing");
+    }
@@ -0,0 +1,139 @@
+/*
+
+Module:  test_tx_coalescing.cpp
+
+Function:
+    Write transactions saved by ModbusSerialHost::setTxCoalescing(),
+    and the latency it costs.
+
+Copyright notice and License:
+    See LICENSE file accompanying this project.
+
+Author:
+    MCCI Corporation   October 2026
+
+*/
+
+#include "MCCI_Modbus_Serial_BufferedClient.h"
+#include "MCCI_Modbus_Serial_LoopbackTransport.h"
+
+#include <vector>
+
+#include "test_common.h"
+
+using namespace McciCatena;
+
+namespace {
+
+constexpr std::uint32_t kStepMicros = 100;
+constexpr std::uint32_t kCharMicros = 2000;
+constexpr std::uint32_t kRunMicros = 10 * 1000000;
+
+struct Result
+    {
+    bool            fOk = true;
+    std::size_t     nPut = 0;
+    std::size_t     nDelivered = 0;
+    std::uint32_t   nWrites = 0;
+    std::uint32_t   busyMicros = 0;
+    std::uint32_t   maxLatency = 0;
+    };
+
+/// @brief the application writes a character every kCharMicros, and
+///     flushes each one if fFlush.
+Result trickle(bool fReadWrite, std::uint16_t nThreshold, std::uint32_t deadline, bool fFlush)
+    {
+    ModbusSerialLoopbackTransport transport(115200);
+    ModbusSerialDevice device;
+    ModbusSerialHost host(transport, 5);
+    ModbusSerialBufferedClient<512, 512> client;
+    std::vector<std::uint32_t> tPut;
+    Result result;
+
+    device.setReadWriteEnabled(fReadWrite);
+    transport.attach(5, device);
+    host.begin(client, 115200);
+    host.setTxCoalescing(nThreshold, deadline);
+
+    for (std::uint32_t t = 0; t < kRunMicros; t += kStepMicros)
+        {
+        if (t >= 100000 && t % kCharMicros == 0)
+            {
+            std::uint8_t const c = std::uint8_t(tPut.size());
+
+            if (client.putTx(&c, 1, fFlush) == 1)
+                tPut.push_back(t);
+            }
+
+        host.poll();
+
+        int c;
+
+        while ((c = device.getTxQueue().get()) >= 0)
+            {
+            auto const i = result.nDelivered++;
+
+            if (i >= tPut.size() || std::uint8_t(c) != std::uint8_t(i))
+                {
+                result.fOk = false;
+                continue;
+                }
+
+            auto const latency = t - tPut[i];
+
+            if (latency > result.maxLatency)
+                result.maxLatency = latency;
+            }
+
+        transport.advanceMicros(kStepMicros);
+        }
+
+    result.nPut = tPut.size();
+    result.nWrites = host.getStats().nWrites + host.getStats().nReadWrites;
+    result.busyMicros = transport.getBusyMicros();
+    return result;
+    }
+
+void testCoalescing(bool fReadWrite)
+    {
+    constexpr std::uint32_t kDeadline = 20000;
+
+    Result const plain = trickle(fReadWrite, 1, 0, false);
+    Result const held = trickle(fReadWrite, 32, kDeadline, false);
+    Result const flushed = trickle(fReadWrite, 32, kDeadline, true);
+
+    std::printf(
+        "rw=%d: writes %u -> %u, bus %u ms -> %u ms, max latency %u ms -> %u ms\n",
+        fReadWrite,
+        plain.nWrites, held.nWrites,
+        plain.busyMicros / 1000, held.busyMicros / 1000,
+        plain.maxLatency / 1000, held.maxLatency / 1000
+        );
+
+    for (auto const *pResult : { &plain, &held, &flushed })
+        {
+        TEST_CHECK(pResult->fOk);
+
+        // the last few characters may still be on their way.
+        TEST_CHECK(pResult->nDelivered + 32 >= pResult->nPut);
+        }
+
+    TEST_CHECK(held.nWrites * 2 < plain.nWrites);
+    TEST_CHECK(held.busyMicros * 2 < plain.busyMicros);
+
+    // a held character goes out by its deadline, give or take one
+    // poll interval and one transaction.
+    TEST_CHECK(held.maxLatency <= kDeadline + 20000);
+
+    // flushing every character undoes the coalescing.
+    TEST_CHECK(flushed.nWrites * 10 >= plain.nWrites * 9);
+    }
+
+} // namespace
+
+int main()
+    {
+    testCoalescing(false);
+    testCoalescing(true);
+    return Test::report("tx_coalescing");
+    }
@@ -0,0 +1,121 @@
+/*
+
+Module:  test_tx_credit.cpp
+
+Function:
+    Status reads saved by predicting the device's TxAvail between reads
+    (ModbusSerialProtocol::TxCredit).
+
+Copyright notice and License:
+    See LICENSE file accompanying this project.
+
+Author:
+    MCCI Corporation   October 2026
+
+*/
+
+#include "MCCI_Modbus_Serial_BufferedClient.h"
+#include "MCCI_Modbus_Serial_LoopbackTransport.h"
+
+#include "test_common.h"
+
+using namespace McciCatena;
+
+namespace {
+
+constexpr std::uint32_t kStepMicros = 100;
+constexpr std::uint32_t kUartBaudrate = 9600;
+constexpr std::size_t knPushBytes = 20000;
+
+struct Result
+    {
+    bool            fOk = true;
+    std::size_t     nDelivered = 0;
+    std::uint32_t   nReads = 0;
+    std::uint32_t   nWrites = 0;
+    };
+
+/// @brief push knPushBytes through a device whose UART sends them at
+///     kUartBaudrate, so that its queue is full most of the time.
+Result push(bool fPredict, bool fReadWrite, std::uint32_t busBaudrate)
+    {
+    ModbusSerialLoopbackTransport transport(busBaudrate);
+    ModbusSerialDevice device;
+    ModbusSerialHost host(transport, 5);
+    ModbusSerialBufferedClient<512, 512> client;
+    Result result;
+
+    device.setReadWriteEnabled(fReadWrite);
+    transport.attach(5, device);
+    host.begin(client, kUartBaudrate);
+    host.setTxCreditPrediction(fPredict);
+
+    std::size_t nQueued = 0;
+    std::uint32_t uartMicros = 0;
+    std::uint32_t const charMicros = 10 * 1000000 / kUartBaudrate;
+
+    for (std::uint32_t t = 0; t < 60 * 1000000 && result.nDelivered < knPushBytes; t += kStepMicros)
+        {
+        while (nQueued < knPushBytes && client.getTxSpace() != 0)
+            {
+            std::uint8_t const c = std::uint8_t(nQueued * 7);
+
+            client.putTx(&c, 1);
+            ++nQueued;
+            }
+
+        host.poll();
+
+        // the device's UART.
+        for (uartMicros += kStepMicros; uartMicros >= charMicros; uartMicros -= charMicros)
+            {
+            int const c = device.getTxQueue().get();
+
+            if (c < 0)
+                continue;
+            if (std::uint8_t(c) != std::uint8_t(result.nDelivered * 7))
+                result.fOk = false;
+            ++result.nDelivered;
+            }
+
+        transport.advanceMicros(kStepMicros);
+        }
+
+    result.nReads = host.getStats().nReads;
+    result.nWrites = host.getStats().nWrites + host.getStats().nReadWrites;
+    return result;
+    }
+
+/// @brief with 0x10, prediction should cut Status reads by more than a
+///     factor of nFactor.
+void testPush(bool fReadWrite, std::uint32_t busBaudrate, std::uint32_t nFactor)
+    {
+    Result const off = push(false, fReadWrite, busBaudrate);
+    Result const on = push(true, fReadWrite, busBaudrate);
+
+    std::printf(
+        "rw=%d bus=%u: Status reads %u without prediction, %u with\n",
+        fReadWrite, busBaudrate, off.nReads, on.nReads
+        );
+
+    TEST_CHECK(off.fOk && off.nDelivered == knPushBytes);
+    TEST_CHECK(on.fOk && on.nDelivered == knPushBytes);
+
+    // with 0x17, every write reads Status anyway; prediction mustn't
+    // make things worse. On a slow bus, writes are fewer and bigger, so
+    // there are fewer reads to save.
+    if (fReadWrite)
+        TEST_CHECK(on.nReads <= off.nReads);
+    else
+        TEST_CHECK(on.nReads * nFactor < off.nReads);
+    }
+
+} // namespace
+
+int main()
+    {
+    testPush(false, 115200, 4);
+    testPush(false, 19200, 1);
+    testPush(true, 115200, 1);
+    return Test::report("tx_credit");
+    }
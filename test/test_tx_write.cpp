@@ -0,0 +1,181 @@
+/*
+
+Module:  test_tx_write.cpp
+
+Function:
+    The direct TxData write encoders, against encodeRequest() of the
+    same data packed into a transaction.
+
+Copyright notice and License:
+    See LICENSE file accompanying this project.
+
+Author:
+    MCCI Corporation   October 2026
+
+*/
+
+#include "MCCI_Modbus_Serial_Device.h"
+#include "MCCI_Modbus_Serial_Mbap.h"
+#include "MCCI_Modbus_Serial_Pdu.h"
+#include "MCCI_Modbus_Serial_RingBuffer.h"
+#include "MCCI_Modbus_Serial_Rtu.h"
+
+#include <cstring>
+
+#include "test_common.h"
+
+using namespace McciCatena;
+
+namespace {
+
+using Protocol = ModbusSerialProtocol;
+using StatusBits = Protocol::StatusBits;
+using Transaction = ModbusSerialTransaction;
+using Pdu = ModbusSerialPdu;
+
+/// @brief most data offered: more than TxAvail can ever take.
+constexpr std::size_t knMaxData = 140;
+/// @brief ring capacity: just the data, so that starting it part way
+///     in makes it wrap.
+constexpr std::size_t knRingBytes = knMaxData;
+/// @brief the most TxAvail can report: all of TxData and TxDataByte.
+constexpr unsigned knMaxTxAvail = 2 * Protocol::knTxDataReg + 1;
+
+constexpr std::uint8_t kUnitId = 7;
+constexpr std::uint16_t kTransactionId = 0x1234;
+
+std::uint32_t g_random = 1;
+
+std::uint8_t getRandom()
+    {
+    g_random ^= g_random << 13;
+    g_random ^= g_random >> 17;
+    g_random ^= g_random << 5;
+    return std::uint8_t(g_random);
+    }
+
+struct Counts
+    {
+    unsigned        nChecked = 0;
+    unsigned        nWrapped = 0;
+    unsigned        nPdu = 0;       ///< PDU differs from encodeRequest().
+    unsigned        nRtu = 0;       ///< device didn't take exactly nSent.
+    unsigned        nMbap = 0;      ///< ADU isn't header + the PDU.
+    unsigned        nSize = 0;      ///< nSent or the size is wrong.
+    };
+
+/// @brief one case: n bytes in a ring, starting at iStart, with the
+///     device reporting txAvail.
+void check(Counts &counts, unsigned txAvail, std::size_t n, std::size_t iStart)
+    {
+    ModbusSerialRingBuffer<knRingBytes> ring;
+    std::uint8_t data[knMaxData];
+    std::uint8_t junk[knRingBytes] = {};
+
+    ring.put(junk, iStart);
+    ring.discard(iStart);
+    for (std::size_t i = 0; i < n; ++i)
+        data[i] = getRandom();
+    ring.put(data, n);
+
+    std::size_t nData, nWrap;
+    auto const pData = ring.peekRun(nData);
+    auto const pWrap = ring.peekRun(nWrap, nData);
+
+    counts.nWrapped += nWrap != 0;
+    counts.nSize += nData + nWrap != n;
+
+    StatusBits status;
+
+    status.setTxAvail(std::uint8_t(txAvail));
+
+    // the PDU, against the long way round.
+    std::uint8_t pdu[Pdu::knMaxTxWritePduBytes];
+    std::size_t nSent;
+    auto const nPdu = Pdu::encodeTxWrite(pdu, nSent, status, pData, nData, pWrap, nWrap);
+
+    Protocol::Register reg;
+    std::uint16_t nRegs;
+    auto const nExpected = status.getTxRegisterAndCount(reg, nRegs, n);
+
+    counts.nSize += nSent != nExpected;
+    if (nExpected == 0)
+        {
+        counts.nSize += nPdu != 0;
+        return;
+        }
+
+    Transaction txn;
+    std::uint8_t expected[Pdu::knMaxPduBytes];
+
+    txn.setWrite(reg, nRegs);
+    Protocol::RegisterImage::pack(txn.writeRegs, data, nExpected);
+
+    auto const nExpectedPdu = Pdu::encodeRequest(expected, txn);
+
+    counts.nPdu += nPdu != nExpectedPdu || std::memcmp(pdu, expected, nPdu) != 0;
+    counts.nSize += nPdu > Pdu::knMaxTxWritePduBytes;
+
+    // an MBAP ADU is its header and the same PDU.
+    std::uint8_t adu[ModbusSerialMbap::knMaxAduBytes];
+    auto const nAdu = ModbusSerialMbap::encodeTxWrite(adu, nSent, kTransactionId, kUnitId, status, pData, nData, pWrap, nWrap);
+
+    counts.nMbap += nAdu != 7 + nPdu || std::memcmp(&adu[7], pdu, nPdu) != 0;
+    counts.nMbap += ModbusSerialMbap::getUnitId(adu) != kUnitId;
+
+    // an RTU frame, served by a device: it takes exactly what was sent.
+    // Our device's queue can't report more than it holds.
+    if (txAvail > ModbusSerialDevice::kQueueSize)
+        {
+        ++counts.nChecked;
+        return;
+        }
+
+    ModbusSerialDevice device;
+    std::uint8_t frame[ModbusSerialRtu::knMaxFrameBytes];
+    std::uint8_t response[ModbusSerialRtu::knMaxFrameBytes];
+    auto const nFrame = ModbusSerialRtu::encodeTxWrite(frame, nSent, kUnitId, status, pData, nData, pWrap, nWrap);
+    auto const nResponse = ModbusSerialRtu::serveRequest(frame, nFrame, device, response);
+
+    std::uint8_t out[knMaxData];
+    std::size_t nOut = 0;
+
+    for (int c; (c = device.getTxQueue().get()) >= 0 && nOut < sizeof(out); )
+        out[nOut++] = std::uint8_t(c);
+
+    // a Write Multiple Registers response is unit, function, address,
+    // count, CRC.
+    counts.nRtu += nResponse != 8 || nOut != nSent || std::memcmp(out, data, nOut) != 0;
+
+    ++counts.nChecked;
+    }
+
+void testTxWrite()
+    {
+    Counts counts;
+
+    for (unsigned txAvail = 0; txAvail <= knMaxTxAvail; ++txAvail)
+        {
+        for (std::size_t n = 0; n <= knMaxData; n += n < 10 ? 1 : 7)
+            {
+            for (std::size_t iStart = 0; iStart < knRingBytes; iStart += 5)
+                check(counts, txAvail, n, iStart);
+            }
+        }
+
+    std::printf("tx_write: %u cases, %u wrapped\n", counts.nChecked, counts.nWrapped);
+    TEST_CHECK(counts.nChecked != 0);
+    TEST_CHECK(counts.nWrapped != 0);
+    TEST_CHECK(counts.nSize == 0);
+    TEST_CHECK(counts.nPdu == 0);
+    TEST_CHECK(counts.nRtu == 0);
+    TEST_CHECK(counts.nMbap == 0);
+    }
+
+} // namespace
+
+int main()
+    {
+    testTxWrite();
+    return Test::report("tx_write");
+    }
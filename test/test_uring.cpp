@@ -0,0 +1,100 @@
+/*
+
+Module:  test_uring.cpp
+
+Function:
+    ModbusSerialUringLoop: ports added and removed with reads in flight.
+
+Copyright notice and License:
+    See LICENSE file accompanying this project.
+
+Author:
+    MCCI Corporation   October 2026
+
+*/
+
+#include "MCCI_Modbus_Serial_UringLoop.h"
+
+#include <cstdlib>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "test_common.h"
+
+using namespace McciCatena;
+
+namespace {
+
+/// @brief ctest's code for a test that couldn't run here.
+constexpr int kSkipped = 77;
+
+using Port = ModbusSerialUringTransport;
+
+/// @brief open the master side of a pty, and the port on its slave side.
+int openPort(Port &port)
+    {
+    int const fd = ::posix_openpt(O_RDWR | O_NOCTTY | O_NONBLOCK);
+
+    if (fd < 0 || ::grantpt(fd) != 0 || ::unlockpt(fd) != 0 || ! port.begin(::ptsname(fd), 115200))
+        {
+        if (fd >= 0)
+            ::close(fd);
+        return -1;
+        }
+    return fd;
+    }
+
+// each removal cancels the port's outstanding read. The cancel has to
+// complete, or the slot stays reserved and the loop runs out of them.
+void testAddRemove(ModbusSerialUringLoop &loop)
+    {
+    constexpr unsigned knPorts = 2;
+    Port port[knPorts];
+    int fd[knPorts];
+    ModbusSerialHost host0(port[0], 1);
+    ModbusSerialHost host1(port[1], 1);
+    ModbusSerialHost *pHost[knPorts] = { &host0, &host1 };
+
+    for (unsigned i = 0; i < knPorts; ++i)
+        TEST_CHECK((fd[i] = openPort(port[i])) >= 0);
+
+    unsigned nFailed = 0;
+
+    for (unsigned iCycle = 0; iCycle < ModbusSerialUringLoop::knMaxPorts * 4; ++iCycle)
+        {
+        for (unsigned i = 0; i < knPorts; ++i)
+            nFailed += ! loop.add(port[i], *pHost[i]);
+
+        // let the reads go into the ring.
+        for (unsigned i = 0; i < 3; ++i)
+            loop.run(1000);
+
+        for (unsigned i = 0; i < knPorts; ++i)
+            nFailed += ! loop.remove(port[i]);
+        }
+
+    TEST_CHECK(nFailed == 0);
+
+    for (unsigned i = 0; i < knPorts; ++i)
+        {
+        port[i].end();
+        ::close(fd[i]);
+        }
+    }
+
+} // namespace
+
+int main()
+    {
+    ModbusSerialUringLoop loop;
+
+    if (! loop.begin())
+        {
+        std::printf("uring: skipped, no io_uring\n");
+        return kSkipped;
+        }
+
+    testAddRemove(loop);
+    loop.end();
+    return Test::report("uring");
+    }